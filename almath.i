@@ -9,6 +9,7 @@
 %feature("autodoc", "1");
 
 %{
+#include "almath/types/aladjoint.h"
 #include "almath/types/alaxismask.h"
 
 #include "almath/types/alpose2d.h"
@@ -53,6 +54,7 @@
 %include "almath/types/alvelocity6d.h"
 
 %include "almath/types/altransformandvelocity6d.h"
+%include "almath/types/aladjoint.h"
 
 %include "almath/tools/aldubinscurve.h"
 %include "almath/tools/altrigonometry.h"
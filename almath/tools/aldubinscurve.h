@@ -15,6 +15,76 @@
 namespace AL {
   namespace Math {
 
+    /// <summary>
+    /// The three checkpoints of a dubins solution: the start and the end of
+    /// the straight segment, then the target pose.
+    /// </summary>
+    /// \ingroup Tools
+    typedef Pose2D DubinsSolutions[3];
+
+    /// <summary> Status of the dubins solver. </summary>
+    /// \ingroup Tools
+    enum DubinsStatus
+    {
+      DUBINS_SUCCESS = 0,
+      /// the target pose is closer than 4*pCircleRadius
+      DUBINS_TARGET_TOO_CLOSE = 1,
+      /// the requested path family has no solution for this target
+      DUBINS_NO_PATH = 2,
+      /// the circle radius is not strictly positive
+      DUBINS_INVALID_RADIUS = 3
+    };
+
+    /// <summary>
+    /// The six families of dubins path: L is a left turn, R a right turn
+    /// and S a straight line.
+    /// </summary>
+    /// \ingroup Tools
+    enum DubinsPathType
+    {
+      DUBINS_LSL = 0,
+      DUBINS_LSR = 1,
+      DUBINS_RSL = 2,
+      DUBINS_RSR = 3,
+      DUBINS_RLR = 4,
+      DUBINS_LRL = 5
+    };
+
+    /// <summary>
+    /// A dubins path: three segments (arc, straight line or arc, arc)
+    /// joining a start pose to a target pose with a minimum turning radius.
+    ///
+    /// Computing a path only solves for the segment lengths, the poses
+    /// along the path are computed on demand with sample or
+    /// sampleDubinsPath.
+    /// </summary>
+    /// \ingroup Tools
+    struct DubinsPath
+    {
+      /// the start pose
+      Pose2D start;
+      /// the turning radius
+      float radius;
+      /// the path family
+      DubinsPathType type;
+      /// the length of the three segments
+      float lengths[3];
+
+      /// <summary> Create a null path at origin. </summary>
+      DubinsPath();
+
+      /// <summary> Return the total length of the path. </summary>
+      float length() const;
+
+      /// <summary>
+      /// Return the pose at the given arc length from the start.
+      /// pArcLength is clamped to [0, length()].
+      /// </summary>
+      /// <param name="pArcLength"> the arc length from the start </param>
+      /// <returns> the pose on the path, theta in [-pi, pi[ </returns>
+      Pose2D sample(const float pArcLength) const;
+    };
+
     /// <summary> Get the dubins solutions. </summary>
     /// <param name="pTargetPose">   the target pose </param>
     /// <param name="pCircleRadius"> the circle radius </param>
@@ -24,6 +94,100 @@ namespace AL {
       const Pose2D& pTargetPose,
       const float   pCircleRadius);
 
+    /// <summary>
+    /// Get the dubins solutions without heap allocation nor exception.
+    /// </summary>
+    /// <param name="pTargetPose">   the target pose </param>
+    /// <param name="pCircleRadius"> the circle radius </param>
+    /// <param name="pSolutions">
+    /// the dubins solution, unchanged if the status is not DUBINS_SUCCESS
+    /// </param>
+    /// <returns> DUBINS_SUCCESS or the reason of the failure. </returns>
+    /// \ingroup Tools
+    DubinsStatus getDubinsSolutions(
+      const Pose2D&    pTargetPose,
+      const float      pCircleRadius,
+      DubinsSolutions& pSolutions);
+
+    /// <summary>
+    /// Get the dubins solutions of several target poses, without heap
+    /// allocation nor exception.
+    /// </summary>
+    /// <param name="pTargetPoses">  the pSize target poses </param>
+    /// <param name="pSize">         the number of target poses </param>
+    /// <param name="pCircleRadius"> the circle radius </param>
+    /// <param name="pSolutions">    the pSize dubins solutions </param>
+    /// <param name="pStatus">       the pSize status </param>
+    /// <returns> The number of DUBINS_SUCCESS. </returns>
+    /// \ingroup Tools
+    unsigned int getDubinsSolutionsBatch(
+      const Pose2D*      pTargetPoses,
+      const unsigned int pSize,
+      const float        pCircleRadius,
+      DubinsSolutions*   pSolutions,
+      DubinsStatus*      pStatus);
+
+    /// <summary>
+    /// Compute the shortest dubins path, among the six families, from
+    /// pStart to pTarget. Unlike getDubinsSolutions, the target can be
+    /// at any distance and the paths are ranked by their total length.
+    /// </summary>
+    /// <param name="pStart">        the start pose </param>
+    /// <param name="pTarget">       the target pose </param>
+    /// <param name="pCircleRadius"> the turning radius </param>
+    /// <param name="pPath">
+    /// the shortest path, unchanged if the status is not DUBINS_SUCCESS
+    /// </param>
+    /// <returns> DUBINS_SUCCESS or DUBINS_INVALID_RADIUS. </returns>
+    /// \ingroup Tools
+    DubinsStatus computeDubinsPath(
+      const Pose2D& pStart,
+      const Pose2D& pTarget,
+      const float   pCircleRadius,
+      DubinsPath&   pPath);
+
+    /// <summary>
+    /// Compute the dubins path of the given family from pStart to pTarget.
+    /// </summary>
+    /// <param name="pStart">        the start pose </param>
+    /// <param name="pTarget">       the target pose </param>
+    /// <param name="pCircleRadius"> the turning radius </param>
+    /// <param name="pType">         the path family </param>
+    /// <param name="pPath">
+    /// the path, unchanged if the status is not DUBINS_SUCCESS
+    /// </param>
+    /// <returns>
+    /// DUBINS_SUCCESS, DUBINS_NO_PATH or DUBINS_INVALID_RADIUS.
+    /// </returns>
+    /// \ingroup Tools
+    DubinsStatus computeDubinsPath(
+      const Pose2D&        pStart,
+      const Pose2D&        pTarget,
+      const float          pCircleRadius,
+      const DubinsPathType pType,
+      DubinsPath&          pPath);
+
+    /// <summary>
+    /// Sample a dubins path at a fixed arc length step, into a caller
+    /// buffer. The poses at pFrom, pFrom + pStep, ... are written until the
+    /// end of the path or until pMaxSize poses are written. A long path
+    /// can be streamed with a small buffer by calling again with
+    /// pFrom + returned*pStep.
+    /// </summary>
+    /// <param name="pPath">    the path to sample </param>
+    /// <param name="pStep">    the arc length step, strictly positive </param>
+    /// <param name="pFrom">    the arc length of the first pose </param>
+    /// <param name="pPoses">   the buffer of pMaxSize poses </param>
+    /// <param name="pMaxSize"> the size of the buffer </param>
+    /// <returns> The number of poses written. </returns>
+    /// \ingroup Tools
+    unsigned int sampleDubinsPath(
+      const DubinsPath&  pPath,
+      const float        pStep,
+      const float        pFrom,
+      Pose2D*            pPoses,
+      const unsigned int pMaxSize);
+
   }
 }
 #endif  // _LIBALMATH_ALMATH_TOOLS_ALDUBINSCURVE_H_
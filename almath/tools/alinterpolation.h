@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TOOLS_ALINTERPOLATION_H_
+#define _LIBALMATH_ALMATH_TOOLS_ALINTERPOLATION_H_
+
+#include <almath/types/alpositionandvelocity.h>
+#include <cstddef>
+#include <vector>
+
+namespace AL
+{
+  namespace Math
+  {
+    /// <summary>
+    /// The polynomial of each segment of a JointTrajectory.
+    ///
+    /// INTERPOLATION_CUBIC: cubic Hermite polynomial, continuous in
+    /// position and velocity.
+    ///
+    /// INTERPOLATION_QUINTIC: quintic polynomial, continuous in position,
+    /// velocity and acceleration, with a zero acceleration at the
+    /// waypoints.
+    ///
+    /// INTERPOLATION_MINIMUM_JERK: the minimum jerk quintic polynomial,
+    /// which stops at each waypoint: the waypoint velocities are ignored.
+    /// </summary>
+    /// \ingroup Tools
+    enum InterpolationType
+    {
+      INTERPOLATION_CUBIC = 0,
+      INTERPOLATION_QUINTIC,
+      INTERPOLATION_MINIMUM_JERK
+    };
+
+    /// <summary>
+    /// A joint space trajectory through timed waypoints.
+    ///
+    /// The polynomial coefficients of a segment are computed once, when
+    /// its final waypoint is added: a sample is then a polynomial
+    /// evaluation, whatever the number of waypoints. The coefficients are
+    /// stored coefficient by coefficient for all the joints, so that
+    /// several joints are evaluated at once with SIMD instructions when
+    /// available.
+    ///
+    /// Waypoints can be added while the trajectory is played by a
+    /// JointTrajectoryCursor. Before its first waypoint and after its
+    /// last one, the trajectory holds the position of the waypoint with
+    /// a zero velocity.
+    /// </summary>
+    /// \ingroup Tools
+    class JointTrajectory
+    {
+    public:
+      /// <summary>
+      /// Create a JointTrajectory without waypoint.
+      /// </summary>
+      /// <param name="pNbJoints"> the number of joints </param>
+      /// <param name="pType"> the polynomial of the segments </param>
+      JointTrajectory(
+          const unsigned int      pNbJoints,
+          const InterpolationType pType = INTERPOLATION_QUINTIC);
+
+      /// <summary>
+      /// Add a waypoint at the end of the trajectory.
+      /// </summary>
+      /// <param name="pTime"> the time of the waypoint, greater than the
+      /// time of the last waypoint </param>
+      /// <param name="pPositions"> the getNbJoints() positions </param>
+      /// <param name="pVelocities"> the getNbJoints() velocities, or
+      /// NULL to stop at the waypoint </param>
+      void addWaypoint(
+          const float  pTime,
+          const float* pPositions,
+          const float* pVelocities = NULL);
+
+      /// <summary>
+      /// Remove all the waypoints.
+      /// </summary>
+      void clear();
+
+      /// <summary>
+      /// Allocate the memory of a number of waypoints, so that adding
+      /// them does not allocate.
+      /// </summary>
+      /// <param name="pNbWaypoints"> the number of waypoints </param>
+      void reserve(const unsigned int pNbWaypoints);
+
+      /// <summary>
+      /// Return the number of joints.
+      /// </summary>
+      unsigned int getNbJoints() const;
+
+      /// <summary>
+      /// Return the number of waypoints.
+      /// </summary>
+      unsigned int getNbWaypoints() const;
+
+      /// <summary>
+      /// Return the polynomial of the segments.
+      /// </summary>
+      InterpolationType getInterpolationType() const;
+
+      /// <summary>
+      /// Return the time of the first waypoint.
+      /// </summary>
+      float getStartTime() const;
+
+      /// <summary>
+      /// Return the time of the last waypoint.
+      /// </summary>
+      float getFinalTime() const;
+
+      /// <summary>
+      /// Compute the position and the velocity of every joint at a time.
+      /// The segment is found by a binary search: use a
+      /// JointTrajectoryCursor to sample the trajectory in time order.
+      /// </summary>
+      /// <param name="pTime"> the time </param>
+      /// <param name="pOut"> the getNbJoints() PositionAndVelocity </param>
+      void evaluate(
+          const float          pTime,
+          PositionAndVelocity* pOut) const;
+
+    private:
+      friend class JointTrajectoryCursor;
+
+      unsigned int xSearchSegment(const float pTime) const;
+      unsigned int xFindSegment(
+          const float        pTime,
+          const unsigned int pHint) const;
+      void xEvaluate(
+          const unsigned int   pSegment,
+          const float          pTime,
+          PositionAndVelocity* pOut) const;
+
+      unsigned int       fNbJoints;
+      InterpolationType  fType;
+      unsigned int       fNbCoefficients;
+      std::vector<float> fTimes;
+      // per segment, fNbCoefficients arrays of fNbJoints float, from the
+      // constant coefficient to the highest degree one, of the polynomial
+      // of the normalized time in [0, 1]
+      std::vector<float> fCoefficients;
+      std::vector<float> fLastPositions;
+      std::vector<float> fLastVelocities;
+    };
+
+    /// <summary>
+    /// Play a JointTrajectory at a fixed period.
+    ///
+    /// The cursor remembers the segment of its last sample, so that
+    /// sampling the trajectory in time order costs O(1) per tick, and
+    /// does not allocate. The time of tick n is computed as
+    /// start + n*period, without accumulating rounding errors.
+    /// </summary>
+    /// \ingroup Tools
+    class JointTrajectoryCursor
+    {
+    public:
+      /// <summary>
+      /// Create a JointTrajectoryCursor at the time of the first
+      /// waypoint, 0.0 if there is none yet. The trajectory must
+      /// outlive the cursor.
+      /// </summary>
+      /// <param name="pTrajectory"> the trajectory to play </param>
+      /// <param name="pPeriod"> the time between two ticks </param>
+      JointTrajectoryCursor(
+          const JointTrajectory& pTrajectory,
+          const float            pPeriod);
+
+      /// <summary>
+      /// Move the cursor to a time, which becomes the time of the next
+      /// tick.
+      /// </summary>
+      /// <param name="pTime"> the time </param>
+      void seek(const float pTime);
+
+      /// <summary>
+      /// Compute the position and the velocity of every joint at the
+      /// current time, then move the cursor to the next tick.
+      /// </summary>
+      /// <param name="pOut"> the getNbJoints() PositionAndVelocity </param>
+      void next(PositionAndVelocity* pOut);
+
+      /// <summary>
+      /// Return the time of the next tick.
+      /// </summary>
+      float getTime() const;
+
+      /// <summary>
+      /// Return true if the time of the next tick is after the last
+      /// waypoint.
+      /// </summary>
+      bool isFinished() const;
+
+    private:
+      const JointTrajectory* fTrajectory;
+      float                  fPeriod;
+      float                  fOrigin;
+      unsigned int           fTick;
+      unsigned int           fSegment;
+    };
+
+  } // namespace Math
+} // namespace AL
+
+#endif  // _LIBALMATH_ALMATH_TOOLS_ALINTERPOLATION_H_
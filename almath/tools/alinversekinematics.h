@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TOOLS_ALINVERSEKINEMATICS_H_
+#define _LIBALMATH_ALMATH_TOOLS_ALINVERSEKINEMATICS_H_
+
+#include <almath/tools/alkinematictree.h>
+#include <almath/types/alaxismask.h>
+#include <almath/types/altransform.h>
+#include <vector>
+
+namespace AL
+{
+  namespace Math
+  {
+    /// <summary>
+    /// Damped least squares inverse kinematics of a link of a
+    /// KinematicTree.
+    ///
+    /// At each iteration, the error is computed from H^-1*target, in the
+    /// frame of the effector H: its translation for the linear part and
+    /// the rotation part of its transformLogarithm for the angular part.
+    /// The joints move by:
+    ///
+    /// dq = J^t (J J^t + damping^2 I)^-1 e
+    ///
+    /// where J is the geometric Jacobian in the effector frame. Only the
+    /// axes of the AXIS_MASK are used, each one scaled by its weight. The
+    /// joint values are clipped to their limits with clipData.
+    ///
+    /// The solver works on the joint values of the tree, so that each
+    /// solve() starts from the previous solution. All its buffers are
+    /// allocated at construction: solve() does not allocate, and its
+    /// latency is bounded by the maximal number of iterations and the
+    /// optional time budget.
+    /// </summary>
+    /// \ingroup Tools
+    class InverseKinematicsSolver
+    {
+    public:
+      /// <summary>
+      /// Create an InverseKinematicsSolver. The tree must not change
+      /// its links, and must outlive the solver.
+      /// </summary>
+      /// <param name="pTree"> the KinematicTree whose joints move </param>
+      /// <param name="pLink"> the index of the effector link </param>
+      /// <param name="pTip"> the effector, in the frame of the link </param>
+      InverseKinematicsSolver(
+          KinematicTree&     pTree,
+          const unsigned int pLink,
+          const Transform&   pTip = Transform());
+
+      /// <summary>
+      /// Change the axes of the error which are controlled.
+      /// Default: AXIS_MASK_ALL.
+      /// </summary>
+      /// <param name="pAxisMask"> the axes, in the effector frame </param>
+      void setAxisMask(const AXIS_MASK& pAxisMask);
+
+      /// <summary>
+      /// Change the weight of each axis of the error, in the order x, y,
+      /// z, wx, wy, wz. Default: 1.0.
+      /// </summary>
+      /// <param name="pWeights"> the 6 weights </param>
+      void setAxisWeights(const std::vector<float>& pWeights);
+
+      /// <summary>
+      /// Change the limits of a joint. Default: no limit.
+      /// </summary>
+      /// <param name="pJoint"> the index of the joint </param>
+      /// <param name="pMin"> the min limit </param>
+      /// <param name="pMax"> the max limit </param>
+      void setJointLimits(
+          const unsigned int pJoint,
+          const float        pMin,
+          const float        pMax);
+
+      /// <summary>
+      /// Change the damping, which bounds the joint moves near the
+      /// singularities. Default: 0.01.
+      /// </summary>
+      /// <param name="pDamping"> the damping </param>
+      void setDamping(const float pDamping);
+
+      /// <summary>
+      /// Change the norm of the weighted error under which solve()
+      /// stops. Default: 0.0001.
+      /// </summary>
+      /// <param name="pTolerance"> the tolerance </param>
+      void setTolerance(const float pTolerance);
+
+      /// <summary>
+      /// Change the maximal number of iterations of solve(). Default: 20.
+      /// </summary>
+      /// <param name="pMaxIterations"> the number of iterations </param>
+      void setMaxIterations(const unsigned int pMaxIterations);
+
+      /// <summary>
+      /// Change the time budget of solve(), checked after each iteration
+      /// with a monotonic wall clock. Default: 0, no budget.
+      /// </summary>
+      /// <param name="pMaxTime"> the budget in seconds </param>
+      void setMaxTime(const float pMaxTime);
+
+      /// <summary>
+      /// Move the joints of the tree so that the effector reaches the
+      /// target, starting from the current joint values.
+      /// Throw a std::invalid_argument if the number of joints of the
+      /// tree changed since the construction of the solver.
+      /// </summary>
+      /// <param name="pTarget"> the target Transform of the effector, in
+      /// the base frame of the tree </param>
+      /// <returns>
+      /// true if the weighted error is less than the tolerance
+      /// </returns>
+      bool solve(const Transform& pTarget);
+
+      /// <summary>
+      /// Return the number of iterations of the last solve().
+      /// </summary>
+      unsigned int getNbIterations() const;
+
+      /// <summary>
+      /// Return the norm of the weighted error at the end of the last
+      /// solve().
+      /// </summary>
+      float getError() const;
+
+    private:
+      float xComputeError(const Transform& pTarget);
+      void xComputeStep();
+
+      KinematicTree*     fTree;
+      unsigned int       fLink;
+      Transform          fTip;
+      AXIS_MASK          fAxisMask;
+      float              fWeights[6];
+      float              fDamping;
+      float              fTolerance;
+      unsigned int       fMaxIterations;
+      float              fMaxTime;
+
+      std::vector<float> fMinLimits;
+      std::vector<float> fMaxLimits;
+
+      // workspace
+      Transform          fEffector;
+      float              fError[6];
+      std::vector<float> fJacobian;
+      std::vector<float> fJointValues;
+
+      unsigned int       fNbIterations;
+      float              fErrorNorm;
+    };
+
+  } // namespace Math
+} // namespace AL
+
+#endif  // _LIBALMATH_ALMATH_TOOLS_ALINVERSEKINEMATICS_H_
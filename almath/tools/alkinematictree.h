@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TOOLS_ALKINEMATICTREE_H_
+#define _LIBALMATH_ALMATH_TOOLS_ALKINEMATICTREE_H_
+
+#include <almath/types/altransform.h>
+#include <almath/types/alposition3d.h>
+#include <almath/types/alaxismask.h>
+#include <vector>
+
+namespace AL
+{
+  namespace Math
+  {
+    /// <summary>
+    /// The joint which moves a link of a KinematicTree relatively to its
+    /// offset: a rotation around, or a translation along, one axis of the
+    /// link frame.
+    /// </summary>
+    /// \ingroup Tools
+    enum JointType
+    {
+      JOINT_FIXED = 0,
+      JOINT_REVOLUTE_X,
+      JOINT_REVOLUTE_Y,
+      JOINT_REVOLUTE_Z,
+      JOINT_PRISMATIC_X,
+      JOINT_PRISMATIC_Y,
+      JOINT_PRISMATIC_Z
+    };
+
+    /// <summary>
+    /// Forward kinematics of a tree of links.
+    ///
+    /// Each link has a parent link (or none for a root link), a fixed
+    /// offset from its parent and a joint. The Transform of a link, from
+    /// the base frame of the tree, is:
+    ///
+    /// H(link) = H(parent)*offset*joint(value)
+    ///
+    /// The links are stored in flat arrays in the order of their creation,
+    /// which is a topological order since a parent must exist before its
+    /// children. When a joint value changes, the link is marked dirty and
+    /// update() recomputes only the dirty links and their descendants, in
+    /// one pass over the arrays and without heap allocation.
+    ///
+    /// Only the movable links have a joint value; the joints are numbered
+    /// in the order of creation of their links, from 0 to getNbJoints().
+    /// </summary>
+    /// \ingroup Tools
+    class KinematicTree
+    {
+    public:
+      /// <summary>
+      /// Create an empty KinematicTree.
+      /// </summary>
+      KinematicTree();
+
+      /// <summary>
+      /// Add a link at the end of the tree. The joint value of a movable
+      /// link is initialized to zero.
+      /// </summary>
+      /// <param name="pParent"> the index of the parent link, or -1 for
+      /// a root link </param>
+      /// <param name="pOffset"> the Transform from the parent link to the
+      /// link, when the joint value is zero </param>
+      /// <param name="pJointType"> the joint of the link </param>
+      /// <returns>
+      /// the index of the new link
+      /// </returns>
+      unsigned int addLink(
+          const int        pParent,
+          const Transform& pOffset,
+          const JointType  pJointType = JOINT_FIXED);
+
+      /// <summary>
+      /// Add a link whose parent is the last added link, to build a
+      /// KinematicChain.
+      /// </summary>
+      /// <param name="pOffset"> the Transform from the parent link to the
+      /// link, when the joint value is zero </param>
+      /// <param name="pJointType"> the joint of the link </param>
+      /// <returns>
+      /// the index of the new link
+      /// </returns>
+      unsigned int addLink(
+          const Transform& pOffset,
+          const JointType  pJointType = JOINT_FIXED);
+
+      /// <summary>
+      /// Return the number of links.
+      /// </summary>
+      unsigned int getNbLinks() const;
+
+      /// <summary>
+      /// Return the number of joints, the number of movable links.
+      /// </summary>
+      unsigned int getNbJoints() const;
+
+      /// <summary>
+      /// Return the index of the parent of a link, -1 for a root link.
+      /// </summary>
+      /// <param name="pLink"> the index of the link </param>
+      int getParent(const unsigned int pLink) const;
+
+      /// <summary>
+      /// Return the joint type of a link.
+      /// </summary>
+      /// <param name="pLink"> the index of the link </param>
+      JointType getJointType(const unsigned int pLink) const;
+
+      /// <summary>
+      /// Return the index of the joint of a link, -1 for a fixed link.
+      /// </summary>
+      /// <param name="pLink"> the index of the link </param>
+      int getJointIndex(const unsigned int pLink) const;
+
+      /// <summary>
+      /// Return the index of the link moved by a joint.
+      /// </summary>
+      /// <param name="pJoint"> the index of the joint </param>
+      unsigned int getJointLink(const unsigned int pJoint) const;
+
+      /// <summary>
+      /// Change the value of a joint: an angle for a revolute joint and a
+      /// distance for a prismatic joint. The link is marked dirty only if
+      /// the value changes.
+      /// </summary>
+      /// <param name="pJoint"> the index of the joint </param>
+      /// <param name="pValue"> the new value </param>
+      void setJointValue(
+          const unsigned int pJoint,
+          const float        pValue);
+
+      /// <summary>
+      /// Change the values of all the joints.
+      /// </summary>
+      /// <param name="pValues"> the getNbJoints() new values </param>
+      void setJointValues(const float* pValues);
+
+      /// <summary>
+      /// Return the value of a joint.
+      /// </summary>
+      /// <param name="pJoint"> the index of the joint </param>
+      float getJointValue(const unsigned int pJoint) const;
+
+      /// <summary>
+      /// Return the values of all the joints.
+      /// </summary>
+      const std::vector<float>& getJointValues() const;
+
+      /// <summary>
+      /// Recompute the Transform of the dirty links and of their
+      /// descendants.
+      /// </summary>
+      /// <returns>
+      /// the number of recomputed links
+      /// </returns>
+      unsigned int update();
+
+      /// <summary>
+      /// Return the Transform of a link from the base frame of the tree,
+      /// after an update() if needed.
+      /// </summary>
+      /// <param name="pLink"> the index of the link </param>
+      const Transform& getLinkTransform(const unsigned int pLink);
+
+      /// <summary>
+      /// Return the Transform of all the links from the base frame of the
+      /// tree, after an update() if needed.
+      /// </summary>
+      const std::vector<Transform>& getLinkTransforms();
+
+      /// <summary>
+      /// Compute the geometric Jacobian of a point of a link, after an
+      /// update() if needed.
+      ///
+      /// Column j is the velocity of the point, expressed in the base
+      /// frame of the tree, for a unit velocity of joint j:
+      ///
+      /// (a x (p - o), a) for a revolute joint and (a, 0) for a prismatic
+      /// joint, where a is the axis and o the origin of the joint link and
+      /// p the point, all in the base frame. The columns of the joints
+      /// which do not move the link are zero.
+      ///
+      /// Only the rows selected by pAxisMask are written, in the order x,
+      /// y, z, wx, wy, wz: pJacobian is a pAxisMask.count() x
+      /// getNbJoints() matrix stored row by row. The link Transform
+      /// computed by the forward kinematics are reused, several columns
+      /// are computed at once with SIMD instructions when available and
+      /// there is no heap allocation.
+      /// </summary>
+      /// <param name="pLink"> the index of the link </param>
+      /// <param name="pPoint"> the point, in the frame of the link </param>
+      /// <param name="pAxisMask"> the rows to compute </param>
+      /// <param name="pJacobian"> the pAxisMask.count()*getNbJoints()
+      /// coefficients of the Jacobian </param>
+      void computeJacobian(
+          const unsigned int pLink,
+          const Position3D&  pPoint,
+          const AXIS_MASK&   pAxisMask,
+          float*             pJacobian);
+
+    private:
+      void xCheckLink(const unsigned int pLink) const;
+      void xCheckJoint(const unsigned int pJoint) const;
+
+      std::vector<int>           fParents;
+      std::vector<JointType>     fJointTypes;
+      std::vector<Transform>     fOffsets;
+      std::vector<int>           fJointIndexes;
+      std::vector<unsigned int>  fJointLinks;
+      std::vector<float>         fJointValues;
+      std::vector<Transform>     fTransforms;
+      // char rather than bool to avoid the bit packing of vector<bool>
+      std::vector<unsigned char> fIsDirty;
+      bool                       fHasDirty;
+      // computeJacobian buffers, 8 arrays of getNbJoints() float
+      std::vector<float>         fJacobianData;
+    };
+
+    /// <summary>
+    /// A KinematicChain is a KinematicTree whose links are added with
+    /// KinematicTree::addLink(pOffset, pJointType), each one being the
+    /// child of the previous one.
+    /// </summary>
+    /// \ingroup Tools
+    typedef KinematicTree KinematicChain;
+
+  } // namespace Math
+} // namespace AL
+
+#endif  // _LIBALMATH_ALMATH_TOOLS_ALKINEMATICTREE_H_
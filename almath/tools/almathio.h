@@ -24,6 +24,7 @@
 #include <almath/types/alvelocity3d.h>
 #include <almath/types/alvelocity6d.h>
 #include <almath/types/alquaternion.h>
+#include <almath/types/alquattransform.h>
 
 /// The purpose of grouping ostream operations in one place, is to speed
 /// compilation times when not requiring output.
@@ -207,6 +208,18 @@ std::string toSpaceSeparated(const Position6D& pPos);
 /// \ingroup Types
 std::ostream& operator<< (std::ostream& pStream, const Quaternion& pQua);
 
+/// <summary>
+/// Overloading of operator << for QuatTransform.
+///
+/// </summary>
+/// <param name="pStream"> the given ostream </param>
+/// <param name="pQT"> the given QuatTransform </param>
+/// <returns>
+/// the QuatTransform print
+/// </returns>
+/// \ingroup Types
+std::ostream& operator<< (std::ostream& pStream, const QuatTransform& pQT);
+
 }
 }
 #endif  // _LIBALMATH_ALMATH_TOOLS_ALMATHIO_H_
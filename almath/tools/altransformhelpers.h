@@ -88,6 +88,42 @@ namespace AL {
       const Velocity6D& pVel,
       Transform&        pT);
 
+    /// <summary>
+    /// Compute the logarithme of an array of transform.
+    ///
+    /// pVel[i] = transformLogarithm(pT[i]) for i in [0, pSize[
+    ///
+    /// Several transform are processed at once with SIMD instructions when
+    /// available. The results match transformLogarithm within 1e-4, the
+    /// rotation part is set to zero in the cases the scalar version does
+    /// not handle.
+    /// </summary>
+    /// <param name="pT"> the pSize given Transform </param>
+    /// <param name="pSize"> the number of Transform </param>
+    /// <param name="pVel"> the pSize resulting Velocity6D </param>
+    /// \ingroup Tools
+    void transformLogarithmBatch(
+      const Transform*   pT,
+      const unsigned int pSize,
+      Velocity6D*        pVel);
+
+    /// <summary>
+    /// Compute the exponential of an array of velocity.
+    ///
+    /// pT[i] = velocityExponential(pVel[i]) for i in [0, pSize[
+    ///
+    /// Several velocities are processed at once with SIMD instructions when
+    /// available. The results match velocityExponential within 1e-4.
+    /// </summary>
+    /// <param name="pVel"> the pSize given Velocity6D </param>
+    /// <param name="pSize"> the number of Velocity6D </param>
+    /// <param name="pT"> the pSize resulting Transform </param>
+    /// \ingroup Tools
+    void velocityExponentialBatch(
+      const Velocity6D*  pVel,
+      const unsigned int pSize,
+      Transform*         pT);
+
     /// <summary>
     /** \f$ \left[\begin{array}{c}
       * pVOut.xd  \\
@@ -333,6 +369,52 @@ namespace AL {
       const Velocity6D& pVelIn,
       Velocity6D&       pVelOut);
 
+    /// <summary>
+    /// Change the reference of all the columns of a Jacobian at once.
+    ///
+    /// pJIn is a 6xpNbColumns matrix stored row by row: its row k starts
+    /// at pJIn + k*pNbColumns, the first three rows being the linear part
+    /// and the last three the angular part. Each of its columns is changed
+    /// as by changeReferenceVelocity6D, several columns being processed at
+    /// once with SIMD instructions when available.
+    ///
+    /// pJOut may be pJIn to change the Jacobian in place.
+    /// </summary>
+    /// <param name = "pT"> the given Transform </param>
+    /// <param name = "pJIn"> the 6*pNbColumns coefficients of the
+    /// Jacobian to change
+    /// </param>
+    /// <param name = "pNbColumns"> the number of columns of the Jacobian </param>
+    /// <param name = "pJOut"> the 6*pNbColumns coefficients of the
+    /// changed Jacobian
+    /// </param>
+    /// \ingroup Tools
+    void changeReferenceJacobian(
+      const Transform&   pT,
+      const float*       pJIn,
+      const unsigned int pNbColumns,
+      float*             pJOut);
+
+    /// <summary>
+    /// Change the reference of all the columns of a Jacobian at once,
+    /// as by changeReferenceTransposeVelocity6D. See changeReferenceJacobian
+    /// for the layout of the Jacobian. pJOut may be pJIn.
+    /// </summary>
+    /// <param name = "pT"> the given Transform </param>
+    /// <param name = "pJIn"> the 6*pNbColumns coefficients of the
+    /// Jacobian to change
+    /// </param>
+    /// <param name = "pNbColumns"> the number of columns of the Jacobian </param>
+    /// <param name = "pJOut"> the 6*pNbColumns coefficients of the
+    /// changed Jacobian
+    /// </param>
+    /// \ingroup Tools
+    void changeReferenceTransposeJacobian(
+      const Transform&   pT,
+      const float*       pJIn,
+      const unsigned int pNbColumns,
+      float*             pJOut);
+
     /// <summary>
     /** \f$ \left[\begin{array}{c}
       * pPOut.x  \\
@@ -407,6 +489,100 @@ namespace AL {
       const Transform& pTIn2,
       const float&     pVal = 0.5f);
 
+    /// <summary>
+    /// Logarithmic interpolation between two Transform, as transformMean,
+    /// for many samples of the same pair.
+    ///
+    /// The relative twist transformLogarithm(pTIn1^-1*pTIn2) is computed
+    /// once, so that each sample only costs one velocityExponential and
+    /// one product. Unlike transformMean, which throws a
+    /// std::runtime_error out of [0, 1], the parameter is not checked: it
+    /// extrapolates along the same twist, and no exception is thrown when
+    /// sampling.
+    /// </summary>
+    /// \ingroup Tools
+    class TransformInterpolator
+    {
+    public:
+      /// <summary>
+      /// Create a TransformInterpolator between two identity Transform.
+      /// </summary>
+      TransformInterpolator();
+
+      /// <summary>
+      /// Create a TransformInterpolator between two Transform.
+      /// </summary>
+      /// <param name = "pTIn1"> the Transform at 0 </param>
+      /// <param name = "pTIn2"> the Transform at 1 </param>
+      TransformInterpolator(
+        const Transform& pTIn1,
+        const Transform& pTIn2);
+
+      /// <summary>
+      /// Change the two Transform.
+      /// </summary>
+      /// <param name = "pTIn1"> the Transform at 0 </param>
+      /// <param name = "pTIn2"> the Transform at 1 </param>
+      void set(
+        const Transform& pTIn1,
+        const Transform& pTIn2);
+
+      /// <summary>
+      /// Return the relative twist from the first Transform to the second.
+      /// </summary>
+      const Velocity6D& getVelocity() const;
+
+      /// <summary>
+      /// Compute the Transform at a parameter, as transformMeanInPlace.
+      /// </summary>
+      /// <param name = "pVal"> the parameter, 0 for pTIn1 and 1 for
+      /// pTIn2 </param>
+      /// <param name = "pTOut"> the output Transform </param>
+      void interpolateInPlace(
+        const float pVal,
+        Transform&  pTOut) const;
+
+      /// <summary>
+      /// Compute the Transform at a parameter, as transformMean.
+      /// </summary>
+      /// <param name = "pVal"> the parameter, 0 for pTIn1 and 1 for
+      /// pTIn2 </param>
+      /// <returns>
+      /// the interpolated Transform
+      /// </returns>
+      Transform interpolate(const float pVal) const;
+
+      /// <summary>
+      /// Compute the Transform at an array of parameters:
+      ///
+      /// pTOut[i] = interpolate(pVal[i]) for i in [0, pSize[
+      ///
+      /// Several samples are processed at once with SIMD instructions
+      /// when available. The results match interpolate within 1e-4.
+      /// </summary>
+      /// <param name = "pVal"> the pSize parameters </param>
+      /// <param name = "pSize"> the number of samples </param>
+      /// <param name = "pTOut"> the pSize interpolated Transform </param>
+      void interpolateBatch(
+        const float*       pVal,
+        const unsigned int pSize,
+        Transform*         pTOut) const;
+
+      /// <summary>
+      /// Compute pSize Transform evenly spaced from pTIn1 to pTIn2, both
+      /// included, as interpolateBatch.
+      /// </summary>
+      /// <param name = "pSize"> the number of samples </param>
+      /// <param name = "pTOut"> the pSize interpolated Transform </param>
+      void sample(
+        const unsigned int pSize,
+        Transform*         pTOut) const;
+
+    private:
+      Transform  fTIn1;
+      Velocity6D fVelocity;
+    };
+
     /// <summary>
     /// Create a Transform from 3D cartesian coordiantes and a Rotation.
     /**
@@ -783,6 +959,54 @@ namespace AL {
       const Transform&  pT,
       const Position3D& pPos);
 
+    /// <summary>
+    /// Transform an array of points stored as x0, y0, z0, x1, y1, z1, ...
+    ///
+    /// (pOut[3*i], pOut[3*i + 1], pOut[3*i + 2]) = pT*Position3D(
+    /// pXYZ[3*i], pXYZ[3*i + 1], pXYZ[3*i + 2]) for i in [0, pSize[
+    ///
+    /// pOut may be pXYZ to transform the points in place. Several points
+    /// are processed at once with SIMD instructions when available, and the
+    /// points are shared between threads when almath is built with OpenMP
+    /// (ALMATH_WITH_OPENMP).
+    /// </summary>
+    /// <param name="pT"> the Transform </param>
+    /// <param name="pXYZ"> the 3*pSize coordinates of the given points </param>
+    /// <param name="pSize"> the number of points </param>
+    /// <param name="pOut"> the 3*pSize coordinates of the resulting points </param>
+    /// \ingroup Tools
+    void transformPoints(
+      const Transform&   pT,
+      const float*       pXYZ,
+      const unsigned int pSize,
+      float*             pOut);
+
+    /// <summary>
+    /// Transform an array of points stored as a structure of arrays,
+    /// as the packed version of transformPoints.
+    ///
+    /// Each of pOutX, pOutY and pOutZ may be the input array of the same
+    /// coordinate to transform the points in place.
+    /// </summary>
+    /// <param name="pT"> the Transform </param>
+    /// <param name="pX"> the pSize x of the given points </param>
+    /// <param name="pY"> the pSize y of the given points </param>
+    /// <param name="pZ"> the pSize z of the given points </param>
+    /// <param name="pSize"> the number of points </param>
+    /// <param name="pOutX"> the pSize x of the resulting points </param>
+    /// <param name="pOutY"> the pSize y of the resulting points </param>
+    /// <param name="pOutZ"> the pSize z of the resulting points </param>
+    /// \ingroup Tools
+    void transformPoints(
+      const Transform&   pT,
+      const float*       pX,
+      const float*       pY,
+      const float*       pZ,
+      const unsigned int pSize,
+      float*             pOutX,
+      float*             pOutY,
+      float*             pOutZ);
+
     /**
     * finding the closest rotation Rw of R around an axis (Position3D)
     * @param Transform : useful only for Rotation part
@@ -835,9 +1059,150 @@ namespace AL {
     Transform transformFromQuaternion(
       const Quaternion& pQua);
 
+    /// <summary>
+    /// Compute the Quaternion of a Transform. The translation is ignored.
+    /// The resulting Quaternion is unit and has a non negative w, also
+    /// when the rotation part has drifted from an orthonormal matrix.
+    /// </summary>
+    /// <param name="pT"> the given Transform </param>
+    /// <returns>
+    /// the unit Quaternion of the rotation part of pT
+    /// </returns>
+    /// \ingroup Tools
     Quaternion quaternionFromTransform(
       const Transform& pT);
 
+    /// <summary>
+    /// Compute the Quaternion of an array of Transform, as
+    /// quaternionFromTransform. The translations are ignored and the
+    /// resulting Quaternion have a non negative w.
+    /// </summary>
+    /// <param name="pT"> the pSize given Transform </param>
+    /// <param name="pSize"> the number of Transform </param>
+    /// <param name="pQua"> the pSize resulting Quaternion </param>
+    /// \ingroup Tools
+    void quaternionFromTransformBatch(
+      const Transform*   pT,
+      const unsigned int pSize,
+      Quaternion*        pQua);
+
+    /// <summary>
+    /// Compute the Quaternion of an array of Rotation, as
+    /// quaternionFromTransform. The resulting Quaternion have a non
+    /// negative w.
+    /// </summary>
+    /// <param name="pRot"> the pSize given Rotation </param>
+    /// <param name="pSize"> the number of Rotation </param>
+    /// <param name="pQua"> the pSize resulting Quaternion </param>
+    /// \ingroup Tools
+    void quaternionFromRotationBatch(
+      const Rotation*    pRot,
+      const unsigned int pSize,
+      Quaternion*        pQua);
+
+    /// <summary>
+    /// Compute the Transform of an array of unit Quaternion, as
+    /// transformFromQuaternion. The translations are set to zero.
+    /// </summary>
+    /// <param name="pQua"> the pSize given Quaternion </param>
+    /// <param name="pSize"> the number of Quaternion </param>
+    /// <param name="pT"> the pSize resulting Transform </param>
+    /// \ingroup Tools
+    void transformFromQuaternionBatch(
+      const Quaternion*  pQua,
+      const unsigned int pSize,
+      Transform*         pT);
+
+    /// <summary>
+    /// Compute the Rotation of an array of unit Quaternion, as
+    /// transformFromQuaternion.
+    /// </summary>
+    /// <param name="pQua"> the pSize given Quaternion </param>
+    /// <param name="pSize"> the number of Quaternion </param>
+    /// <param name="pRot"> the pSize resulting Rotation </param>
+    /// \ingroup Tools
+    void rotationFromQuaternionBatch(
+      const Quaternion*  pQua,
+      const unsigned int pSize,
+      Rotation*          pRot);
+
+    /// <summary>
+    /// The Tait-Bryan conventions of the Euler angles, named by the order
+    /// of the product of the rotations around the fixed axes. The angles
+    /// are returned in a Rotation3D, wx being the angle around X, wy
+    /// around Y and wz around Z, whatever the order.
+    /// </summary>
+    /// \ingroup Tools
+    enum EulerConvention
+    {
+      /// R = Rz(wz)*Ry(wy)*Rx(wx), the convention of Rotation3D and Position6D
+      EULER_ZYX = 0,
+      /// R = Rx(wx)*Ry(wy)*Rz(wz)
+      EULER_XYZ = 1,
+      /// R = Rx(wx)*Rz(wz)*Ry(wy)
+      EULER_XZY = 2,
+      /// R = Ry(wy)*Rx(wx)*Rz(wz)
+      EULER_YXZ = 3,
+      /// R = Ry(wy)*Rz(wz)*Rx(wx)
+      EULER_YZX = 4,
+      /// R = Rz(wz)*Rx(wx)*Ry(wy)
+      EULER_ZXY = 5
+    };
+
+    /// <summary>
+    /// Compute the Euler angles of an array of Rotation.
+    ///
+    /// With EULER_ZYX, pRot3D[i] = rotation3DFromRotation(pRot[i]).
+    /// The middle angle is in [-pi/2, pi/2], the two others in [-pi, pi].
+    ///
+    /// Several rotations are processed at once with SIMD instructions when
+    /// available. The results match rotation3DFromRotation within 1e-5.
+    /// </summary>
+    /// <param name="pRot"> the pSize given Rotation </param>
+    /// <param name="pSize"> the number of Rotation </param>
+    /// <param name="pRot3D"> the pSize resulting Rotation3D </param>
+    /// <param name="pConvention"> the order of the rotations </param>
+    /// \ingroup Tools
+    void rotation3DFromRotationBatch(
+      const Rotation*       pRot,
+      const unsigned int    pSize,
+      Rotation3D*           pRot3D,
+      const EulerConvention pConvention = EULER_ZYX);
+
+    /// <summary>
+    /// Compute the Euler angles of the rotation part of an array of
+    /// Transform, as rotation3DFromRotationBatch.
+    ///
+    /// With EULER_ZYX, pRot3D[i] = rotation3DFromTransform(pT[i]).
+    /// </summary>
+    /// <param name="pT"> the pSize given Transform </param>
+    /// <param name="pSize"> the number of Transform </param>
+    /// <param name="pRot3D"> the pSize resulting Rotation3D </param>
+    /// <param name="pConvention"> the order of the rotations </param>
+    /// \ingroup Tools
+    void rotation3DFromTransformBatch(
+      const Transform*      pT,
+      const unsigned int    pSize,
+      Rotation3D*           pRot3D,
+      const EulerConvention pConvention = EULER_ZYX);
+
+    /// <summary>
+    /// Compute the Position6D of an array of Transform, the angles being
+    /// computed as rotation3DFromRotationBatch.
+    ///
+    /// With EULER_ZYX, pPos[i] = position6DFromTransform(pT[i]).
+    /// </summary>
+    /// <param name="pT"> the pSize given Transform </param>
+    /// <param name="pSize"> the number of Transform </param>
+    /// <param name="pPos"> the pSize resulting Position6D </param>
+    /// <param name="pConvention"> the order of the rotations </param>
+    /// \ingroup Tools
+    void position6DFromTransformBatch(
+      const Transform*      pT,
+      const unsigned int    pSize,
+      Position6D*           pPos,
+      const EulerConvention pConvention = EULER_ZYX);
+
   } // namespace Math
 } // namespace AL
 #endif  // _LIBALMATH_ALMATH_TOOLS_ALTRANSFORMHELPERS_H_
@@ -19,6 +19,71 @@ namespace AL {
   static const float PI_4   = 0.785398163397448309616f;
   static const float TO_RAD = 0.017453292f;
   static const float TO_DEG = 57.295779579f;
+
+    /// <summary>
+    /// Compute the sinus and the cosinus of an angle together, with a
+    /// polynomial approximation instead of libm.
+    ///
+    /// Max absolute error: 2.0e-7 for |pAngle| < 100, the result is only
+    /// meaningful for |pAngle| < 8192.
+    ///
+    /// ALMath uses it internally for the rotation construction when
+    /// built with ALMATH_WITH_FAST_TRIG.
+    /// </summary>
+    /// <param name="pAngle"> the angle in radian </param>
+    /// <param name="pSin"> the computed sinus </param>
+    /// <param name="pCos"> the computed cosinus </param>
+    /// \ingroup Tools
+    void fastSinCos(
+      const float pAngle,
+      float&      pSin,
+      float&      pCos);
+
+    /// <summary>
+    /// Four quadrant arc tangent of pY/pX with a polynomial approximation
+    /// instead of libm.
+    ///
+    /// Max absolute error: 4.0e-7 rad. Return 0 for (0, 0).
+    /// </summary>
+    /// <param name="pY"> the y coordinate </param>
+    /// <param name="pX"> the x coordinate </param>
+    /// <returns>
+    /// the angle in radian in [-pi, pi]
+    /// </returns>
+    /// \ingroup Tools
+    float fastAtan2(
+      const float pY,
+      const float pX);
+
+    /// <summary>
+    /// fastSinCos on an array of angles, several angles at once with SIMD
+    /// instructions when available.
+    /// </summary>
+    /// <param name="pAngles"> the pSize angles in radian </param>
+    /// <param name="pSize"> the number of angles </param>
+    /// <param name="pSin"> the pSize computed sinus </param>
+    /// <param name="pCos"> the pSize computed cosinus </param>
+    /// \ingroup Tools
+    void fastSinCosBatch(
+      const float*       pAngles,
+      const unsigned int pSize,
+      float*             pSin,
+      float*             pCos);
+
+    /// <summary>
+    /// fastAtan2 on arrays of coordinates, several angles at once with
+    /// SIMD instructions when available.
+    /// </summary>
+    /// <param name="pY"> the pSize y coordinates </param>
+    /// <param name="pX"> the pSize x coordinates </param>
+    /// <param name="pSize"> the number of angles </param>
+    /// <param name="pAngles"> the pSize computed angles </param>
+    /// \ingroup Tools
+    void fastAtan2Batch(
+      const float*       pY,
+      const float*       pX,
+      const unsigned int pSize,
+      float*             pAngles);
   }
 }
 #endif  // _LIBALMATH_ALMATH_TOOLS_ALTRIGONOMETRY_H_
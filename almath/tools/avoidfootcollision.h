@@ -49,6 +49,161 @@ namespace AL
         const float&    pMaxFootY,
         Pose2D&         pMove);
 
+    /// <summary>
+    /// Reusable foot collision model for footstep planners.
+    ///
+    /// The edge normals of both foot bounding boxes are computed once at
+    /// construction. Collision queries then use a separating axis test on
+    /// fixed size buffers, without any heap allocation, so large sets of
+    /// candidate moves can be evaluated at each step cycle.
+    ///
+    /// The bounding boxes must be convex polygons given clockwise, as for
+    /// avoidFootCollision, with at most MAX_VERTICES vertices.
+    /// </summary>
+    /// \ingroup Tools
+    class FootCollisionModel
+    {
+    public:
+      /// maximal number of vertices of a foot bounding box
+      static const unsigned int MAX_VERTICES = 8;
+
+      /// <summary>
+      /// Create a FootCollisionModel.
+      /// </summary>
+      /// <param name="pLFootBoundingBox"> vector<Pose2D> of the left footBoundingBox.</param>
+      /// <param name="pRFootBoundingBox"> vector<Pose2D> of the right footBoundingBox.</param>
+      /// <param name="pNbIteration">
+      /// the number of bisection iterations used to find the collision free
+      /// orientation. The orientation error is |pMove.theta|/2^(pNbIteration+1).
+      /// </param>
+      FootCollisionModel(
+          const std::vector<Pose2D>& pLFootBoundingBox,
+          const std::vector<Pose2D>& pRFootBoundingBox,
+          const unsigned int         pNbIteration = 5);
+
+      /// <summary>
+      /// Query if the swing foot moved by pMove collides with the support foot.
+      /// </summary>
+      /// <param name="pIsLeftSupport"> Bool true if left is the support leg. </param>
+      /// <param name="pMove">          the move of the swing foot. </param>
+      /// <returns>
+      /// true if the two feet are in collision.
+      /// </returns>
+      bool isInCollision(
+          const bool    pIsLeftSupport,
+          const Pose2D& pMove) const;
+
+      /// <summary>
+      /// Compute the best position(orientation) of the foot to avoid
+      /// collision, as avoidFootCollision does.
+      /// </summary>
+      /// <param name="pIsLeftSupport"> Bool true if left is the support leg. </param>
+      /// <param name="pMove">          the desired and return Pose2D. </param>
+      /// <returns>
+      /// true if pMove is clamped.
+      /// </returns>
+      bool avoidCollision(
+          const bool pIsLeftSupport,
+          Pose2D&    pMove) const;
+
+      /// <summary>
+      /// Change the number of bisection iterations.
+      /// </summary>
+      /// <param name="pNbIteration"> the number of iterations. </param>
+      void setNbIteration(const unsigned int pNbIteration);
+
+      /// <summary>
+      /// Return the number of bisection iterations.
+      /// </summary>
+      unsigned int getNbIteration() const;
+
+      /// <summary>
+      /// Evaluate a set of candidate moves of the swing foot, stored as a
+      /// structure of arrays. For each candidate, the move is first clipped
+      /// with clipFootWithEllipse, then its orientation is clamped with
+      /// avoidCollision.
+      ///
+      /// Several candidates are processed at once with SIMD instructions
+      /// when available, and the candidates are shared between threads
+      /// when almath is built with OpenMP (ALMATH_WITH_OPENMP).
+      ///
+      /// The clipping is identical to clipFootWithEllipse. The collision
+      /// test rotates the foot with the polynomial sin and cos of
+      /// altrigonometry.h (absolute error below 2.0e-7), as avoidCollision
+      /// does only when almath is built with ALMATH_WITH_FAST_TRIG.
+      /// Otherwise a move within this error of the collision boundary may
+      /// be classified differently, and the clamped theta then matches
+      /// avoidCollision within the final bisection interval.
+      /// </summary>
+      /// <param name="pIsLeftSupport"> Bool true if left is the support leg. </param>
+      /// <param name="pMaxFootX">      float of the max step along x axis. </param>
+      /// <param name="pMaxFootY">      float of the max step along y axis. </param>
+      /// <param name="pSize">          the number of candidates. </param>
+      /// <param name="pX">             the pSize x of the moves, clipped in place. </param>
+      /// <param name="pY">             the pSize y of the moves, clipped in place. </param>
+      /// <param name="pTheta">         the pSize theta of the moves, clamped in place. </param>
+      /// <param name="pIsClipped">     the pSize results of clipFootWithEllipse. </param>
+      /// <param name="pIsInCollision"> the pSize results of avoidCollision. </param>
+      void evaluateFootsteps(
+          const bool         pIsLeftSupport,
+          const float        pMaxFootX,
+          const float        pMaxFootY,
+          const unsigned int pSize,
+          float*             pX,
+          float*             pY,
+          float*             pTheta,
+          bool*              pIsClipped,
+          bool*              pIsInCollision) const;
+
+    private:
+      struct Polygon
+      {
+        unsigned int size;
+        float x[MAX_VERTICES];
+        float y[MAX_VERTICES];
+        // edge normals
+        float nx[MAX_VERTICES];
+        float ny[MAX_VERTICES];
+      };
+
+      static void xInitPolygon(
+          const std::vector<Pose2D>& pBox,
+          Polygon&                   pPolygon);
+
+      static bool xIsInCollision(
+          const Polygon& pFixed,
+          const Polygon& pMoving,
+          const Pose2D&  pMove);
+
+      // T is float or a SIMD pack of the library, Mask its comparison result
+      template <typename T, typename Mask>
+      static void xIsInCollisionBatch(
+          const Polygon& pFixed,
+          const Polygon& pMoving,
+          const T&       pX,
+          const T&       pY,
+          const T&       pTheta,
+          Mask&          pIsInCollision);
+
+      template <typename T>
+      static void xEvaluateFootsteps(
+          const Polygon&     pFixed,
+          const Polygon&     pMoving,
+          const unsigned int pNbIteration,
+          const float        pMaxFootX,
+          const float        pMaxFootY,
+          const unsigned int pIndex,
+          float*             pX,
+          float*             pY,
+          float*             pTheta,
+          bool*              pIsClipped,
+          bool*              pIsInCollision);
+
+      Polygon fLFoot;
+      Polygon fRFoot;
+      unsigned int fNbIteration;
+    };
+
   } // namespace Math
 } // namespace AL
 
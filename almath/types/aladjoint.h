@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TYPES_ALADJOINT_H_
+#define _LIBALMATH_ALMATH_TYPES_ALADJOINT_H_
+
+#include <almath/types/altransform.h>
+#include <almath/types/alvelocity6d.h>
+
+namespace AL {
+  namespace Math {
+
+    /// <summary>
+    /// The adjoint of a Transform H = [R p]: the 6x6 matrix
+    /**
+     *
+     * \f$ \left[\begin{array}{cc}
+     *         R & [p]_{\times} R \\
+     *         0 & R
+     *      \end{array}\right]\f$
+     *
+     */
+    /// which changes the reference frame of a Velocity6D (xd, yd, zd then
+    /// wxd, wyd, wzd): if pV is the velocity of a frame B expressed in B,
+    /// and H the Transform from A to B, Adjoint(H)*pV is the same velocity
+    /// expressed in A, at the origin of A.
+    ///
+    /// It is computed once from a Transform, so that applying it to many
+    /// velocities only costs a small matrix product. Only its two non zero
+    /// 3x3 blocks are stored.
+    ///
+    /// A wrench is stored in a Velocity6D: the force in xd, yd, zd and the
+    /// torque in wxd, wyd, wzd.
+    /// </summary>
+    /// \ingroup Types
+    struct Adjoint {
+      /// <summary> the rotation block R, row by row </summary>
+      float r[9];
+      /// <summary> the coupling block [p]x R, row by row </summary>
+      float pr[9];
+
+      /// <summary>
+      /// Create an identity Adjoint.
+      /// </summary>
+      Adjoint();
+
+      /// <summary>
+      /// Create the Adjoint of a Transform.
+      /// </summary>
+      /// <param name="pT"> the Transform, with an orthonormal rotation </param>
+      explicit Adjoint(const Transform& pT);
+
+      /// <summary>
+      /// Overloading of operator * for Adjoint:
+      /// Adjoint(pT1)*Adjoint(pT2) = Adjoint(pT1*pT2).
+      /// </summary>
+      /// <param name="pAd2"> the second Adjoint </param>
+      Adjoint operator* (const Adjoint& pAd2) const;
+
+      /// <summary>
+      /// Change the reference frame of a velocity.
+      /// </summary>
+      /// <param name="pV"> the Velocity6D </param>
+      Velocity6D operator* (const Velocity6D& pV) const;
+
+      /// <summary>
+      /// Multiply a Velocity6D by the transpose of the Adjoint, the
+      /// co-adjoint. It brings a wrench expressed in A back to B, as
+      /// needed for the transposed Jacobian.
+      /// </summary>
+      /// <param name="pV"> the Velocity6D </param>
+      Velocity6D transposeMultiply(const Velocity6D& pV) const;
+
+      /// <summary>
+      /// Change the reference frame of a wrench: if pWrench is expressed
+      /// in B, the result is the same wrench expressed in A, at the origin
+      /// of A. It is the multiplication by the inverse transpose of the
+      /// Adjoint.
+      /// </summary>
+      /// <param name="pWrench"> the force and the torque </param>
+      Velocity6D transformWrench(const Velocity6D& pWrench) const;
+
+      /// <summary>
+      /// Compute the inverse of the Adjoint, which is the Adjoint of the
+      /// inverse Transform.
+      /// </summary>
+      /// <returns>
+      /// the Adjoint inverse
+      /// </returns>
+      Adjoint inverse() const;
+
+      /// <summary>
+      /// Check if the actual Adjoint is near the one given in argument.
+      /// </summary>
+      /// <param name="pAd2"> the second Adjoint </param>
+      /// <param name="pEpsilon"> an optionnal epsilon distance - default: 0.0001 </param>
+      /// <returns>
+      /// true if the distance between the two Adjoint is less than pEpsilon
+      /// </returns>
+      bool isNear(
+        const Adjoint& pAd2,
+        const float&   pEpsilon=0.0001f) const;
+
+      /// number of float written by writeTo: the 6x6 matrix row by row
+      static const unsigned int SIZE = 36;
+
+      /// <summary>
+      /// Write the 6x6 matrix of the Adjoint, row by row, to a buffer of
+      /// SIZE float.
+      /// </summary>
+      /// <param name="pOut"> the buffer of at least SIZE float </param>
+      void writeTo(float* pOut) const;
+    };
+
+    /// <summary>
+    /// Change the reference frame of an array of velocities:
+    ///
+    /// pOut[i] = pAd*pV[i] for i in [0, pSize[
+    ///
+    /// pOut may be pV. Several velocities are processed at once with SIMD
+    /// instructions when available.
+    /// </summary>
+    /// <param name="pAd"> the Adjoint </param>
+    /// <param name="pV"> the pSize given Velocity6D </param>
+    /// <param name="pSize"> the number of Velocity6D </param>
+    /// <param name="pOut"> the pSize resulting Velocity6D </param>
+    /// \ingroup Types
+    void adjointMultiplyBatch(
+      const Adjoint&     pAd,
+      const Velocity6D*  pV,
+      const unsigned int pSize,
+      Velocity6D*        pOut);
+
+    /// <summary>
+    /// Multiply an array of Velocity6D by the transpose of an Adjoint,
+    /// as Adjoint::transposeMultiply. pOut may be pV.
+    /// </summary>
+    /// <param name="pAd"> the Adjoint </param>
+    /// <param name="pV"> the pSize given Velocity6D </param>
+    /// <param name="pSize"> the number of Velocity6D </param>
+    /// <param name="pOut"> the pSize resulting Velocity6D </param>
+    /// \ingroup Types
+    void adjointTransposeMultiplyBatch(
+      const Adjoint&     pAd,
+      const Velocity6D*  pV,
+      const unsigned int pSize,
+      Velocity6D*        pOut);
+
+    /// <summary>
+    /// Change the reference frame of an array of wrenches, as
+    /// Adjoint::transformWrench. pOut may be pWrench.
+    /// </summary>
+    /// <param name="pAd"> the Adjoint </param>
+    /// <param name="pWrench"> the pSize given wrenches </param>
+    /// <param name="pSize"> the number of wrenches </param>
+    /// <param name="pOut"> the pSize resulting wrenches </param>
+    /// \ingroup Types
+    void adjointTransformWrenchBatch(
+      const Adjoint&     pAd,
+      const Velocity6D*  pWrench,
+      const unsigned int pSize,
+      Velocity6D*        pOut);
+
+  } // end namespace Math
+} // end namespace AL
+#endif  // _LIBALMATH_ALMATH_TYPES_ALADJOINT_H_
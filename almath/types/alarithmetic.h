@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+// The arithmetic of Pose2D and Transform, written once for any scalar
+// type. Instantiated by the float types and by the BasicPose2D and
+// BasicTransform of albasictypes.h, so that both compute the same thing.
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TYPES_ALARITHMETIC_H_
+#define _LIBALMATH_ALMATH_TYPES_ALARITHMETIC_H_
+
+#include <almath/types/alconfig.h>
+#include <cmath>
+
+#ifdef ALMATH_FAST_TRIG
+# include <almath/tools/altrigonometry.h>
+#endif
+
+namespace AL {
+  namespace Math {
+
+    /** \cond PRIVATE */
+    namespace Detail {
+      // same backend as the rest of the library, see ALMATH_WITH_FAST_TRIG
+      inline void pose2DSinCos(
+        const float pTheta,
+        float&      pSin,
+        float&      pCos)
+      {
+#ifdef ALMATH_FAST_TRIG
+        fastSinCos(pTheta, pSin, pCos);
+#else
+        pSin = sinf(pTheta);
+        pCos = cosf(pTheta);
+#endif
+      }
+
+      // the fast backend is a float approximation: the double precision
+      // types always use libm
+      inline void pose2DSinCos(
+        const double pTheta,
+        double&      pSin,
+        double&      pCos)
+      {
+        pSin = std::sin(pTheta);
+        pCos = std::cos(pTheta);
+      }
+
+      // pPose1 = pPose1*pPose2, for the Pose2D of scalar T
+      template <typename T, typename P>
+      inline void pose2DMultiplyInPlace(
+        P&       pPose1,
+        const P& pPose2)
+      {
+        T s = 0;
+        T c = 0;
+        pose2DSinCos(pPose1.theta, s, c);
+
+        pPose1.x += c * pPose2.x - s * pPose2.y;
+        pPose1.y += s * pPose2.x + c * pPose2.y;
+        pPose1.theta += pPose2.theta;
+      }
+
+      // pOut = pIn^-1, pOut and pIn must be different
+      template <typename T, typename P>
+      inline void pose2DInvert(
+        const P& pIn,
+        P&       pOut)
+      {
+        pOut.theta = -pIn.theta;
+
+        T s = 0;
+        T c = 0;
+        pose2DSinCos(pOut.theta, s, c);
+
+        pOut.x = -( pIn.x*c - pIn.y*s);
+        pOut.y = -( pIn.y*c + pIn.x*s);
+      }
+
+      // pT1 = pT1*pT2, for the Transform of scalar T
+      template <typename T, typename M>
+      inline void transformMultiplyInPlace(
+        M&       pT1,
+        const M& pT2)
+      {
+        T c1 = pT1.r1_c1;
+        T c2 = pT1.r1_c2;
+        T c3 = pT1.r1_c3;
+        pT1.r1_c1 = (c1 * pT2.r1_c1) + (c2 * pT2.r2_c1) + (c3 * pT2.r3_c1);
+        pT1.r1_c2 = (c1 * pT2.r1_c2) + (c2 * pT2.r2_c2) + (c3 * pT2.r3_c2);
+        pT1.r1_c3 = (c1 * pT2.r1_c3) + (c2 * pT2.r2_c3) + (c3 * pT2.r3_c3);
+        pT1.r1_c4 = (c1 * pT2.r1_c4) + (c2 * pT2.r2_c4) + (c3 * pT2.r3_c4) + pT1.r1_c4;
+        c1 = pT1.r2_c1;
+        c2 = pT1.r2_c2;
+        c3 = pT1.r2_c3;
+        pT1.r2_c1 = (c1 * pT2.r1_c1) + (c2 * pT2.r2_c1) + (c3 * pT2.r3_c1);
+        pT1.r2_c2 = (c1 * pT2.r1_c2) + (c2 * pT2.r2_c2) + (c3 * pT2.r3_c2);
+        pT1.r2_c3 = (c1 * pT2.r1_c3) + (c2 * pT2.r2_c3) + (c3 * pT2.r3_c3);
+        pT1.r2_c4 = (c1 * pT2.r1_c4) + (c2 * pT2.r2_c4) + (c3 * pT2.r3_c4) + pT1.r2_c4;
+        c1 = pT1.r3_c1;
+        c2 = pT1.r3_c2;
+        c3 = pT1.r3_c3;
+        pT1.r3_c1 = (c1 * pT2.r1_c1) + (c2 * pT2.r2_c1) + (c3 * pT2.r3_c1);
+        pT1.r3_c2 = (c1 * pT2.r1_c2) + (c2 * pT2.r2_c2) + (c3 * pT2.r3_c2);
+        pT1.r3_c3 = (c1 * pT2.r1_c3) + (c2 * pT2.r2_c3) + (c3 * pT2.r3_c3);
+        pT1.r3_c4 = (c1 * pT2.r1_c4) + (c2 * pT2.r2_c4) + (c3 * pT2.r3_c4) + pT1.r3_c4;
+      }
+
+      // pT*pPos, for a Position3D type P constructible from x, y and z
+      template <typename M, typename P>
+      inline P transformApply(
+        const M& pT,
+        const P& pPos)
+      {
+        return P(
+          (pT.r1_c1 * pPos.x) + (pT.r1_c2 * pPos.y) + (pT.r1_c3 * pPos.z) + pT.r1_c4,
+          (pT.r2_c1 * pPos.x) + (pT.r2_c2 * pPos.y) + (pT.r2_c3 * pPos.z) + pT.r2_c4,
+          (pT.r3_c1 * pPos.x) + (pT.r3_c2 * pPos.y) + (pT.r3_c3 * pPos.z) + pT.r3_c4);
+      }
+
+      // pTOut = pT^-1 for a rigid pT, pTOut and pT must be different
+      template <typename M>
+      inline void transformInvert(
+        const M& pT,
+        M&       pTOut)
+      {
+        // rotation Ri = R'
+        pTOut.r1_c1 = pT.r1_c1;
+        pTOut.r1_c2 = pT.r2_c1;
+        pTOut.r1_c3 = pT.r3_c1;
+        pTOut.r2_c1 = pT.r1_c2;
+        pTOut.r2_c2 = pT.r2_c2;
+        pTOut.r2_c3 = pT.r3_c2;
+        pTOut.r3_c1 = pT.r1_c3;
+        pTOut.r3_c2 = pT.r2_c3;
+        pTOut.r3_c3 = pT.r3_c3;
+
+        // translation ri = -R'*r
+        pTOut.r1_c4 = -( pT.r1_c1*pT.r1_c4 + pT.r2_c1*pT.r2_c4 + pT.r3_c1*pT.r3_c4 );
+        pTOut.r2_c4 = -( pT.r1_c2*pT.r1_c4 + pT.r2_c2*pT.r2_c4 + pT.r3_c2*pT.r3_c4 );
+        pTOut.r3_c4 = -( pT.r1_c3*pT.r1_c4 + pT.r2_c3*pT.r2_c4 + pT.r3_c3*pT.r3_c4 );
+      }
+    }
+    /** \endcond */
+
+  } // end namespace Math
+} // end namespace AL
+#endif  // _LIBALMATH_ALMATH_TYPES_ALARITHMETIC_H_
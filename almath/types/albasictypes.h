@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TYPES_ALBASICTYPES_H_
+#define _LIBALMATH_ALMATH_TYPES_ALBASICTYPES_H_
+
+#include <almath/types/alarithmetic.h>
+#include <almath/types/alposition3d.h>
+#include <almath/types/alpose2d.h>
+#include <almath/types/altransform.h>
+#include <cmath>
+
+namespace AL {
+  namespace Math {
+
+    /// <summary>
+    /// A Position3D with coordinates of type T.
+    ///
+    /// The float types of almath stay the ones to use in the hot paths.
+    /// BasicPosition3D, BasicPose2D and BasicTransform are meant for the
+    /// accumulators that need double precision, as long horizon odometry
+    /// or calibration. They are created from the float types without any
+    /// explicit conversion, so a float increment can be accumulated
+    /// directly in a double accumulator:
+    ///
+    /// Pose2Dd odometry;
+    /// odometry *= Pose2D(0.01f, 0.0f, 0.001f);
+    ///
+    /// These templates are header only: they do not change the ABI of
+    /// the float types. Their products and inverses are the ones of the
+    /// float types, instantiated for T (see alarithmetic.h), except that
+    /// the double precision types always use the sin and cos of libm.
+    /// The other types and the functions of altransformhelpers.h only
+    /// exist in float.
+    /// </summary>
+    /// \ingroup Types
+    template <typename T>
+    struct BasicPosition3D {
+      /// <summary> the x coordinate </summary>
+      T x;
+      /// <summary> the y coordinate </summary>
+      T y;
+      /// <summary> the z coordinate </summary>
+      T z;
+
+      /// <summary>
+      /// Create a BasicPosition3D initialized with 0.
+      /// </summary>
+      BasicPosition3D():
+        x(0), y(0), z(0) {}
+
+      /// <summary>
+      /// Create a BasicPosition3D with explicit values.
+      /// </summary>
+      /// <param name="pX"> the x coordinate </param>
+      /// <param name="pY"> the y coordinate </param>
+      /// <param name="pZ"> the z coordinate </param>
+      BasicPosition3D(
+        const T pX,
+        const T pY,
+        const T pZ):
+        x(pX), y(pY), z(pZ) {}
+
+      /// <summary>
+      /// Create a BasicPosition3D from a Position3D.
+      /// </summary>
+      /// <param name="pPos"> the Position3D </param>
+      BasicPosition3D(const Position3D& pPos):
+        x(pPos.x), y(pPos.y), z(pPos.z) {}
+
+      /// <summary>
+      /// Overloading of operator + for BasicPosition3D.
+      /// </summary>
+      /// <param name="pPos2"> the second BasicPosition3D </param>
+      BasicPosition3D operator+ (const BasicPosition3D& pPos2) const
+      {
+        return BasicPosition3D(x + pPos2.x, y + pPos2.y, z + pPos2.z);
+      }
+
+      /// <summary>
+      /// Overloading of operator - for BasicPosition3D.
+      /// </summary>
+      /// <param name="pPos2"> the second BasicPosition3D </param>
+      BasicPosition3D operator- (const BasicPosition3D& pPos2) const
+      {
+        return BasicPosition3D(x - pPos2.x, y - pPos2.y, z - pPos2.z);
+      }
+
+      /// <summary>
+      /// Overloading of operator += for BasicPosition3D.
+      /// </summary>
+      /// <param name="pPos2"> the second BasicPosition3D </param>
+      BasicPosition3D& operator+= (const BasicPosition3D& pPos2)
+      {
+        x += pPos2.x;
+        y += pPos2.y;
+        z += pPos2.z;
+        return *this;
+      }
+
+      /// <summary>
+      /// Overloading of operator -= for BasicPosition3D.
+      /// </summary>
+      /// <param name="pPos2"> the second BasicPosition3D </param>
+      BasicPosition3D& operator-= (const BasicPosition3D& pPos2)
+      {
+        x -= pPos2.x;
+        y -= pPos2.y;
+        z -= pPos2.z;
+        return *this;
+      }
+
+      /// <summary>
+      /// Overloading of operator * for BasicPosition3D.
+      /// </summary>
+      /// <param name="pVal"> the factor </param>
+      BasicPosition3D operator* (const T pVal) const
+      {
+        return BasicPosition3D(x*pVal, y*pVal, z*pVal);
+      }
+
+      /// <summary>
+      /// Compute the dot product with another BasicPosition3D.
+      /// </summary>
+      /// <param name="pPos2"> the second BasicPosition3D </param>
+      T dotProduct(const BasicPosition3D& pPos2) const
+      {
+        return x*pPos2.x + y*pPos2.y + z*pPos2.z;
+      }
+
+      /// <summary>
+      /// Compute the norm of the BasicPosition3D.
+      /// </summary>
+      T norm() const
+      {
+        return std::sqrt(dotProduct(*this));
+      }
+
+      /// <summary>
+      /// Check if the actual BasicPosition3D is near the one
+      /// given in argument.
+      /// </summary>
+      /// <param name="pPos2"> the second BasicPosition3D </param>
+      /// <param name="pEpsilon"> an optionnal epsilon distance </param>
+      bool isNear(
+        const BasicPosition3D& pPos2,
+        const T                pEpsilon = T(0.0001)) const
+      {
+        return (std::fabs(x - pPos2.x) <= pEpsilon) &&
+               (std::fabs(y - pPos2.y) <= pEpsilon) &&
+               (std::fabs(z - pPos2.z) <= pEpsilon);
+      }
+
+      /// <summary>
+      /// Round the BasicPosition3D to a Position3D.
+      /// </summary>
+      Position3D toPosition3D() const
+      {
+        return Position3D(
+          static_cast<float>(x),
+          static_cast<float>(y),
+          static_cast<float>(z));
+      }
+    };
+
+    /// <summary>
+    /// A Pose2D with coordinates of type T, see BasicPosition3D.
+    /// </summary>
+    /// \ingroup Types
+    template <typename T>
+    struct BasicPose2D {
+      /// <summary> the x coordinate </summary>
+      T x;
+      /// <summary> the y coordinate </summary>
+      T y;
+      /// <summary> the orientation </summary>
+      T theta;
+
+      /// <summary>
+      /// Create a BasicPose2D initialized with 0.
+      /// </summary>
+      BasicPose2D():
+        x(0), y(0), theta(0) {}
+
+      /// <summary>
+      /// Create a BasicPose2D with explicit values.
+      /// </summary>
+      /// <param name="pX"> the x coordinate </param>
+      /// <param name="pY"> the y coordinate </param>
+      /// <param name="pTheta"> the orientation </param>
+      BasicPose2D(
+        const T pX,
+        const T pY,
+        const T pTheta):
+        x(pX), y(pY), theta(pTheta) {}
+
+      /// <summary>
+      /// Create a BasicPose2D from a Pose2D.
+      /// </summary>
+      /// <param name="pPose"> the Pose2D </param>
+      BasicPose2D(const Pose2D& pPose):
+        x(pPose.x), y(pPose.y), theta(pPose.theta) {}
+
+      /// <summary>
+      /// Overloading of operator * for BasicPose2D, same convention as
+      /// Pose2D::operator*.
+      /// </summary>
+      /// <param name="pPos2"> the second BasicPose2D </param>
+      BasicPose2D operator* (const BasicPose2D& pPos2) const
+      {
+        BasicPose2D pOut(*this);
+        pOut *= pPos2;
+        return pOut;
+      }
+
+      /// <summary>
+      /// Overloading of operator *= for BasicPose2D.
+      /// </summary>
+      /// <param name="pPos2"> the second BasicPose2D </param>
+      BasicPose2D& operator*= (const BasicPose2D& pPos2)
+      {
+        Detail::pose2DMultiplyInPlace<T>(*this, pPos2);
+        return *this;
+      }
+
+      /// <summary>
+      /// Compute the inverse of the BasicPose2D.
+      /// </summary>
+      BasicPose2D inverse() const
+      {
+        BasicPose2D pOut;
+        Detail::pose2DInvert<T>(*this, pOut);
+        return pOut;
+      }
+
+      /// <summary>
+      /// Check if the actual BasicPose2D is near the one
+      /// given in argument.
+      /// </summary>
+      /// <param name="pPos2"> the second BasicPose2D </param>
+      /// <param name="pEpsilon"> an optionnal epsilon distance </param>
+      bool isNear(
+        const BasicPose2D& pPos2,
+        const T            pEpsilon = T(0.0001)) const
+      {
+        return (std::fabs(x - pPos2.x) <= pEpsilon) &&
+               (std::fabs(y - pPos2.y) <= pEpsilon) &&
+               (std::fabs(theta - pPos2.theta) <= pEpsilon);
+      }
+
+      /// <summary>
+      /// Round the BasicPose2D to a Pose2D.
+      /// </summary>
+      Pose2D toPose2D() const
+      {
+        return Pose2D(
+          static_cast<float>(x),
+          static_cast<float>(y),
+          static_cast<float>(theta));
+      }
+    };
+
+    /// <summary>
+    /// A Transform with coefficients of type T, see BasicPosition3D.
+    /// </summary>
+    /// \ingroup Types
+    template <typename T>
+    struct BasicTransform {
+      /** \cond PRIVATE */
+      T r1_c1, r1_c2, r1_c3, r1_c4;
+      T r2_c1, r2_c2, r2_c3, r2_c4;
+      T r3_c1, r3_c2, r3_c3, r3_c4;
+      /** \endcond */
+
+      /// <summary>
+      /// Create an identity BasicTransform.
+      /// </summary>
+      BasicTransform():
+        r1_c1(1), r1_c2(0), r1_c3(0), r1_c4(0),
+        r2_c1(0), r2_c2(1), r2_c3(0), r2_c4(0),
+        r3_c1(0), r3_c2(0), r3_c3(1), r3_c4(0) {}
+
+      /// <summary>
+      /// Create a BasicTransform from a Transform.
+      /// </summary>
+      /// <param name="pT"> the Transform </param>
+      BasicTransform(const Transform& pT):
+        r1_c1(pT.r1_c1), r1_c2(pT.r1_c2), r1_c3(pT.r1_c3), r1_c4(pT.r1_c4),
+        r2_c1(pT.r2_c1), r2_c2(pT.r2_c2), r2_c3(pT.r2_c3), r2_c4(pT.r2_c4),
+        r3_c1(pT.r3_c1), r3_c2(pT.r3_c2), r3_c3(pT.r3_c3), r3_c4(pT.r3_c4) {}
+
+      /// <summary>
+      /// Overloading of operator *= for BasicTransform.
+      /// </summary>
+      /// <param name="pT2"> the second BasicTransform </param>
+      BasicTransform& operator*= (const BasicTransform& pT2)
+      {
+        Detail::transformMultiplyInPlace<T>(*this, pT2);
+        return *this;
+      }
+
+      /// <summary>
+      /// Overloading of operator * for BasicTransform, same convention
+      /// as Transform::operator*.
+      /// </summary>
+      /// <param name="pT2"> the second BasicTransform </param>
+      BasicTransform operator* (const BasicTransform& pT2) const
+      {
+        BasicTransform pOut(*this);
+        pOut *= pT2;
+        return pOut;
+      }
+
+      /// <summary>
+      /// Apply the BasicTransform to a BasicPosition3D.
+      /// </summary>
+      /// <param name="pPos"> the BasicPosition3D to transform </param>
+      BasicPosition3D<T> operator* (const BasicPosition3D<T>& pPos) const
+      {
+        return Detail::transformApply(*this, pPos);
+      }
+
+      /// <summary>
+      /// Compute the inverse of a rigid BasicTransform.
+      /// </summary>
+      BasicTransform inverse() const
+      {
+        BasicTransform pOut;
+        Detail::transformInvert(*this, pOut);
+        return pOut;
+      }
+
+      /// <summary>
+      /// Check if the actual BasicTransform is near the one
+      /// given in argument.
+      /// </summary>
+      /// <param name="pT2"> the second BasicTransform </param>
+      /// <param name="pEpsilon"> an optionnal epsilon distance </param>
+      bool isNear(
+        const BasicTransform& pT2,
+        const T               pEpsilon = T(0.0001)) const
+      {
+        return (std::fabs(r1_c1 - pT2.r1_c1) <= pEpsilon) &&
+               (std::fabs(r1_c2 - pT2.r1_c2) <= pEpsilon) &&
+               (std::fabs(r1_c3 - pT2.r1_c3) <= pEpsilon) &&
+               (std::fabs(r1_c4 - pT2.r1_c4) <= pEpsilon) &&
+               (std::fabs(r2_c1 - pT2.r2_c1) <= pEpsilon) &&
+               (std::fabs(r2_c2 - pT2.r2_c2) <= pEpsilon) &&
+               (std::fabs(r2_c3 - pT2.r2_c3) <= pEpsilon) &&
+               (std::fabs(r2_c4 - pT2.r2_c4) <= pEpsilon) &&
+               (std::fabs(r3_c1 - pT2.r3_c1) <= pEpsilon) &&
+               (std::fabs(r3_c2 - pT2.r3_c2) <= pEpsilon) &&
+               (std::fabs(r3_c3 - pT2.r3_c3) <= pEpsilon) &&
+               (std::fabs(r3_c4 - pT2.r3_c4) <= pEpsilon);
+      }
+
+      /// <summary>
+      /// Round the BasicTransform to a Transform.
+      /// </summary>
+      Transform toTransform() const
+      {
+        Transform pOut;
+        pOut.r1_c1 = static_cast<float>(r1_c1);
+        pOut.r1_c2 = static_cast<float>(r1_c2);
+        pOut.r1_c3 = static_cast<float>(r1_c3);
+        pOut.r1_c4 = static_cast<float>(r1_c4);
+        pOut.r2_c1 = static_cast<float>(r2_c1);
+        pOut.r2_c2 = static_cast<float>(r2_c2);
+        pOut.r2_c3 = static_cast<float>(r2_c3);
+        pOut.r2_c4 = static_cast<float>(r2_c4);
+        pOut.r3_c1 = static_cast<float>(r3_c1);
+        pOut.r3_c2 = static_cast<float>(r3_c2);
+        pOut.r3_c3 = static_cast<float>(r3_c3);
+        pOut.r3_c4 = static_cast<float>(r3_c4);
+        return pOut;
+      }
+    };
+
+    /// <summary> double precision Position3D </summary>
+    /// \ingroup Types
+    typedef BasicPosition3D<double> Position3Dd;
+
+    /// <summary> double precision Pose2D </summary>
+    /// \ingroup Types
+    typedef BasicPose2D<double> Pose2Dd;
+
+    /// <summary> double precision Transform </summary>
+    /// \ingroup Types
+    typedef BasicTransform<double> Transformd;
+
+  } // end namespace Math
+} // end namespace AL
+#endif  // _LIBALMATH_ALMATH_TYPES_ALBASICTYPES_H_
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TYPES_ALFLOATBUFFER_H_
+#define _LIBALMATH_ALMATH_TYPES_ALFLOATBUFFER_H_
+
+namespace AL {
+  namespace Math {
+
+    /// <summary>
+    /// Read pNb values of type T from a packed buffer of pNb*T::SIZE float,
+    /// without heap allocation.
+    ///
+    /// T is one of the almath types with a SIZE constant and a
+    /// (const float*, unsigned int) constructor, as Position3D or Transform.
+    /// </summary>
+    /// <param name="pFloats"> the buffer of pNb*T::SIZE float </param>
+    /// <param name="pNb"> the number of values </param>
+    /// <param name="pOut"> the pNb values </param>
+    /// \ingroup Types
+    template <typename T>
+    void fromFloatBuffer(
+      const float*       pFloats,
+      const unsigned int pNb,
+      T*                 pOut)
+    {
+      for (unsigned int i = 0; i < pNb; ++i)
+      {
+        pOut[i] = T(pFloats + i*T::SIZE, T::SIZE);
+      }
+    }
+
+    /// <summary>
+    /// Write pNb values of type T to a packed buffer of pNb*T::SIZE float,
+    /// without heap allocation.
+    ///
+    /// T is one of the almath types with a SIZE constant and a writeTo
+    /// method, as Position3D or Transform.
+    /// </summary>
+    /// <param name="pIn"> the pNb values </param>
+    /// <param name="pNb"> the number of values </param>
+    /// <param name="pFloats"> the buffer of pNb*T::SIZE float </param>
+    /// \ingroup Types
+    template <typename T>
+    void toFloatBuffer(
+      const T*           pIn,
+      const unsigned int pNb,
+      float*             pFloats)
+    {
+      for (unsigned int i = 0; i < pNb; ++i)
+      {
+        pIn[i].writeTo(pFloats + i*T::SIZE);
+      }
+    }
+
+  } // end namespace math
+} // end namespace al
+#endif  // _LIBALMATH_ALMATH_TYPES_ALFLOATBUFFER_H_
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TYPES_ALINLINE_H_
+#define _LIBALMATH_ALMATH_TYPES_ALINLINE_H_
+
+/// \def ALMATH_INLINE_TYPES
+/// Define ALMATH_INLINE_TYPES before including the almath headers to get
+/// the arithmetic of the core value types (Position3D, Pose2D, Quaternion
+/// and Transform, and the views of altransformview.h) inline. The
+/// compiler can then fuse and vectorize the loops over these types
+/// instead of calling the library for each operation.
+///
+/// The definitions are in the alxxx.hxx headers. The almath library
+/// always compiles them out-of-line, so its exported symbols do not
+/// depend on this macro. The build options the definitions depend on
+/// are exported in alconfig.h.
+///
+/// Linking code built with the macro against the library defines the
+/// same functions both inline and out-of-line: in standard C++ this is
+/// an ODR violation, no diagnostic required. It works in practice with
+/// the toolchains almath supports (GCC, Clang and MSVC), which emit the
+/// inline copies as COMDAT or weak symbols and merge them with, or
+/// discard them in favour of, the library ones. The inline tests and
+/// benchmark rely on this; it is not a language guarantee.
+
+/** \cond PRIVATE */
+#ifdef ALMATH_INLINE_TYPES
+# define ALMATH_INLINE inline
+#else
+# define ALMATH_INLINE
+#endif
+/** \endcond */
+
+#endif  // _LIBALMATH_ALMATH_TYPES_ALINLINE_H_
@@ -9,6 +9,7 @@
 #ifndef _LIBALMATH_ALMATH_TYPES_ALPOSE2D_H_
 #define _LIBALMATH_ALMATH_TYPES_ALPOSE2D_H_
 
+#include <almath/types/alinline.h>
 #include <vector>
 
 namespace AL {
@@ -113,6 +114,16 @@ namespace AL {
       /// </param>
       Pose2D(const std::vector<float>& pFloats);
 
+      /// <summary>
+      /// Create a Pose2D from a buffer of float, without heap allocation.
+      /// Same behaviour as the std::vector constructor.
+      /// </summary>
+      /// <param name="pFloats"> the buffer of pSize float </param>
+      /// <param name="pSize"> the number of float of the buffer </param>
+      Pose2D(
+        const float*       pFloats,
+        const unsigned int pSize);
+
       /// <summary>
       /// Overloading of operator + for Pose2D.
       /// </summary>
@@ -215,6 +226,16 @@ namespace AL {
       bool isNear(const Pose2D& pPos2,
                   const float&  pEpsilon=0.0001f) const;
 
+      /// number of float written by writeTo: x, y and theta
+      static const unsigned int SIZE = 3;
+
+      /// <summary>
+      /// Write the Pose2D to a buffer of SIZE float, without heap
+      /// allocation.
+      /// </summary>
+      /// <param name="pOut"> the buffer of at least SIZE float </param>
+      void writeTo(float* pOut) const;
+
       /// <summary>
       /// Return the Pose2D as a vector of float [x, y, theta].
       /// </summary>
@@ -273,4 +294,9 @@ namespace AL {
 
   } // end namespace math
 } // end namespace AL
+
+#ifdef ALMATH_INLINE_TYPES
+# include <almath/types/alpose2d.hxx>
+#endif
+
 #endif  // _LIBALMATH_ALMATH_TYPES_ALPOSE2D_H_
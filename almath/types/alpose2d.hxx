@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+// Arithmetic of Pose2D. Included by the header when ALMATH_INLINE_TYPES
+// is defined, compiled out-of-line in the almath library otherwise.
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TYPES_ALPOSE2D_HXX_
+#define _LIBALMATH_ALMATH_TYPES_ALPOSE2D_HXX_
+
+#include <almath/types/alpose2d.h>
+#include <almath/types/alarithmetic.h>
+#include <cmath>
+
+namespace AL {
+  namespace Math {
+
+    ALMATH_INLINE Pose2D::Pose2D():x(0.0f), y(0.0f), theta(0.0f) {}
+
+    ALMATH_INLINE Pose2D::Pose2D(float pInit):x(pInit), y(pInit), theta(pInit) {}
+
+    ALMATH_INLINE Pose2D::Pose2D(
+      float pX,
+      float pY,
+      float pTheta):
+      x(pX),
+      y(pY),
+      theta(pTheta) {}
+
+    ALMATH_INLINE Pose2D Pose2D::operator+ (const Pose2D& pPos2) const
+    {
+      Pose2D res;
+      res.x = x + pPos2.x;
+      res.y = y + pPos2.y;
+      res.theta = theta + pPos2.theta;
+      return res;
+    }
+
+    ALMATH_INLINE Pose2D Pose2D::operator- (const Pose2D& pPos2) const
+    {
+      Pose2D res;
+      res.x = x - pPos2.x;
+      res.y = y - pPos2.y;
+      res.theta = theta - pPos2.theta;
+      return res;
+    }
+
+    ALMATH_INLINE Pose2D Pose2D::operator+ () const
+    {
+      Pose2D res;
+      res.x = x;
+      res.y = y;
+      res.theta = theta;
+      return res;
+    }
+
+    ALMATH_INLINE Pose2D Pose2D::operator- () const
+    {
+      Pose2D res;
+      res.x = -x;
+      res.y = -y;
+      res.theta = -theta;
+      return res;
+    }
+
+    ALMATH_INLINE Pose2D Pose2D::operator* (const Pose2D& pPos2) const
+    {
+      Pose2D pOut(*this);
+      Detail::pose2DMultiplyInPlace<float>(pOut, pPos2);
+      return pOut;
+    }
+
+    ALMATH_INLINE Pose2D& Pose2D::operator*= (const Pose2D& pPos2)
+    {
+      Detail::pose2DMultiplyInPlace<float>(*this, pPos2);
+      return *this;
+    }
+
+    ALMATH_INLINE Pose2D& Pose2D::operator+= (const Pose2D& pPos2)
+    {
+      x     += pPos2.x;
+      y     += pPos2.y;
+      theta += pPos2.theta;
+      return *this;
+    }
+
+    ALMATH_INLINE Pose2D& Pose2D::operator-= (const Pose2D& pPos2)
+    {
+      x     -= pPos2.x;
+      y     -= pPos2.y;
+      theta -= pPos2.theta;
+      return *this;
+    }
+
+    ALMATH_INLINE bool Pose2D::operator==(const Pose2D& pPos2) const
+    {
+       if (
+         (x == pPos2.x) &&
+         (y == pPos2.y) &&
+         (theta == pPos2.theta) )
+       {
+        return true;
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+    ALMATH_INLINE bool Pose2D::operator!=(const Pose2D& pPos2) const
+    {
+      return ! (*this==pPos2);
+    }
+
+    ALMATH_INLINE float Pose2D::distanceSquared(const Pose2D& pPos) const
+    {
+      return Math::distanceSquared(*this, pPos);
+    }
+
+    ALMATH_INLINE float Pose2D::distance(const Pose2D& pPos2) const
+    {
+      return Math::distance(*this, pPos2);
+    }
+
+    ALMATH_INLINE float distanceSquared(
+      const Pose2D& pPos1,
+      const Pose2D& pPos2)
+    {
+      return (pPos1.x-pPos2.x)*(pPos1.x-pPos2.x)+(pPos1.y-pPos2.y)*(pPos1.y-pPos2.y);
+    }
+
+    ALMATH_INLINE float distance(
+      const Pose2D& pPos1,
+      const Pose2D& pPos2)
+    {
+      return sqrtf(distanceSquared(pPos1, pPos2));
+    }
+
+    ALMATH_INLINE bool Pose2D::isNear(
+      const Pose2D& pPos2,
+      const float&  pEpsilon) const
+    {
+
+      if (
+        (fabsf(x - pPos2.x) > pEpsilon) ||
+        (fabsf(y - pPos2.y) > pEpsilon) ||
+        (fabsf(theta - pPos2.theta) > pEpsilon))
+      {
+        return false;
+      }
+      else
+      {
+        return true;
+      }
+    }
+
+    ALMATH_INLINE Pose2D Pose2D::inverse() const
+    {
+      return Math::pose2DInverse(*this);
+    }
+
+    ALMATH_INLINE void pose2DInverse(
+      const Pose2D& pIn,
+      Pose2D&       pOut)
+    {
+      Detail::pose2DInvert<float>(pIn, pOut);
+    }
+
+    ALMATH_INLINE Pose2D pose2DInverse(const Pose2D& pIn)
+    {
+      Pose2D pOut;
+      pose2DInverse(pIn, pOut);
+      return pOut;
+    }
+
+  } // end namespace math
+} // end namespace al
+#endif  // _LIBALMATH_ALMATH_TYPES_ALPOSE2D_HXX_
@@ -99,6 +99,16 @@ namespace AL {
       /// </param>
       Position2D(const std::vector<float>& pFloats);
 
+      /// <summary>
+      /// Create a Position2D from a buffer of float, without heap allocation.
+      /// Same behaviour as the std::vector constructor.
+      /// </summary>
+      /// <param name="pFloats"> the buffer of pSize float </param>
+      /// <param name="pSize"> the number of float of the buffer </param>
+      Position2D(
+        const float*       pFloats,
+        const unsigned int pSize);
+
       /// <summary>
       /// Overloading of operator + for Position2D.
       /// </summary>
@@ -244,6 +254,16 @@ namespace AL {
       /// </returns>
       float crossProduct(const Position2D& pPos2) const;
 
+      /// number of float written by writeTo: x and y
+      static const unsigned int SIZE = 2;
+
+      /// <summary>
+      /// Write the Position2D to a buffer of SIZE float, without heap
+      /// allocation.
+      /// </summary>
+      /// <param name="pOut"> the buffer of at least SIZE float </param>
+      void writeTo(float* pOut) const;
+
       /// <summary>
       /// Return the Position2D as a vector of float [x, y].
       /// </summary>
@@ -9,6 +9,7 @@
 #ifndef _LIBALMATH_ALMATH_TYPES_ALPOSITION3D_H_
 #define _LIBALMATH_ALMATH_TYPES_ALPOSITION3D_H_
 
+#include <almath/types/alinline.h>
 #include <vector>
 
 namespace AL {
@@ -112,6 +113,16 @@ namespace AL {
       /// </param>
       Position3D (const std::vector<float>& pFloats);
 
+      /// <summary>
+      /// Create a Position3D from a buffer of float, without heap allocation.
+      /// Same behaviour as the std::vector constructor.
+      /// </summary>
+      /// <param name="pFloats"> the buffer of pSize float </param>
+      /// <param name="pSize"> the number of float of the buffer </param>
+      Position3D(
+        const float*       pFloats,
+        const unsigned int pSize);
+
       /// <summary>
       /// Overloading of operator + for Position3D.
       /// </summary>
@@ -266,6 +277,16 @@ namespace AL {
       /// </returns>
       Position3D crossProduct(const Position3D& pPos2) const;
 
+      /// number of float written by writeTo: x, y and z
+      static const unsigned int SIZE = 3;
+
+      /// <summary>
+      /// Write the Position3D to a buffer of SIZE float, without heap
+      /// allocation.
+      /// </summary>
+      /// <param name="pOut"> the buffer of at least SIZE float </param>
+      void writeTo(float* pOut) const;
+
       /// <summary>
       /// Return the Position3D as a vector of float [x, y, z].
       /// </summary>
@@ -386,4 +407,9 @@ namespace AL {
 
   } // end namespace math
 } // end namespace al
+
+#ifdef ALMATH_INLINE_TYPES
+# include <almath/types/alposition3d.hxx>
+#endif
+
 #endif  // _LIBALMATH_ALMATH_TYPES_ALPOSITION3D_H_
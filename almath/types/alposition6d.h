@@ -148,6 +148,16 @@ namespace AL {
       /// </param>
       Position6D(const std::vector<float>& pFloats);
 
+      /// <summary>
+      /// Create a Position6D from a buffer of float, without heap allocation.
+      /// Same behaviour as the std::vector constructor.
+      /// </summary>
+      /// <param name="pFloats"> the buffer of pSize float </param>
+      /// <param name="pSize"> the number of float of the buffer </param>
+      Position6D(
+        const float*       pFloats,
+        const unsigned int pSize);
+
       /// <summary>
       /// Overloading of operator + for Position6D.
       /// </summary>
@@ -267,6 +277,16 @@ namespace AL {
       /// </returns>
       float norm() const;
 
+      /// number of float written by writeTo: x, y, z, wx, wy and wz
+      static const unsigned int SIZE = 6;
+
+      /// <summary>
+      /// Write the Position6D to a buffer of SIZE float, without heap
+      /// allocation.
+      /// </summary>
+      /// <param name="pOut"> the buffer of at least SIZE float </param>
+      void writeTo(float* pOut) const;
+
       /// <summary>
       /// Return the Position6D as a vector of float [x, y, z, wx, wy, wz].
       /// </summary>
@@ -9,6 +9,7 @@
 #ifndef _LIBALMATH_ALMATH_TYPES_ALQUATERNION_H_
 #define _LIBALMATH_ALMATH_TYPES_ALQUATERNION_H_
 
+#include <almath/types/alinline.h>
 #include <vector>
 
 namespace AL {
@@ -102,6 +103,16 @@ namespace AL {
       /// </param>
       Quaternion(const std::vector<float>& pFloats);
 
+      /// <summary>
+      /// Create a Quaternion from a buffer of float, without heap allocation.
+      /// Same behaviour as the std::vector constructor.
+      /// </summary>
+      /// <param name="pFloats"> the buffer of pSize float </param>
+      /// <param name="pSize"> the number of float of the buffer </param>
+      Quaternion(
+        const float*       pFloats,
+        const unsigned int pSize);
+
       /// <summary>
       /// Overloading of operator *= for Quaternion.
       /// </summary>
@@ -196,6 +207,16 @@ namespace AL {
         const float pAxisY,
         const float pAxisZ);
 
+      /// number of float written by writeTo: w, x, y and z
+      static const unsigned int SIZE = 4;
+
+      /// <summary>
+      /// Write the Quaternion to a buffer of SIZE float, without heap
+      /// allocation.
+      /// </summary>
+      /// <param name="pOut"> the buffer of at least SIZE float </param>
+      void writeTo(float* pOut) const;
+
       /// <summary>
       /// Return the Quaternion as a vector of float [w, x, y, z].
       /// </summary>
@@ -286,6 +307,136 @@ namespace AL {
       float& pAxisY,
       float& pAxisZ);
 
+    /// <summary>
+    /// Spherical linear interpolation between two unit Quaternion, along
+    /// the shortest path: q and -q are the same rotation.
+    ///
+    /// </summary>
+    /// <param name="pQua1"> the unit Quaternion at pAlpha = 0 </param>
+    /// <param name="pQua2"> the unit Quaternion at pAlpha = 1 </param>
+    /// <param name="pAlpha"> the interpolation parameter in [0, 1] </param>
+    /// <returns>
+    /// the interpolated unit Quaternion
+    /// </returns>
+    /// \ingroup Types
+    Quaternion quaternionSlerp(
+      const Quaternion& pQua1,
+      const Quaternion& pQua2,
+      const float       pAlpha);
+
+    /// <summary>
+    /// Normalized linear interpolation between two unit Quaternion, along
+    /// the shortest path.
+    ///
+    /// It is cheaper than quaternionSlerp but its angular velocity is not
+    /// constant: it is meant for blending and for close quaternions.
+    /// </summary>
+    /// <param name="pQua1"> the unit Quaternion at pAlpha = 0 </param>
+    /// <param name="pQua2"> the unit Quaternion at pAlpha = 1 </param>
+    /// <param name="pAlpha"> the interpolation parameter in [0, 1] </param>
+    /// <returns>
+    /// the interpolated unit Quaternion
+    /// </returns>
+    /// \ingroup Types
+    Quaternion quaternionNlerp(
+      const Quaternion& pQua1,
+      const Quaternion& pQua2,
+      const float       pAlpha);
+
+    /// <summary>
+    /// Multiply two arrays of Quaternion element by element:
+    ///
+    /// pOut[i] = pQua1[i]*pQua2[i] for i in [0, pSize[
+    ///
+    /// Several quaternions are processed at once with SIMD instructions
+    /// when available. pOut may be pQua1 or pQua2.
+    /// </summary>
+    /// <param name="pQua1"> the pSize first Quaternion </param>
+    /// <param name="pQua2"> the pSize second Quaternion </param>
+    /// <param name="pSize"> the number of Quaternion </param>
+    /// <param name="pOut"> the pSize resulting Quaternion </param>
+    /// \ingroup Types
+    void quaternionMultiplyBatch(
+      const Quaternion*  pQua1,
+      const Quaternion*  pQua2,
+      const unsigned int pSize,
+      Quaternion*        pOut);
+
+    /// <summary>
+    /// Compute the inverse (the conjugate) of an array of unit Quaternion,
+    /// as quaternionInverse. pOut may be pQua.
+    /// </summary>
+    /// <param name="pQua"> the pSize given Quaternion </param>
+    /// <param name="pSize"> the number of Quaternion </param>
+    /// <param name="pOut"> the pSize resulting Quaternion </param>
+    /// \ingroup Types
+    void quaternionInverseBatch(
+      const Quaternion*  pQua,
+      const unsigned int pSize,
+      Quaternion*        pOut);
+
+    /// <summary>
+    /// Normalize an array of Quaternion. pOut may be pQua.
+    ///
+    /// The inverse norm is computed with the hardware reciprocal square
+    /// root estimate refined by a Newton step, the results match normalize
+    /// within 1e-6. As normalize, a zero Quaternion throws a
+    /// std::runtime_error, pOut is then partially written.
+    /// </summary>
+    /// <param name="pQua"> the pSize given Quaternion </param>
+    /// <param name="pSize"> the number of Quaternion </param>
+    /// <param name="pOut"> the pSize normalized Quaternion </param>
+    /// \ingroup Types
+    void quaternionNormalizeBatch(
+      const Quaternion*  pQua,
+      const unsigned int pSize,
+      Quaternion*        pOut);
+
+    /// <summary>
+    /// Interpolate two arrays of unit Quaternion element by element with
+    /// quaternionSlerp:
+    ///
+    /// pOut[i] = quaternionSlerp(pQua1[i], pQua2[i], pAlpha)
+    ///
+    /// Several quaternions are processed at once with SIMD instructions
+    /// when available. The results match quaternionSlerp within 1e-4.
+    /// pOut may be pQua1 or pQua2.
+    /// </summary>
+    /// <param name="pQua1"> the pSize unit Quaternion at pAlpha = 0 </param>
+    /// <param name="pQua2"> the pSize unit Quaternion at pAlpha = 1 </param>
+    /// <param name="pAlpha"> the interpolation parameter in [0, 1] </param>
+    /// <param name="pSize"> the number of Quaternion </param>
+    /// <param name="pOut"> the pSize interpolated Quaternion </param>
+    /// \ingroup Types
+    void quaternionSlerpBatch(
+      const Quaternion*  pQua1,
+      const Quaternion*  pQua2,
+      const float        pAlpha,
+      const unsigned int pSize,
+      Quaternion*        pOut);
+
+    /// <summary>
+    /// Interpolate two arrays of unit Quaternion element by element with
+    /// quaternionNlerp. pOut may be pQua1 or pQua2.
+    /// </summary>
+    /// <param name="pQua1"> the pSize unit Quaternion at pAlpha = 0 </param>
+    /// <param name="pQua2"> the pSize unit Quaternion at pAlpha = 1 </param>
+    /// <param name="pAlpha"> the interpolation parameter in [0, 1] </param>
+    /// <param name="pSize"> the number of Quaternion </param>
+    /// <param name="pOut"> the pSize interpolated Quaternion </param>
+    /// \ingroup Types
+    void quaternionNlerpBatch(
+      const Quaternion*  pQua1,
+      const Quaternion*  pQua2,
+      const float        pAlpha,
+      const unsigned int pSize,
+      Quaternion*        pOut);
+
   } // end namespace math
 } // end namespace al
+
+#ifdef ALMATH_INLINE_TYPES
+# include <almath/types/alquaternion.hxx>
+#endif
+
 #endif  // _LIBALMATH_ALMATH_TYPES_ALQUATERNION_H_
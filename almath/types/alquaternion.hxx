@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+// Arithmetic of Quaternion. Included by the header when ALMATH_INLINE_TYPES
+// is defined, compiled out-of-line in the almath library otherwise.
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TYPES_ALQUATERNION_HXX_
+#define _LIBALMATH_ALMATH_TYPES_ALQUATERNION_HXX_
+
+#include <almath/types/alquaternion.h>
+#include <cmath>
+#include <stdexcept>
+
+namespace AL {
+  namespace Math {
+
+    ALMATH_INLINE Quaternion::Quaternion() : w(1.0f), x(0.0f), y(0.0f), z(0.0f) {}
+
+    ALMATH_INLINE Quaternion::Quaternion(
+      float pW,
+      float pX,
+      float pY,
+      float pZ):
+      w(pW), x(pX), y(pY), z(pZ) {}
+
+    ALMATH_INLINE Quaternion& Quaternion::operator*= (const Quaternion& pQua2)
+    {
+      float w1 = w;
+      float x1 = x;
+      float y1 = y;
+      float z1 = z;
+      w = w1*pQua2.w - x1*pQua2.x - y1*pQua2.y - z1*pQua2.z;
+      x = w1*pQua2.x + pQua2.w*x1 + y1*pQua2.z - z1*pQua2.y;
+      y = w1*pQua2.y + pQua2.w*y1 + z1*pQua2.x - x1*pQua2.z;
+      z = w1*pQua2.z + pQua2.w*z1 + x1*pQua2.y - y1*pQua2.x;
+      return *this;
+    }
+
+    ALMATH_INLINE Quaternion Quaternion::operator* (const Quaternion& pQua2) const
+    {
+      Quaternion qua;
+      qua.w = w*pQua2.w - x*pQua2.x - y*pQua2.y - z*pQua2.z;
+      qua.x = w*pQua2.x + pQua2.w*x + y*pQua2.z - z*pQua2.y;
+      qua.y = w*pQua2.y + pQua2.w*y + z*pQua2.x - x*pQua2.z;
+      qua.z = w*pQua2.z + pQua2.w*z + x*pQua2.y - y*pQua2.x;
+      return qua;
+    }
+
+    ALMATH_INLINE bool Quaternion::isNear(
+      const Quaternion& pQua2,
+      const float&      pEpsilon) const
+    {
+      if (
+          // |pQua1 - pQua2| < epsilon
+          (
+            (fabsf(w - pQua2.w) < pEpsilon) &&
+            (fabsf(x - pQua2.x) < pEpsilon) &&
+            (fabsf(y - pQua2.y) < pEpsilon) &&
+            (fabsf(z - pQua2.z) < pEpsilon)
+            ) ||
+          (
+            // |pQua1 + pQua2| < epsilon
+            (fabsf(w + pQua2.w) < pEpsilon) &&
+            (fabsf(x + pQua2.x) < pEpsilon) &&
+            (fabsf(y + pQua2.y) < pEpsilon) &&
+            (fabsf(z + pQua2.z) < pEpsilon)
+            )
+          )
+      {
+        return true;
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+    ALMATH_INLINE Quaternion& Quaternion::operator*= (float pVal)
+    {
+      w *= pVal;
+      x *= pVal;
+      y *= pVal;
+      z *= pVal;
+      return *this;
+    }
+
+    ALMATH_INLINE Quaternion& Quaternion::operator/= (float pVal)
+    {
+      if (pVal == 0.0f)
+      {
+        throw std::runtime_error(
+          "ALQuaternion: operator/= Division by zeros.");
+      }
+      *this *= (1.0f/pVal);
+      return *this;
+    }
+
+    ALMATH_INLINE bool Quaternion::operator== (const Quaternion& pQua2) const
+    {
+      if(
+        (w == pQua2.w) &&
+        (x == pQua2.x) &&
+        (y == pQua2.y) &&
+        (z == pQua2.z))
+      {
+        return true;
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+    ALMATH_INLINE bool Quaternion::operator!= (const Quaternion& pQua2) const
+    {
+      return !(*this==pQua2);
+    }
+
+    ALMATH_INLINE float Quaternion::norm() const
+    {
+      return Math::norm(*this);
+    }
+
+    ALMATH_INLINE Quaternion Quaternion::normalize() const
+    {
+      return Math::normalize(*this);
+    }
+
+    ALMATH_INLINE float norm(const Quaternion& p)
+    {
+      return sqrtf( (p.w*p.w) + (p.x*p.x) + (p.y*p.y) + (p.z*p.z) );
+    }
+
+    ALMATH_INLINE Quaternion normalize(const Quaternion& pQua)
+    {
+      Quaternion ret;
+      ret = pQua;
+      float tmpNorm = norm(pQua);
+
+      if (tmpNorm == 0.0f)
+      {
+        throw std::runtime_error(
+          "ALQuaternion: normalize Division by zeros.");
+      }
+
+      ret /= tmpNorm;
+      return ret;
+    }
+
+    ALMATH_INLINE Quaternion Quaternion::inverse() const
+    {
+      return Math::quaternionInverse(*this);
+    }
+
+    ALMATH_INLINE void quaternionInverse(
+      const Quaternion& pQua,
+      Quaternion&       pQuaOut)
+    {
+      pQuaOut.w = pQua.w;
+      pQuaOut.x = -pQua.x;
+      pQuaOut.y = -pQua.y;
+      pQuaOut.z = -pQua.z;
+    }
+
+    ALMATH_INLINE Quaternion quaternionInverse(const Quaternion& pQua)
+    {
+      Quaternion pQuaOut;
+      quaternionInverse(pQua, pQuaOut);
+      return pQuaOut;
+    }
+
+  } // end namespace math
+} // end namespace al
+#endif  // _LIBALMATH_ALMATH_TYPES_ALQUATERNION_HXX_
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TYPES_ALQUATTRANSFORM_H_
+#define _LIBALMATH_ALMATH_TYPES_ALQUATTRANSFORM_H_
+
+#include <almath/types/alquaternion.h>
+#include <almath/types/alposition3d.h>
+#include <almath/types/altransform.h>
+
+namespace AL {
+  namespace Math {
+
+    /// <summary>
+    /// A rigid transform stored as a unit Quaternion and a Position3D.
+    ///
+    /// It holds 7 float instead of the 12 of a Transform, and its
+    /// composition needs fewer multiplications. It is meant to store
+    /// long pose histories and to compose kinematic chains.
+    ///
+    /// The rotation q is expected to be a unit quaternion. Composition
+    /// keeps it normalized up to rounding errors, call normalize()
+    /// after a long chain of products.
+    /// </summary>
+    /// \ingroup Types
+    struct QuatTransform {
+      /// <summary> the rotation </summary>
+      Quaternion q;
+      /// <summary> the translation </summary>
+      Position3D p;
+
+      /// <summary>
+      /// Create an identity QuatTransform.
+      /// </summary>
+      QuatTransform();
+
+      /// <summary>
+      /// Create a QuatTransform from a rotation and a translation.
+      /// </summary>
+      /// <param name="pQua"> the unit Quaternion of the rotation </param>
+      /// <param name="pPos"> the Position3D of the translation </param>
+      QuatTransform(
+        const Quaternion& pQua,
+        const Position3D& pPos);
+
+      /// <summary>
+      /// Create a QuatTransform from a Transform.
+      /// </summary>
+      /// <param name="pT"> the Transform, with an orthonormal rotation </param>
+      explicit QuatTransform(const Transform& pT);
+
+      /// <summary>
+      /// Create a QuatTransform from a buffer of float, without heap
+      /// allocation: w, x, y, z of q then x, y, z of p. If pSize is not
+      /// SIZE, the QuatTransform is identity.
+      /// </summary>
+      /// <param name="pFloats"> the buffer of pSize float </param>
+      /// <param name="pSize"> the number of float of the buffer </param>
+      QuatTransform(
+        const float*       pFloats,
+        const unsigned int pSize);
+
+      /// <summary>
+      /// Overloading of operator *= for QuatTransform.
+      /// </summary>
+      /// <param name="pQT2"> the second QuatTransform </param>
+      QuatTransform& operator*= (const QuatTransform& pQT2);
+
+      /// <summary>
+      /// Overloading of operator * for QuatTransform, same convention
+      /// as Transform::operator*.
+      /// </summary>
+      /// <param name="pQT2"> the second QuatTransform </param>
+      QuatTransform operator* (const QuatTransform& pQT2) const;
+
+      /// <summary>
+      /// Apply the QuatTransform to a Position3D.
+      /// </summary>
+      /// <param name="pPos"> the Position3D to transform </param>
+      Position3D operator* (const Position3D& pPos) const;
+
+      /// <summary>
+      /// Check if the actual QuatTransform is near the one
+      /// given in argument. q and -q are the same rotation.
+      ///
+      /// </summary>
+      /// <param name="pQT2"> the second QuatTransform </param>
+      /// <param name="pEpsilon"> an optionnal epsilon distance - default: 0.0001 </param>
+      /// <returns>
+      /// true if the distance between the two QuatTransform is less than pEpsilon
+      /// </returns>
+      bool isNear(
+        const QuatTransform& pQT2,
+        const float&         pEpsilon=0.0001f) const;
+
+      /// <summary>
+      /// Compute the inverse of the actual QuatTransform.
+      /// </summary>
+      /// <returns>
+      /// the QuatTransform inverse
+      /// </returns>
+      QuatTransform inverse() const;
+
+      /// <summary>
+      /// Return the actual QuatTransform with its rotation normalized.
+      /// </summary>
+      /// <returns>
+      /// the QuatTransform normalized
+      /// </returns>
+      QuatTransform normalize() const;
+
+      /// number of float written by writeTo: w, x, y, z of q then x, y, z of p
+      static const unsigned int SIZE = 7;
+
+      /// <summary>
+      /// Write the QuatTransform to a buffer of SIZE float, without heap
+      /// allocation.
+      /// </summary>
+      /// <param name="pOut"> the buffer of at least SIZE float </param>
+      void writeTo(float* pOut) const;
+
+      /// <summary>
+      /// Convert the actual QuatTransform to a Transform.
+      /// </summary>
+      /// <returns>
+      /// the Transform
+      /// </returns>
+      Transform toTransform() const;
+    };
+
+    /// <summary>
+    /// Return the inverse of the given QuatTransform.
+    /// </summary>
+    /// <param name="pQT"> the given QuatTransform </param>
+    /// <returns>
+    /// the QuatTransform inverse
+    /// </returns>
+    /// \ingroup Types
+    QuatTransform quatTransformInverse(const QuatTransform& pQT);
+
+    /// <summary>
+    /// Convert a Transform to a QuatTransform.
+    /// </summary>
+    /// <param name="pT"> the Transform, with an orthonormal rotation </param>
+    /// <returns>
+    /// the QuatTransform
+    /// </returns>
+    /// \ingroup Types
+    QuatTransform quatTransformFromTransform(const Transform& pT);
+
+    /// <summary>
+    /// Convert a QuatTransform to a Transform.
+    /// </summary>
+    /// <param name="pQT"> the QuatTransform </param>
+    /// <returns>
+    /// the Transform
+    /// </returns>
+    /// \ingroup Types
+    Transform transformFromQuatTransform(const QuatTransform& pQT);
+
+    /// <summary>
+    /// Interpolate between two QuatTransform: the rotation is interpolated
+    /// with quaternionSlerp and the translation linearly.
+    /// </summary>
+    /// <param name="pQT1"> the QuatTransform at pAlpha = 0 </param>
+    /// <param name="pQT2"> the QuatTransform at pAlpha = 1 </param>
+    /// <param name="pAlpha"> the interpolation parameter in [0, 1] </param>
+    /// <returns>
+    /// the interpolated QuatTransform
+    /// </returns>
+    /// \ingroup Types
+    QuatTransform quatTransformInterpolation(
+      const QuatTransform& pQT1,
+      const QuatTransform& pQT2,
+      const float          pAlpha);
+
+  } // end namespace math
+} // end namespace al
+#endif  // _LIBALMATH_ALMATH_TYPES_ALQUATTRANSFORM_H_
@@ -125,6 +125,16 @@ namespace AL {
       /// </param>
       Rotation (const std::vector<float>& pFloats);
 
+      /// <summary>
+      /// Create a Rotation from a buffer of float, without heap allocation.
+      /// Same behaviour as the std::vector constructor.
+      /// </summary>
+      /// <param name="pFloats"> the buffer of pSize float </param>
+      /// <param name="pSize"> the number of float of the buffer </param>
+      Rotation(
+        const float*       pFloats,
+        const unsigned int pSize);
+
       /// <summary>
       /// Overloading of operator *= for Rotation.
       /// </summary>
@@ -267,6 +277,16 @@ namespace AL {
         const float& pWY,
         const float& pWZ);
 
+      /// number of float written by writeTo: the rows of the rotation
+      static const unsigned int SIZE = 9;
+
+      /// <summary>
+      /// Write the Rotation to a buffer of SIZE float, without heap
+      /// allocation.
+      /// </summary>
+      /// <param name="pOut"> the buffer of at least SIZE float </param>
+      void writeTo(float* pOut) const;
+
       /// <summary>
       /// Return the Rotation as a vector of float:
       ///
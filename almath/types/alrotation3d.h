@@ -110,6 +110,16 @@ namespace AL {
       /// </param>
       Rotation3D (const std::vector<float>& pFloats);
 
+      /// <summary>
+      /// Create a Rotation3D from a buffer of float, without heap allocation.
+      /// Same behaviour as the std::vector constructor.
+      /// </summary>
+      /// <param name="pFloats"> the buffer of pSize float </param>
+      /// <param name="pSize"> the number of float of the buffer </param>
+      Rotation3D(
+        const float*       pFloats,
+        const unsigned int pSize);
+
       /// <summary>
       /// Overloading of operator + for Rotation3D.
       /// </summary>
@@ -194,6 +204,16 @@ namespace AL {
       /// </returns>
       float norm() const;
 
+      /// number of float written by writeTo: wx, wy and wz
+      static const unsigned int SIZE = 3;
+
+      /// <summary>
+      /// Write the Rotation3D to a buffer of SIZE float, without heap
+      /// allocation.
+      /// </summary>
+      /// <param name="pOut"> the buffer of at least SIZE float </param>
+      void writeTo(float* pOut) const;
+
       /// <summary>
       /// Return the Rotation3D as a vector of float [wx, wy, wz].
       /// </summary>
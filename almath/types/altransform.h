@@ -9,6 +9,7 @@
 #ifndef _LIBALMATH_ALMATH_TYPES_ALTRANSFORM_H_
 #define _LIBALMATH_ALMATH_TYPES_ALTRANSFORM_H_
 
+#include <almath/types/alinline.h>
 #include <vector>
 
 namespace AL {
@@ -70,6 +71,16 @@ namespace AL {
        */
       explicit Transform(const std::vector<float>& pFloats);
 
+      /// <summary>
+      /// Create a Transform from a buffer of float, without heap allocation.
+      /// Same behaviour as the std::vector constructor.
+      /// </summary>
+      /// <param name="pFloats"> the buffer of pSize float </param>
+      /// <param name="pSize"> the number of float of the buffer </param>
+      Transform(
+        const float*       pFloats,
+        const unsigned int pSize);
+
       /// <summary>
       /// Create a Transform initialized with explicit value for translation
       /// part. Rotation part is set to identity.
@@ -337,6 +348,17 @@ namespace AL {
       /// </returns>
       float distance(const Transform& pT2) const;
 
+      /// number of float written by writeTo: the three rows of the
+      /// transform, without the last row [0, 0, 0, 1] of toVector
+      static const unsigned int SIZE = 12;
+
+      /// <summary>
+      /// Write the Transform to a buffer of SIZE float, without heap
+      /// allocation.
+      /// </summary>
+      /// <param name="pOut"> the buffer of at least SIZE float </param>
+      void writeTo(float* pOut) const;
+
       /// <summary>
       /// Return the Transform as a vector of float:
       ///
@@ -363,6 +385,81 @@ namespace AL {
       const Transform& pT,
       Transform&       pTOut);
 
+    /// <summary>
+    /// pT = pT*transformFromRotX(pRotX), given the cosine and sine of pRotX.
+    ///
+    /// Only the two columns changed by the rotation are computed: 12
+    /// multiplications instead of the 36 of the dense product. This is
+    /// the product of a revolute joint around x in a kinematic chain.
+    /// </summary>
+    /// <param name="pT"> the modified Transform </param>
+    /// <param name="pCos"> the cosine of the rotation angle </param>
+    /// <param name="pSin"> the sine of the rotation angle </param>
+    /// \ingroup Types
+    void transformMultiplyByRotX(
+      Transform&  pT,
+      const float pCos,
+      const float pSin);
+
+    /// <summary>
+    /// pT = pT*transformFromRotY(pRotY), given the cosine and sine of pRotY.
+    ///
+    /// Only the two columns changed by the rotation are computed.
+    /// </summary>
+    /// <param name="pT"> the modified Transform </param>
+    /// <param name="pCos"> the cosine of the rotation angle </param>
+    /// <param name="pSin"> the sine of the rotation angle </param>
+    /// \ingroup Types
+    void transformMultiplyByRotY(
+      Transform&  pT,
+      const float pCos,
+      const float pSin);
+
+    /// <summary>
+    /// pT = pT*transformFromRotZ(pRotZ), given the cosine and sine of pRotZ.
+    ///
+    /// Only the two columns changed by the rotation are computed.
+    /// </summary>
+    /// <param name="pT"> the modified Transform </param>
+    /// <param name="pCos"> the cosine of the rotation angle </param>
+    /// <param name="pSin"> the sine of the rotation angle </param>
+    /// \ingroup Types
+    void transformMultiplyByRotZ(
+      Transform&  pT,
+      const float pCos,
+      const float pSin);
+
+    /// <summary>
+    /// pT = pT*Transform(pX, pY, pZ), the product by a pure translation.
+    ///
+    /// Only the translation of pT changes: 9 multiplications. This is the
+    /// product of a prismatic joint or of a fixed offset in a kinematic
+    /// chain.
+    /// </summary>
+    /// <param name="pT"> the modified Transform </param>
+    /// <param name="pX"> the translation along x </param>
+    /// <param name="pY"> the translation along y </param>
+    /// <param name="pZ"> the translation along z </param>
+    /// \ingroup Types
+    void transformMultiplyByTranslation(
+      Transform&  pT,
+      const float pX,
+      const float pY,
+      const float pZ);
+
+    /// <summary>
+    /// pT = pT*pRot, where only the rotation part of pRot is used: its
+    /// translation is taken as zero.
+    ///
+    /// The translation of pT does not change: 27 multiplications.
+    /// </summary>
+    /// <param name="pT"> the modified Transform </param>
+    /// <param name="pRot"> the Transform of the rotation </param>
+    /// \ingroup Types
+    void transformMultiplyByRotation(
+      Transform&       pT,
+      const Transform& pRot);
+
     /// <summary>
     /// Compute the norm translation part of the actual Transform:
     ///
@@ -705,4 +802,9 @@ namespace AL {
 
   } // end namespace Math
 } // end namespace AL
+
+#ifdef ALMATH_INLINE_TYPES
+# include <almath/types/altransform.hxx>
+#endif
+
 #endif  // _LIBALMATH_ALMATH_TYPES_ALTRANSFORM_H_
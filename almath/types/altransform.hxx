@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+// Arithmetic of Transform. Included by the header when ALMATH_INLINE_TYPES
+// is defined, compiled out-of-line in the almath library otherwise.
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TYPES_ALTRANSFORM_HXX_
+#define _LIBALMATH_ALMATH_TYPES_ALTRANSFORM_HXX_
+
+#include <almath/types/altransform.h>
+#include <almath/types/alarithmetic.h>
+#include <cmath>
+
+namespace AL {
+  namespace Math {
+
+    ALMATH_INLINE Transform::Transform():
+        r1_c1(1.0f), r1_c2(0.0f), r1_c3(0.0f), r1_c4(0.0f),
+        r2_c1(0.0f), r2_c2(1.0f), r2_c3(0.0f), r2_c4(0.0f),
+        r3_c1(0.0f), r3_c2(0.0f), r3_c3(1.0f), r3_c4(0.0f) {}
+
+    ALMATH_INLINE Transform::Transform(
+      const float& pPosX,
+      const float& pPosY,
+      const float& pPosZ)
+    {
+      r1_c1 = 1.0f;
+      r1_c2 = 0.0f;
+      r1_c3 = 0.0f;
+
+      r2_c1 = 0.0f;
+      r2_c2 = 1.0f;
+      r2_c3 = 0.0f;
+
+      r3_c1 = 0.0f;
+      r3_c2 = 0.0f;
+      r3_c3 = 1.0f;
+
+      r1_c4 = pPosX;
+      r2_c4 = pPosY;
+      r3_c4 = pPosZ;
+    }
+
+    ALMATH_INLINE Transform& Transform::operator*= (const Transform& pT2)
+    {
+      Detail::transformMultiplyInPlace<float>(*this, pT2);
+      return *this;
+    }
+
+    ALMATH_INLINE Transform Transform::operator* (const Transform& pT2) const
+    {
+      Transform t(*this);
+      Detail::transformMultiplyInPlace<float>(t, pT2);
+      return t;
+    }
+
+    ALMATH_INLINE bool Transform::operator==(const Transform& pT2) const
+    {
+      if (
+        (r1_c1 == pT2.r1_c1) &&
+        (r1_c2 == pT2.r1_c2) &&
+        (r1_c3 == pT2.r1_c3) &&
+        (r1_c4 == pT2.r1_c4) &&
+        (r2_c1 == pT2.r2_c1) &&
+        (r2_c2 == pT2.r2_c2) &&
+        (r2_c3 == pT2.r2_c3) &&
+        (r2_c4 == pT2.r2_c4) &&
+        (r3_c1 == pT2.r3_c1) &&
+        (r3_c2 == pT2.r3_c2) &&
+        (r3_c3 == pT2.r3_c3) &&
+        (r3_c4 == pT2.r3_c4))
+      {
+        return true;
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+    ALMATH_INLINE bool Transform::operator!=(const Transform& pT2) const
+    {
+      return !(*this==pT2);
+    }
+
+    ALMATH_INLINE bool Transform::isNear(
+      const Transform& pT2,
+      const float&     pEpsilon)const
+    {
+
+      if (
+        (fabsf(r1_c1 - pT2.r1_c1) > pEpsilon) ||
+        (fabsf(r1_c2 - pT2.r1_c2) > pEpsilon) ||
+        (fabsf(r1_c3 - pT2.r1_c3) > pEpsilon) ||
+        (fabsf(r2_c1 - pT2.r2_c1) > pEpsilon) ||
+        (fabsf(r2_c2 - pT2.r2_c2) > pEpsilon) ||
+        (fabsf(r2_c3 - pT2.r2_c3) > pEpsilon) ||
+        (fabsf(r3_c1 - pT2.r3_c1) > pEpsilon) ||
+        (fabsf(r3_c2 - pT2.r3_c2) > pEpsilon) ||
+        (fabsf(r3_c3 - pT2.r3_c3) > pEpsilon) ||
+        (fabsf(r1_c4 - pT2.r1_c4) > pEpsilon) ||
+        (fabsf(r2_c4 - pT2.r2_c4) > pEpsilon) ||
+        (fabsf(r3_c4 - pT2.r3_c4) > pEpsilon))
+      {
+        return false;
+      }
+      else
+      {
+        return true;
+      }
+    }
+
+    ALMATH_INLINE void transformMultiplyByRotX(
+      Transform&  pT,
+      const float pCos,
+      const float pSin)
+    {
+      // column 2 = c*c2 + s*c3, column 3 = c*c3 - s*c2
+      float c2 = pT.r1_c2;
+      pT.r1_c2 = pCos*c2 + pSin*pT.r1_c3;
+      pT.r1_c3 = pCos*pT.r1_c3 - pSin*c2;
+      c2 = pT.r2_c2;
+      pT.r2_c2 = pCos*c2 + pSin*pT.r2_c3;
+      pT.r2_c3 = pCos*pT.r2_c3 - pSin*c2;
+      c2 = pT.r3_c2;
+      pT.r3_c2 = pCos*c2 + pSin*pT.r3_c3;
+      pT.r3_c3 = pCos*pT.r3_c3 - pSin*c2;
+    }
+
+    ALMATH_INLINE void transformMultiplyByRotY(
+      Transform&  pT,
+      const float pCos,
+      const float pSin)
+    {
+      // column 1 = c*c1 - s*c3, column 3 = c*c3 + s*c1
+      float c1 = pT.r1_c1;
+      pT.r1_c1 = pCos*c1 - pSin*pT.r1_c3;
+      pT.r1_c3 = pCos*pT.r1_c3 + pSin*c1;
+      c1 = pT.r2_c1;
+      pT.r2_c1 = pCos*c1 - pSin*pT.r2_c3;
+      pT.r2_c3 = pCos*pT.r2_c3 + pSin*c1;
+      c1 = pT.r3_c1;
+      pT.r3_c1 = pCos*c1 - pSin*pT.r3_c3;
+      pT.r3_c3 = pCos*pT.r3_c3 + pSin*c1;
+    }
+
+    ALMATH_INLINE void transformMultiplyByRotZ(
+      Transform&  pT,
+      const float pCos,
+      const float pSin)
+    {
+      // column 1 = c*c1 + s*c2, column 2 = c*c2 - s*c1
+      float c1 = pT.r1_c1;
+      pT.r1_c1 = pCos*c1 + pSin*pT.r1_c2;
+      pT.r1_c2 = pCos*pT.r1_c2 - pSin*c1;
+      c1 = pT.r2_c1;
+      pT.r2_c1 = pCos*c1 + pSin*pT.r2_c2;
+      pT.r2_c2 = pCos*pT.r2_c2 - pSin*c1;
+      c1 = pT.r3_c1;
+      pT.r3_c1 = pCos*c1 + pSin*pT.r3_c2;
+      pT.r3_c2 = pCos*pT.r3_c2 - pSin*c1;
+    }
+
+    ALMATH_INLINE void transformMultiplyByTranslation(
+      Transform&  pT,
+      const float pX,
+      const float pY,
+      const float pZ)
+    {
+      pT.r1_c4 += pT.r1_c1*pX + pT.r1_c2*pY + pT.r1_c3*pZ;
+      pT.r2_c4 += pT.r2_c1*pX + pT.r2_c2*pY + pT.r2_c3*pZ;
+      pT.r3_c4 += pT.r3_c1*pX + pT.r3_c2*pY + pT.r3_c3*pZ;
+    }
+
+    ALMATH_INLINE void transformMultiplyByRotation(
+      Transform&       pT,
+      const Transform& pRot)
+    {
+      float c1 = pT.r1_c1;
+      float c2 = pT.r1_c2;
+      float c3 = pT.r1_c3;
+      pT.r1_c1 = (c1 * pRot.r1_c1) + (c2 * pRot.r2_c1) + (c3 * pRot.r3_c1);
+      pT.r1_c2 = (c1 * pRot.r1_c2) + (c2 * pRot.r2_c2) + (c3 * pRot.r3_c2);
+      pT.r1_c3 = (c1 * pRot.r1_c3) + (c2 * pRot.r2_c3) + (c3 * pRot.r3_c3);
+      c1 = pT.r2_c1;
+      c2 = pT.r2_c2;
+      c3 = pT.r2_c3;
+      pT.r2_c1 = (c1 * pRot.r1_c1) + (c2 * pRot.r2_c1) + (c3 * pRot.r3_c1);
+      pT.r2_c2 = (c1 * pRot.r1_c2) + (c2 * pRot.r2_c2) + (c3 * pRot.r3_c2);
+      pT.r2_c3 = (c1 * pRot.r1_c3) + (c2 * pRot.r2_c3) + (c3 * pRot.r3_c3);
+      c1 = pT.r3_c1;
+      c2 = pT.r3_c2;
+      c3 = pT.r3_c3;
+      pT.r3_c1 = (c1 * pRot.r1_c1) + (c2 * pRot.r2_c1) + (c3 * pRot.r3_c1);
+      pT.r3_c2 = (c1 * pRot.r1_c2) + (c2 * pRot.r2_c2) + (c3 * pRot.r3_c2);
+      pT.r3_c3 = (c1 * pRot.r1_c3) + (c2 * pRot.r2_c3) + (c3 * pRot.r3_c3);
+    }
+
+    ALMATH_INLINE Transform Transform::inverse() const
+    {
+      return Math::transformInverse(*this);
+    }
+
+    ALMATH_INLINE void transformInverse(
+      const Transform& pT,
+      Transform&       pTOut)
+    {
+      Detail::transformInvert(pT, pTOut);
+    }
+
+    ALMATH_INLINE Transform transformInverse(const Transform& pT)
+    {
+      Transform pTOut;
+      transformInverse(pT, pTOut);
+      return pTOut;
+    }
+
+    ALMATH_INLINE void transformInvertInPlace(Transform& pT)
+    {
+      float tmp0;
+      tmp0 = pT.r1_c2;
+      pT.r1_c2 = pT.r2_c1;
+      pT.r2_c1 = tmp0;
+
+      tmp0 = pT.r1_c3;
+      pT.r1_c3 = pT.r3_c1;
+      pT.r3_c1 = tmp0;
+
+      tmp0 = pT.r2_c3;
+      pT.r2_c3 = pT.r3_c2;
+      pT.r3_c2 = tmp0;
+
+      tmp0 =       -(pT.r1_c1 * pT.r1_c4 + pT.r1_c2 * pT.r2_c4 + pT.r1_c3 * pT.r3_c4);
+      float tmp1 = -(pT.r2_c1 * pT.r1_c4 + pT.r2_c2 * pT.r2_c4 + pT.r2_c3 * pT.r3_c4);
+      pT.r3_c4 =   -(pT.r3_c1 * pT.r1_c4 + pT.r3_c2 * pT.r2_c4 + pT.r3_c3 * pT.r3_c4);
+      pT.r2_c4 = tmp1;
+      pT.r1_c4 = tmp0;
+    }
+
+  } // end namespace math
+} // end namespace al
+#endif  // _LIBALMATH_ALMATH_TYPES_ALTRANSFORM_HXX_
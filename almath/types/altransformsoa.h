@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TYPES_ALTRANSFORMSOA_H_
+#define _LIBALMATH_ALMATH_TYPES_ALTRANSFORMSOA_H_
+
+#include <almath/types/altransform.h>
+#include <vector>
+
+namespace AL {
+  namespace Math {
+
+    /// <summary>
+    /// A set of Transform stored as a structure of arrays.
+    ///
+    /// Each coefficient of the Transform has its own contiguous array,
+    /// so that batch operations can process several Transform at once
+    /// with SIMD instructions.
+    /// </summary>
+    /// \ingroup Types
+    struct TransformSoA {
+
+      /** \cond PRIVATE */
+      std::vector<float> r1_c1, r1_c2, r1_c3, r1_c4;
+      std::vector<float> r2_c1, r2_c2, r2_c3, r2_c4;
+      std::vector<float> r3_c1, r3_c2, r3_c3, r3_c4;
+      /** \endcond */
+
+      /// <summary>
+      /// Create an empty TransformSoA.
+      /// </summary>
+      TransformSoA();
+
+      /// <summary>
+      /// Create a TransformSoA of pSize Transform initialized to identity.
+      /// </summary>
+      /// <param name="pSize"> the number of Transform </param>
+      explicit TransformSoA(const unsigned int pSize);
+
+      /// <summary>
+      /// Return the number of Transform.
+      /// </summary>
+      unsigned int size() const;
+
+      /// <summary>
+      /// Change the number of Transform. The added Transform are
+      /// initialized to identity.
+      /// </summary>
+      /// <param name="pSize"> the new number of Transform </param>
+      void resize(const unsigned int pSize);
+
+      /// <summary>
+      /// Copy a Transform at the given index.
+      /// </summary>
+      /// <param name="pIndex"> the index, less than size() </param>
+      /// <param name="pT"> the Transform to copy </param>
+      void set(
+        const unsigned int pIndex,
+        const Transform&   pT);
+
+      /// <summary>
+      /// Return the Transform at the given index.
+      /// </summary>
+      /// <param name="pIndex"> the index, less than size() </param>
+      Transform get(const unsigned int pIndex) const;
+    };
+
+    /// <summary>
+    /// Multiply two sets of Transform element by element:
+    ///
+    /// pOut[i] = pA[i]*pB[i]
+    ///
+    /// pOut is resized to the size of pA, and may be pA or pB.
+    /// </summary>
+    /// <param name="pA"> the first TransformSoA </param>
+    /// <param name="pB"> the second TransformSoA, same size as pA </param>
+    /// <param name="pOut"> the result </param>
+    /// \ingroup Types
+    void transformMultiplyBatch(
+      const TransformSoA& pA,
+      const TransformSoA& pB,
+      TransformSoA&       pOut);
+
+  } // end namespace Math
+} // end namespace AL
+#endif  // _LIBALMATH_ALMATH_TYPES_ALTRANSFORMSOA_H_
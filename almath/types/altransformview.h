@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TYPES_ALTRANSFORMVIEW_H_
+#define _LIBALMATH_ALMATH_TYPES_ALTRANSFORMVIEW_H_
+
+#include <almath/types/alinline.h>
+#include <almath/types/alposition3d.h>
+#include <almath/types/altransform.h>
+
+namespace AL {
+  namespace Math {
+
+    /// <summary>
+    /// A Position3D stored in a buffer owned by the caller.
+    ///
+    /// The buffer holds x, y and z, as written by Position3D::writeTo.
+    /// The view does not own it: the buffer must outlive the view.
+    ///
+    /// Views alias their buffer, as references do: a copy constructed
+    /// view points to the same buffer, and assigning to a view writes the
+    /// values in its buffer:
+    ///
+    /// pView = pT*pView;
+    ///
+    /// transforms the point in place.
+    /// </summary>
+    /// \ingroup Types
+    struct Position3DView {
+      /// <summary> the buffer of Position3D::SIZE float </summary>
+      float* data;
+
+      /// <summary>
+      /// Create a Position3DView on a buffer.
+      /// </summary>
+      /// <param name="pData"> the buffer of Position3D::SIZE float </param>
+      explicit Position3DView(float* pData);
+
+      /// <summary>
+      /// Create a Position3DView on the buffer of another view: both views
+      /// alias the same buffer.
+      /// </summary>
+      /// <param name="pView"> the Position3DView to alias </param>
+      Position3DView(const Position3DView& pView);
+
+      /// <summary>
+      /// Write a Position3D in the buffer of the view.
+      /// </summary>
+      /// <param name="pPos"> the Position3D to write </param>
+      Position3DView& operator= (const Position3D& pPos);
+
+      /// <summary>
+      /// Copy the values of another view in the buffer of the view.
+      /// </summary>
+      /// <param name="pView"> the Position3DView to read </param>
+      Position3DView& operator= (const Position3DView& pView);
+
+      /// <summary>
+      /// Read the Position3D of the buffer.
+      /// </summary>
+      operator Position3D() const;
+
+      /// <summary>
+      /// Overloading of operator += for Position3DView.
+      /// </summary>
+      /// <param name="pPos2"> the Position3D to add </param>
+      Position3DView& operator+= (const Position3D& pPos2);
+
+      /// <summary>
+      /// Overloading of operator -= for Position3DView.
+      /// </summary>
+      /// <param name="pPos2"> the Position3D to subtract </param>
+      Position3DView& operator-= (const Position3D& pPos2);
+
+      /// <summary>
+      /// Overloading of operator *= for Position3DView.
+      /// </summary>
+      /// <param name="pVal"> the float factor </param>
+      Position3DView& operator*= (const float pVal);
+    };
+
+    /// <summary>
+    /// A Transform stored in a buffer owned by the caller.
+    ///
+    /// The buffer holds the 12 float of the three first rows of the
+    /// Transform, row by row, as written by Transform::writeTo.
+    /// The view does not own it: the buffer must outlive the view.
+    ///
+    /// Views alias their buffer, as references do: a copy constructed
+    /// view points to the same buffer, and assigning to a view writes the
+    /// values in its buffer.
+    /// </summary>
+    /// \ingroup Types
+    struct TransformView {
+      /// <summary> the buffer of Transform::SIZE float </summary>
+      float* data;
+
+      /// <summary>
+      /// Create a TransformView on a buffer.
+      /// </summary>
+      /// <param name="pData"> the buffer of Transform::SIZE float </param>
+      explicit TransformView(float* pData);
+
+      /// <summary>
+      /// Create a TransformView on the buffer of another view: both views
+      /// alias the same buffer.
+      /// </summary>
+      /// <param name="pView"> the TransformView to alias </param>
+      TransformView(const TransformView& pView);
+
+      /// <summary>
+      /// Write a Transform in the buffer of the view.
+      /// </summary>
+      /// <param name="pT"> the Transform to write </param>
+      TransformView& operator= (const Transform& pT);
+
+      /// <summary>
+      /// Copy the values of another view in the buffer of the view.
+      /// </summary>
+      /// <param name="pView"> the TransformView to read </param>
+      TransformView& operator= (const TransformView& pView);
+
+      /// <summary>
+      /// Read the Transform of the buffer.
+      /// </summary>
+      operator Transform() const;
+
+      /// <summary>
+      /// Overloading of operator *= for TransformView: the buffer is
+      /// multiplied in place.
+      /// </summary>
+      /// <param name="pT2"> the second Transform </param>
+      TransformView& operator*= (const Transform& pT2);
+
+      /// <summary>
+      /// Overloading of operator * for TransformView.
+      /// </summary>
+      /// <param name="pT2"> the second Transform </param>
+      Transform operator* (const Transform& pT2) const;
+
+      /// <summary>
+      /// Overloading of operator * for TransformView and Position3D.
+      /// </summary>
+      /// <param name="pPos"> the Position3D to transform </param>
+      Position3D operator* (const Position3D& pPos) const;
+
+      /// <summary>
+      /// Overloading of operator * for TransformView and Position3DView.
+      /// </summary>
+      /// <param name="pPos"> the Position3DView to transform </param>
+      Position3D operator* (const Position3DView& pPos) const;
+
+      /// <summary>
+      /// Compute the inverse of the Transform of the buffer.
+      /// </summary>
+      /// <returns>
+      /// the Transform inverse
+      /// </returns>
+      Transform inverse() const;
+    };
+
+    /// <summary>
+    /// Overloading of operator * for Transform and Position3DView, as
+    /// operator*(Transform, Position3D) of altransformhelpers.h.
+    /// </summary>
+    /// <param name="pT"> the Transform </param>
+    /// <param name="pPos"> the Position3DView to transform </param>
+    /// \ingroup Types
+    Position3D operator* (
+      const Transform&      pT,
+      const Position3DView& pPos);
+
+    /// <summary>
+    /// A set of Position3D stored in a buffer owned by the caller.
+    ///
+    /// The i-th Position3D starts at data + i*stride: the stride is
+    /// Position3D::SIZE for a packed buffer, and larger when the points
+    /// are interleaved with other data.
+    /// </summary>
+    /// \ingroup Types
+    struct Position3DArrayView {
+      /// <summary> the buffer </summary>
+      float* data;
+      /// <summary> the number of Position3D </summary>
+      unsigned int size;
+      /// <summary> the number of float between two Position3D </summary>
+      unsigned int stride;
+
+      /// <summary>
+      /// Create a Position3DArrayView on a buffer.
+      /// </summary>
+      /// <param name="pData"> the buffer </param>
+      /// <param name="pSize"> the number of Position3D </param>
+      /// <param name="pStride">
+      /// the number of float between two Position3D, at least Position3D::SIZE
+      /// </param>
+      Position3DArrayView(
+        float*             pData,
+        const unsigned int pSize,
+        const unsigned int pStride = Position3D::SIZE);
+
+      /// <summary>
+      /// Return the view of the Position3D at the given index.
+      /// </summary>
+      /// <param name="pIndex"> the index, less than size </param>
+      Position3DView operator[] (const unsigned int pIndex) const;
+    };
+
+    /// <summary>
+    /// A set of Transform stored in a buffer owned by the caller.
+    ///
+    /// The i-th Transform starts at data + i*stride: the stride is
+    /// Transform::SIZE for a packed buffer, and larger when the transforms
+    /// are interleaved with other data.
+    /// </summary>
+    /// \ingroup Types
+    struct TransformArrayView {
+      /// <summary> the buffer </summary>
+      float* data;
+      /// <summary> the number of Transform </summary>
+      unsigned int size;
+      /// <summary> the number of float between two Transform </summary>
+      unsigned int stride;
+
+      /// <summary>
+      /// Create a TransformArrayView on a buffer.
+      /// </summary>
+      /// <param name="pData"> the buffer </param>
+      /// <param name="pSize"> the number of Transform </param>
+      /// <param name="pStride">
+      /// the number of float between two Transform, at least Transform::SIZE
+      /// </param>
+      TransformArrayView(
+        float*             pData,
+        const unsigned int pSize,
+        const unsigned int pStride = Transform::SIZE);
+
+      /// <summary>
+      /// Return the view of the Transform at the given index.
+      /// </summary>
+      /// <param name="pIndex"> the index, less than size </param>
+      TransformView operator[] (const unsigned int pIndex) const;
+    };
+
+  } // end namespace Math
+} // end namespace AL
+
+#ifdef ALMATH_INLINE_TYPES
+# include <almath/types/altransformview.hxx>
+#endif
+
+#endif  // _LIBALMATH_ALMATH_TYPES_ALTRANSFORMVIEW_H_
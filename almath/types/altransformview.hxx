@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+// Arithmetic of Position3DView and TransformView. Included by the header
+// when ALMATH_INLINE_TYPES is defined, compiled out-of-line in the almath
+// library otherwise.
+
+#pragma once
+#ifndef _LIBALMATH_ALMATH_TYPES_ALTRANSFORMVIEW_HXX_
+#define _LIBALMATH_ALMATH_TYPES_ALTRANSFORMVIEW_HXX_
+
+#include <almath/types/altransformview.h>
+
+namespace AL {
+  namespace Math {
+
+    ALMATH_INLINE Position3DView::Position3DView(float* pData):
+      data(pData) {}
+
+    ALMATH_INLINE Position3DView::Position3DView(const Position3DView& pView):
+      data(pView.data) {}
+
+    ALMATH_INLINE Position3DView& Position3DView::operator= (
+      const Position3D& pPos)
+    {
+      data[0] = pPos.x;
+      data[1] = pPos.y;
+      data[2] = pPos.z;
+      return *this;
+    }
+
+    ALMATH_INLINE Position3DView& Position3DView::operator= (
+      const Position3DView& pView)
+    {
+      return *this = static_cast<Position3D>(pView);
+    }
+
+    ALMATH_INLINE Position3DView::operator Position3D() const
+    {
+      return Position3D(data[0], data[1], data[2]);
+    }
+
+    ALMATH_INLINE Position3DView& Position3DView::operator+= (
+      const Position3D& pPos2)
+    {
+      data[0] += pPos2.x;
+      data[1] += pPos2.y;
+      data[2] += pPos2.z;
+      return *this;
+    }
+
+    ALMATH_INLINE Position3DView& Position3DView::operator-= (
+      const Position3D& pPos2)
+    {
+      data[0] -= pPos2.x;
+      data[1] -= pPos2.y;
+      data[2] -= pPos2.z;
+      return *this;
+    }
+
+    ALMATH_INLINE Position3DView& Position3DView::operator*= (
+      const float pVal)
+    {
+      data[0] *= pVal;
+      data[1] *= pVal;
+      data[2] *= pVal;
+      return *this;
+    }
+
+    ALMATH_INLINE TransformView::TransformView(float* pData):
+      data(pData) {}
+
+    ALMATH_INLINE TransformView::TransformView(const TransformView& pView):
+      data(pView.data) {}
+
+    ALMATH_INLINE TransformView& TransformView::operator= (const Transform& pT)
+    {
+      data[0]  = pT.r1_c1;
+      data[1]  = pT.r1_c2;
+      data[2]  = pT.r1_c3;
+      data[3]  = pT.r1_c4;
+      data[4]  = pT.r2_c1;
+      data[5]  = pT.r2_c2;
+      data[6]  = pT.r2_c3;
+      data[7]  = pT.r2_c4;
+      data[8]  = pT.r3_c1;
+      data[9]  = pT.r3_c2;
+      data[10] = pT.r3_c3;
+      data[11] = pT.r3_c4;
+      return *this;
+    }
+
+    ALMATH_INLINE TransformView& TransformView::operator= (
+      const TransformView& pView)
+    {
+      return *this = static_cast<Transform>(pView);
+    }
+
+    ALMATH_INLINE TransformView::operator Transform() const
+    {
+      Transform tOut;
+      tOut.r1_c1 = data[0];
+      tOut.r1_c2 = data[1];
+      tOut.r1_c3 = data[2];
+      tOut.r1_c4 = data[3];
+      tOut.r2_c1 = data[4];
+      tOut.r2_c2 = data[5];
+      tOut.r2_c3 = data[6];
+      tOut.r2_c4 = data[7];
+      tOut.r3_c1 = data[8];
+      tOut.r3_c2 = data[9];
+      tOut.r3_c3 = data[10];
+      tOut.r3_c4 = data[11];
+      return tOut;
+    }
+
+    ALMATH_INLINE TransformView& TransformView::operator*= (const Transform& pT2)
+    {
+      // same computation as Transform::operator*=, one row at a time
+      for (unsigned int r = 0; r < 12; r += 4)
+      {
+        const float c1 = data[r];
+        const float c2 = data[r + 1];
+        const float c3 = data[r + 2];
+        data[r]     = (c1 * pT2.r1_c1) + (c2 * pT2.r2_c1) + (c3 * pT2.r3_c1);
+        data[r + 1] = (c1 * pT2.r1_c2) + (c2 * pT2.r2_c2) + (c3 * pT2.r3_c2);
+        data[r + 2] = (c1 * pT2.r1_c3) + (c2 * pT2.r2_c3) + (c3 * pT2.r3_c3);
+        data[r + 3] = (c1 * pT2.r1_c4) + (c2 * pT2.r2_c4) + (c3 * pT2.r3_c4)
+            + data[r + 3];
+      }
+      return *this;
+    }
+
+    ALMATH_INLINE Transform TransformView::operator* (const Transform& pT2) const
+    {
+      Transform tOut = *this;
+      tOut *= pT2;
+      return tOut;
+    }
+
+    ALMATH_INLINE Position3D TransformView::operator* (const Position3D& pPos) const
+    {
+      return Position3D(
+        data[0]*pPos.x + data[1]*pPos.y + data[2]*pPos.z + data[3],
+        data[4]*pPos.x + data[5]*pPos.y + data[6]*pPos.z + data[7],
+        data[8]*pPos.x + data[9]*pPos.y + data[10]*pPos.z + data[11]);
+    }
+
+    ALMATH_INLINE Position3D TransformView::operator* (
+      const Position3DView& pPos) const
+    {
+      return *this*static_cast<Position3D>(pPos);
+    }
+
+    ALMATH_INLINE Transform TransformView::inverse() const
+    {
+      return Math::transformInverse(*this);
+    }
+
+    ALMATH_INLINE Position3D operator* (
+      const Transform&      pT,
+      const Position3DView& pPos)
+    {
+      const float* d = pPos.data;
+      return Position3D(
+        pT.r1_c1*d[0] + pT.r1_c2*d[1] + pT.r1_c3*d[2] + pT.r1_c4,
+        pT.r2_c1*d[0] + pT.r2_c2*d[1] + pT.r2_c3*d[2] + pT.r2_c4,
+        pT.r3_c1*d[0] + pT.r3_c2*d[1] + pT.r3_c3*d[2] + pT.r3_c4);
+    }
+
+    ALMATH_INLINE Position3DView Position3DArrayView::operator[] (
+      const unsigned int pIndex) const
+    {
+      return Position3DView(data + pIndex*stride);
+    }
+
+    ALMATH_INLINE TransformView TransformArrayView::operator[] (
+      const unsigned int pIndex) const
+    {
+      return TransformView(data + pIndex*stride);
+    }
+
+  } // end namespace Math
+} // end namespace AL
+
+#endif  // _LIBALMATH_ALMATH_TYPES_ALTRANSFORMVIEW_HXX_
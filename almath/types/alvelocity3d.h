@@ -112,6 +112,16 @@ namespace AL {
       /// </param>
       Velocity3D(const std::vector<float>& pFloats);
 
+      /// <summary>
+      /// Create a Velocity3D from a buffer of float, without heap allocation.
+      /// Same behaviour as the std::vector constructor.
+      /// </summary>
+      /// <param name="pFloats"> the buffer of pSize float </param>
+      /// <param name="pSize"> the number of float of the buffer </param>
+      Velocity3D(
+        const float*       pFloats,
+        const unsigned int pSize);
+
       /// <summary>
       /// Overloading of operator + for Velocity3D.
       /// </summary>
@@ -217,6 +227,16 @@ namespace AL {
       /// </returns>
       Velocity3D normalize() const;
 
+      /// number of float written by writeTo: xd, yd and zd
+      static const unsigned int SIZE = 3;
+
+      /// <summary>
+      /// Write the Velocity3D to a buffer of SIZE float, without heap
+      /// allocation.
+      /// </summary>
+      /// <param name="pOut"> the buffer of at least SIZE float </param>
+      void writeTo(float* pOut) const;
+
       /// <summary>
       /// Return the Velocity3D as a vector of float [xd, yd, zd].
       /// </summary>
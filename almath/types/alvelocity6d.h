@@ -150,6 +150,16 @@ struct Velocity6D {
   /// </param>
   Velocity6D(const std::vector<float>& pFloats);
 
+  /// <summary>
+  /// Create a Velocity6D from a buffer of float, without heap allocation.
+  /// Same behaviour as the std::vector constructor.
+  /// </summary>
+  /// <param name="pFloats"> the buffer of pSize float </param>
+  /// <param name="pSize"> the number of float of the buffer </param>
+  Velocity6D(
+    const float*       pFloats,
+    const unsigned int pSize);
+
   /// <summary>
   /// Overloading of operator + for Velocity6D.
   /// </summary>
@@ -242,6 +252,16 @@ struct Velocity6D {
   /// </returns>
   Velocity6D normalize() const;
 
+  /// number of float written by writeTo: xd, yd, zd, wxd, wyd and wzd
+  static const unsigned int SIZE = 6;
+
+  /// <summary>
+  /// Write the Velocity6D to a buffer of SIZE float, without heap
+  /// allocation.
+  /// </summary>
+  /// <param name="pOut"> the buffer of at least SIZE float </param>
+  void writeTo(float* pOut) const;
+
   /// <summary>
   /// Return the Velocity6D as a vector of float [xd, yd, zd, wxd, wyd, wzd].
   /// </summary>
@@ -14,6 +14,8 @@
 
 #include <cmath>
 
+#include "altrigbackend.h"
+
 namespace AL {
   namespace Math {
 
@@ -36,8 +38,8 @@ namespace AL {
     /// <param name="pTangents">    The tangent. </param>
     /// <param name="pbestTangent"> The best tangent. </param>
     void xComputeBestTangent(
-        const std::vector<std::vector<dubinsTangent> >& pTangents,
-        std::vector<dubinsTangent>&                     pBestTangent);
+        const dubinsTangent pTangents[4][2],
+        dubinsTangent       pBestTangent[2]);
 
 
     /// <summary> Calculates the tangent. </summary>
@@ -53,7 +55,7 @@ namespace AL {
         const int&                  pSens,
         const float&                pCircleRadius,
         const bool&                 pLLorRR,
-        std::vector<dubinsTangent>& pTangent);
+        dubinsTangent               pTangent[2]);
 
 
     /// <summary> Gets the tangents. </summary>
@@ -61,9 +63,9 @@ namespace AL {
     /// <param name="pCircleRadius">  The circle radius. </param>
     /// <param name="pCircleRadius">  The tangents. </param>
     void xGetTangents(
-        const std::vector<AL::Math::Position2D>&  pCircles,
-        const float&                              pCircleRadius,
-        std::vector<std::vector<dubinsTangent> >& pTangents);
+        const AL::Math::Position2D pCircles[4],
+        const float&               pCircleRadius,
+        dubinsTangent              pTangents[4][2]);
 
 
     /// <summary> Calculates the circles. </summary>
@@ -71,42 +73,30 @@ namespace AL {
     /// <param name="pCircleRadius"> The circle radius. </param>
     /// <param name="pCircles">      The calculated circles. </param>
     void xGetCircles(
-        const AL::Math::Pose2D&            pPose,
-        const float&                       pCircleRadius,
-        std::vector<AL::Math::Position2D>& pCircles);
+        const AL::Math::Pose2D& pPose,
+        const float&            pCircleRadius,
+        AL::Math::Position2D    pCircles[4]);
 
     void xComputeBestTangent(
-        const std::vector<std::vector<dubinsTangent> >& pTangents,
-        std::vector<dubinsTangent>&                     pBestTangent)
+        const dubinsTangent pTangents[4][2],
+        dubinsTangent       pBestTangent[2])
     {
-
-      if (pTangents.size() != 4)
-      {
-        throw std::invalid_argument("ALDubinsCurve: computeBestTangent Input Tangent must be size 4.");
-      }
-
-      if (pBestTangent.size() != 2)
-      {
-        throw std::invalid_argument(
-            "ALDubinsCurve: computeBestTangent "
-            "Input Best Tangent must be size 2.");
-      }
-
       float shortestTangent = FLT_MAX;
       float tangentLength;
 
       for (unsigned int i=0; i<4; i++)
       {
         tangentLength = (
-            (pTangents.at(i).at(0).x - pTangents.at(i).at(1).x) *
-            (pTangents.at(i).at(0).x - pTangents.at(i).at(1).x) +
-            (pTangents.at(i).at(0).y - pTangents.at(i).at(1).y) *
-            (pTangents.at(i).at(0).y - pTangents.at(i).at(1).y) );
+            (pTangents[i][0].x - pTangents[i][1].x) *
+            (pTangents[i][0].x - pTangents[i][1].x) +
+            (pTangents[i][0].y - pTangents[i][1].y) *
+            (pTangents[i][0].y - pTangents[i][1].y) );
 
         if (tangentLength < shortestTangent)
         {
           shortestTangent = tangentLength;
-          pBestTangent = pTangents.at(i);
+          pBestTangent[0] = pTangents[i][0];
+          pBestTangent[1] = pTangents[i][1];
         }
       }
     }
@@ -118,15 +108,8 @@ namespace AL {
         const int&                  pSens,
         const float&                pCircleRadius,
         const bool&                 pLLorRR,
-        std::vector<dubinsTangent>& pTangent)
+        dubinsTangent               pTangent[2])
     {
-
-      if (pTangent.size() != 2)
-      {
-        throw std::invalid_argument(
-            "ALDubinsCurve: computeTangent Input must be size 2.");
-      }
-
       float dist; // distance between two center of circle
       float rd;
       float cos_theta;
@@ -170,197 +153,528 @@ namespace AL {
       }
 
       // tangent
-      pTangent.at(0) = point1;
-      pTangent.at(1) = point2;
+      pTangent[0] = point1;
+      pTangent[1] = point2;
 
     } // end computeTangent
 
 
     void xGetTangents(
-        const std::vector<AL::Math::Position2D>&   pCircles,
-        const float&                               pCircleRadius,
-        std::vector< std::vector<dubinsTangent> >& pTangents)
+        const AL::Math::Position2D pCircles[4],
+        const float&               pCircleRadius,
+        dubinsTangent              pTangents[4][2])
     {
-
-      if (pTangents.size() != 4)
-      {
-        throw std::invalid_argument(
-            "ALDubinsCurve: getTangents Input must be size 4.");
-      }
-
       /**
       * LSL
       */
       xComputeTangent(
-          pCircles.at(0),   // pCircle1
-          pCircles.at(2),   // pCircle2
+          pCircles[0],      // pCircle1
+          pCircles[2],      // pCircle2
           1,                // pSens
           pCircleRadius,    // pCircleRadius
           true,             // pLLorRR
-          pTangents.at(0));
-      pTangents.at(0).at(0).isLeft = true;
-      pTangents.at(0).at(1).isLeft = true;
+          pTangents[0]);
+      pTangents[0][0].isLeft = true;
+      pTangents[0][1].isLeft = true;
 
       /**
       * LSR
       */
       xComputeTangent(
-          pCircles.at(0),  // pCircle1
-          pCircles.at(3),  // pCircle2
+          pCircles[0],     // pCircle1
+          pCircles[3],     // pCircle2
           1,               // pSens
           pCircleRadius,   // pCircleRadius
           false,           // pLLorRR
-          pTangents.at(1));
-      pTangents.at(1).at(0).isLeft = true;
-      pTangents.at(1).at(1).isLeft = false;
+          pTangents[1]);
+      pTangents[1][0].isLeft = true;
+      pTangents[1][1].isLeft = false;
 
       /**
       * RSL
       */
       xComputeTangent(
-          pCircles.at(1),  // pCircle1
-          pCircles.at(2),  // pCircle2
+          pCircles[1],     // pCircle1
+          pCircles[2],     // pCircle2
           -1,              // pSens
           pCircleRadius,   // pCircleRadius
           false,           // pLLorRR
-          pTangents.at(2));
-      pTangents.at(2).at(0).isLeft = false;
-      pTangents.at(2).at(1).isLeft = true;
+          pTangents[2]);
+      pTangents[2][0].isLeft = false;
+      pTangents[2][1].isLeft = true;
 
       /**
       * RSR
       */
       xComputeTangent(
-          pCircles.at(1),  // pCircle1
-          pCircles.at(3),  // pCircle2
+          pCircles[1],     // pCircle1
+          pCircles[3],     // pCircle2
           -1,              // pSens
           pCircleRadius,   // pCircleRadius
           true,            // pLLorRR
-          pTangents.at(3));
-      pTangents.at(3).at(0).isLeft = false;
-      pTangents.at(3).at(1).isLeft = false;
+          pTangents[3]);
+      pTangents[3][0].isLeft = false;
+      pTangents[3][1].isLeft = false;
 
     } // end getTangents
 
 
     void xGetCircles(
-        const AL::Math::Pose2D&            pPose,
-        const float&                       pCircleRadius,
-        std::vector<AL::Math::Position2D>& pCircles)
+        const AL::Math::Pose2D& pPose,
+        const float&            pCircleRadius,
+        AL::Math::Position2D    pCircles[4])
     {
-
-      if (pCircles.size() != 4)
-      {
-        throw std::invalid_argument(
-            "ALDubinsCurve: getCircles Input must be size 4.");
-      }
-
-      AL::Math::Position2D tmpCircle;
-
       // Left Circle - init
-      tmpCircle.x = 0.0f;
-      tmpCircle.y = pCircleRadius;
-      pCircles.at(0) = tmpCircle;
+      pCircles[0].x = 0.0f;
+      pCircles[0].y = pCircleRadius;
 
       // Right Circle - init
-      tmpCircle.x = 0.0f;
-      tmpCircle.y = -pCircleRadius;
-      pCircles.at(1) = tmpCircle;
+      pCircles[1].x = 0.0f;
+      pCircles[1].y = -pCircleRadius;
+
+      float s = 0.0f;
+      float c = 0.0f;
+      Trig::sinCos(pPose.theta, s, c);
 
       // Left Circle - Desired
-      tmpCircle.x = pPose.x - ( sin(pPose.theta)*pCircleRadius );
-      tmpCircle.y = pPose.y + ( cos(pPose.theta)*pCircleRadius );
-      pCircles.at(2) = tmpCircle;
+      pCircles[2].x = pPose.x - ( s*pCircleRadius );
+      pCircles[2].y = pPose.y + ( c*pCircleRadius );
 
       // Right Circle - Desired
-      tmpCircle.x = pPose.x + ( sin(pPose.theta)*pCircleRadius );
-      tmpCircle.y = pPose.y - ( cos(pPose.theta)*pCircleRadius );
-      pCircles.at(3) = tmpCircle;
+      pCircles[3].x = pPose.x + ( s*pCircleRadius );
+      pCircles[3].y = pPose.y - ( c*pCircleRadius );
     } // end getCircles
 
 
-    std::vector<AL::Math::Pose2D> getDubinsSolutions(
+    DubinsStatus getDubinsSolutions(
         const AL::Math::Pose2D& pTargetPose,
-        const float             pCircleRadius)
+        const float             pCircleRadius,
+        DubinsSolutions&        pSolutions)
     {
+      // also rejects NaN
+      if (!(pCircleRadius > 0.0f))
+      {
+        return DUBINS_INVALID_RADIUS;
+      }
+
       // protection around small distance
       // in relation with circleRadius
-      float dist = sqrt(pTargetPose.x*pTargetPose.x +
-                        pTargetPose.y*pTargetPose.y );
+      float dist = sqrtf(pTargetPose.x*pTargetPose.x +
+                         pTargetPose.y*pTargetPose.y );
       if(dist < 4.0f*pCircleRadius)
       {
-        throw std::invalid_argument(
-            "ALDubinsCurve: getDubinsSolutions pTargetPose.norm() < 4.0*pCircleRadius.");
+        return DUBINS_TARGET_TOO_CLOSE;
       }
 
-      std::vector<AL::Math::Pose2D> solutions;
-      AL::Math::Pose2D tmpSolution;
-
-      std::vector<AL::Math::Position2D> circles;
-      circles.resize(4);
+      AL::Math::Position2D circles[4];
       xGetCircles(pTargetPose, pCircleRadius, circles);
 
-      std::vector<dubinsTangent> tmpDubins;
-      tmpDubins.resize(2);
-      std::vector<std::vector<dubinsTangent> > tangents;
-      tangents.resize(4);
-      for (unsigned int i=0; i<4; i++)
-      {
-        tangents.at(i) = tmpDubins;
-      }
+      dubinsTangent tangents[4][2];
       xGetTangents(circles, pCircleRadius, tangents);
 
-      std::vector<dubinsTangent> bestTangent;
-      bestTangent.resize(2);
-
+      dubinsTangent bestTangent[2];
       xComputeBestTangent(tangents, bestTangent);
 
       //// First CheckPoint of this Dubins Curve
-      tmpSolution.x = bestTangent.at(0).x;
-      tmpSolution.y = bestTangent.at(0).y;
-      tmpSolution.theta = atan2(bestTangent.at(1).y - bestTangent.at(0).y,
-                                bestTangent.at(1).x - bestTangent.at(0).x);
-      solutions.push_back(tmpSolution);
+      pSolutions[0].x = bestTangent[0].x;
+      pSolutions[0].y = bestTangent[0].y;
+      pSolutions[0].theta = Trig::atan2(bestTangent[1].y - bestTangent[0].y,
+                                        bestTangent[1].x - bestTangent[0].x);
 
       //// Second CheckPoint of this Dubins Curve
-      tmpSolution.x = bestTangent.at(1).x;
-      tmpSolution.y = bestTangent.at(1).y;
+      pSolutions[1].x = bestTangent[1].x;
+      pSolutions[1].y = bestTangent[1].y;
       // theta is equivalent in first and second checkPoint
-      solutions.push_back(tmpSolution);
+      pSolutions[1].theta = pSolutions[0].theta;
 
       /// Last CheckPoint is targetPose
-      solutions.push_back(pTargetPose);
+      pSolutions[2] = pTargetPose;
 
       /**********************************
       Check Solution (angle rotation)
       *********************************/
-      AL::Math::Pose2D newSolutions;
-      AL::Math::Pose2D newSolutionsLast;
-      bool findNewSolutionFirst = false;
-      bool findNewSolutionLast  = false;
-
       // first test is angle of rotation find with atan2 is in the good sens
       // first tangent
-      float angle1 = solutions.at(0).theta;
-      if (bestTangent.at(0).isLeft && angle1 < 0.0f)
+      float angle1 = pSolutions[0].theta;
+      if (bestTangent[0].isLeft && angle1 < 0.0f)
       {
-        solutions.at(0).theta = 2.0f * PI + angle1;
+        pSolutions[0].theta = 2.0f * PI + angle1;
       }
-      if (!bestTangent.at(0).isLeft && angle1 > 0.0f)
+      if (!bestTangent[0].isLeft && angle1 > 0.0f)
       {
-        solutions.at(0).theta = 2.0f * PI + angle1;
+        pSolutions[0].theta = 2.0f * PI + angle1;
       }
       // second tangent
-      float angle2 = solutions.at(2).theta - solutions.at(1).theta;
-      if (bestTangent.at(1).isLeft && angle2 < 0.0f)
+      float angle2 = pSolutions[2].theta - pSolutions[1].theta;
+      if (bestTangent[1].isLeft && angle2 < 0.0f)
       {
-        solutions.at(1).theta = 2.0f * PI - angle2 + solutions.at(2).theta;
+        pSolutions[1].theta = 2.0f * PI - angle2 + pSolutions[2].theta;
       }
-      if (!bestTangent.at(1).isLeft && angle2 > 0.0f)
+      if (!bestTangent[1].isLeft && angle2 > 0.0f)
       {
-        solutions.at(1).theta = 2.0f * PI - angle2 + solutions.at(2).theta;
+        pSolutions[1].theta = 2.0f * PI - angle2 + pSolutions[2].theta;
       }
-      return solutions;
+      return DUBINS_SUCCESS;
     } // end getDubinsSolutions
+
+
+    std::vector<AL::Math::Pose2D> getDubinsSolutions(
+        const AL::Math::Pose2D& pTargetPose,
+        const float             pCircleRadius)
+    {
+      DubinsSolutions solutions;
+      const DubinsStatus status =
+          getDubinsSolutions(pTargetPose, pCircleRadius, solutions);
+      if (status == DUBINS_INVALID_RADIUS)
+      {
+        throw std::invalid_argument(
+            "ALDubinsCurve: getDubinsSolutions pCircleRadius must be strictly positive.");
+      }
+      if (status != DUBINS_SUCCESS)
+      {
+        throw std::invalid_argument(
+            "ALDubinsCurve: getDubinsSolutions pTargetPose.norm() < 4.0*pCircleRadius.");
+      }
+      return std::vector<AL::Math::Pose2D>(solutions, solutions + 3);
+    }
+
+
+    unsigned int getDubinsSolutionsBatch(
+        const AL::Math::Pose2D* pTargetPoses,
+        const unsigned int      pSize,
+        const float             pCircleRadius,
+        DubinsSolutions*        pSolutions,
+        DubinsStatus*           pStatus)
+    {
+      unsigned int nbSuccess = 0;
+      for (unsigned int i=0; i<pSize; i++)
+      {
+        pStatus[i] = getDubinsSolutions(pTargetPoses[i], pCircleRadius, pSolutions[i]);
+        if (pStatus[i] == DUBINS_SUCCESS)
+        {
+          ++nbSuccess;
+        }
+      }
+      return nbSuccess;
+    }
+
+
+    /****************************
+    DUBINS PATH
+    ****************************/
+    /// <summary> Wrap an angle in [0, 2pi[. </summary>
+    float xMod2PI(const float pAngle)
+    {
+      float angle = fmodf(pAngle, 2.0f*PI);
+      if (angle < 0.0f)
+      {
+        angle += 2.0f*PI;
+      }
+      return angle;
+    }
+
+    /// <summary>
+    /// Compute the normalized segment lengths (unit radius) of one family.
+    /// </summary>
+    /// <param name="pType">  the path family </param>
+    /// <param name="pAlpha"> the start heading, relative to the target line </param>
+    /// <param name="pBeta">  the target heading, relative to the target line </param>
+    /// <param name="pD">     the normalized distance to the target </param>
+    /// <param name="pT">     the three normalized lengths </param>
+    /// <returns> false if the family has no solution. </returns>
+    bool xComputeDubinsWord(
+        const DubinsPathType pType,
+        const float          pAlpha,
+        const float          pBeta,
+        const float          pD,
+        float                pT[3])
+    {
+      const float sa = sinf(pAlpha);
+      const float ca = cosf(pAlpha);
+      const float sb = sinf(pBeta);
+      const float cb = cosf(pBeta);
+      const float cab = cosf(pAlpha - pBeta);
+      const float d2 = pD*pD;
+
+      float tmp;
+      float pSq;
+      float phi;
+      switch (pType)
+      {
+      case DUBINS_LSL:
+        pSq = 2.0f + d2 - 2.0f*cab + 2.0f*pD*(sa - sb);
+        if (pSq < 0.0f)
+        {
+          return false;
+        }
+        phi = atan2f(cb - ca, pD + sa - sb);
+        pT[0] = xMod2PI(phi - pAlpha);
+        pT[1] = sqrtf(pSq);
+        pT[2] = xMod2PI(pBeta - phi);
+        return true;
+
+      case DUBINS_RSR:
+        pSq = 2.0f + d2 - 2.0f*cab + 2.0f*pD*(sb - sa);
+        if (pSq < 0.0f)
+        {
+          return false;
+        }
+        phi = atan2f(ca - cb, pD - sa + sb);
+        pT[0] = xMod2PI(pAlpha - phi);
+        pT[1] = sqrtf(pSq);
+        pT[2] = xMod2PI(phi - pBeta);
+        return true;
+
+      case DUBINS_LSR:
+        pSq = -2.0f + d2 + 2.0f*cab + 2.0f*pD*(sa + sb);
+        if (pSq < 0.0f)
+        {
+          return false;
+        }
+        pT[1] = sqrtf(pSq);
+        phi = atan2f(-ca - cb, pD + sa + sb) - atan2f(-2.0f, pT[1]);
+        pT[0] = xMod2PI(phi - pAlpha);
+        pT[2] = xMod2PI(phi - pBeta);
+        return true;
+
+      case DUBINS_RSL:
+        pSq = -2.0f + d2 + 2.0f*cab - 2.0f*pD*(sa + sb);
+        if (pSq < 0.0f)
+        {
+          return false;
+        }
+        pT[1] = sqrtf(pSq);
+        phi = atan2f(ca + cb, pD - sa - sb) - atan2f(2.0f, pT[1]);
+        pT[0] = xMod2PI(pAlpha - phi);
+        pT[2] = xMod2PI(pBeta - phi);
+        return true;
+
+      case DUBINS_RLR:
+        tmp = (6.0f - d2 + 2.0f*cab + 2.0f*pD*(sa - sb))/8.0f;
+        if (fabsf(tmp) > 1.0f)
+        {
+          return false;
+        }
+        phi = atan2f(ca - cb, pD - sa + sb);
+        pT[1] = xMod2PI(2.0f*PI - acosf(tmp));
+        pT[0] = xMod2PI(pAlpha - phi + 0.5f*pT[1]);
+        pT[2] = xMod2PI(pAlpha - pBeta - pT[0] + pT[1]);
+        return true;
+
+      case DUBINS_LRL:
+        tmp = (6.0f - d2 + 2.0f*cab + 2.0f*pD*(sb - sa))/8.0f;
+        if (fabsf(tmp) > 1.0f)
+        {
+          return false;
+        }
+        phi = atan2f(ca - cb, pD + sa - sb);
+        pT[1] = xMod2PI(2.0f*PI - acosf(tmp));
+        pT[0] = xMod2PI(-pAlpha - phi + 0.5f*pT[1]);
+        pT[2] = xMod2PI(pBeta - pAlpha - pT[0] + pT[1]);
+        return true;
+      }
+      return false;
+    }
+
+    /// <summary>
+    /// Normalize the problem: unit radius, distance and headings relative
+    /// to the line joining the start and the target.
+    /// </summary>
+    void xNormalizeDubins(
+        const Pose2D& pStart,
+        const Pose2D& pTarget,
+        const float   pCircleRadius,
+        float&        pAlpha,
+        float&        pBeta,
+        float&        pD)
+    {
+      const float dx = pTarget.x - pStart.x;
+      const float dy = pTarget.y - pStart.y;
+      pD = sqrtf(dx*dx + dy*dy)/pCircleRadius;
+
+      const float theta = (pD > 0.0f) ? xMod2PI(atan2f(dy, dx)) : 0.0f;
+      pAlpha = xMod2PI(pStart.theta - theta);
+      pBeta  = xMod2PI(pTarget.theta - theta);
+    }
+
+    /// <summary>
+    /// Move a pose along one segment of a unit radius path.
+    /// </summary>
+    /// <param name="pSegment"> 'L', 'S' or 'R' </param>
+    /// <param name="pLength"> the normalized length </param>
+    /// <param name="pPose"> the pose to move </param>
+    void xMoveAlongSegment(
+        const char  pSegment,
+        const float pLength,
+        Pose2D&     pPose)
+    {
+      const float st = sinf(pPose.theta);
+      const float ct = cosf(pPose.theta);
+      if (pSegment == 'L')
+      {
+        pPose.x += sinf(pPose.theta + pLength) - st;
+        pPose.y += ct - cosf(pPose.theta + pLength);
+        pPose.theta += pLength;
+      }
+      else if (pSegment == 'R')
+      {
+        pPose.x += st - sinf(pPose.theta - pLength);
+        pPose.y += cosf(pPose.theta - pLength) - ct;
+        pPose.theta -= pLength;
+      }
+      else
+      {
+        pPose.x += ct*pLength;
+        pPose.y += st*pLength;
+      }
+    }
+
+    /// segments of each DubinsPathType
+    static const char DUBINS_SEGMENTS[6][3] = {
+      {'L', 'S', 'L'},
+      {'L', 'S', 'R'},
+      {'R', 'S', 'L'},
+      {'R', 'S', 'R'},
+      {'R', 'L', 'R'},
+      {'L', 'R', 'L'}};
+
+
+    DubinsPath::DubinsPath():
+      start(),
+      radius(1.0f),
+      type(DUBINS_LSL)
+    {
+      lengths[0] = 0.0f;
+      lengths[1] = 0.0f;
+      lengths[2] = 0.0f;
+    }
+
+
+    float DubinsPath::length() const
+    {
+      return lengths[0] + lengths[1] + lengths[2];
+    }
+
+
+    Pose2D DubinsPath::sample(const float pArcLength) const
+    {
+      float remaining = (pArcLength > 0.0f) ? pArcLength : 0.0f;
+
+      // the path is computed with a unit radius around origin
+      Pose2D pose(0.0f, 0.0f, start.theta);
+      for (unsigned int i=0; i<3; i++)
+      {
+        const float segment = (remaining < lengths[i]) ? remaining : lengths[i];
+        xMoveAlongSegment(DUBINS_SEGMENTS[type][i], segment/radius, pose);
+        remaining -= segment;
+      }
+
+      pose.x = start.x + radius*pose.x;
+      pose.y = start.y + radius*pose.y;
+      pose.theta = xMod2PI(pose.theta + PI) - PI;
+      return pose;
+    }
+
+
+    DubinsStatus computeDubinsPath(
+        const Pose2D&        pStart,
+        const Pose2D&        pTarget,
+        const float          pCircleRadius,
+        const DubinsPathType pType,
+        DubinsPath&          pPath)
+    {
+      if (!(pCircleRadius > 0.0f))
+      {
+        return DUBINS_INVALID_RADIUS;
+      }
+
+      float alpha, beta, d;
+      xNormalizeDubins(pStart, pTarget, pCircleRadius, alpha, beta, d);
+
+      float t[3];
+      if (!xComputeDubinsWord(pType, alpha, beta, d, t))
+      {
+        return DUBINS_NO_PATH;
+      }
+
+      pPath.start = pStart;
+      pPath.radius = pCircleRadius;
+      pPath.type = pType;
+      pPath.lengths[0] = t[0]*pCircleRadius;
+      pPath.lengths[1] = t[1]*pCircleRadius;
+      pPath.lengths[2] = t[2]*pCircleRadius;
+      return DUBINS_SUCCESS;
+    }
+
+
+    DubinsStatus computeDubinsPath(
+        const Pose2D& pStart,
+        const Pose2D& pTarget,
+        const float   pCircleRadius,
+        DubinsPath&   pPath)
+    {
+      if (!(pCircleRadius > 0.0f))
+      {
+        return DUBINS_INVALID_RADIUS;
+      }
+
+      float alpha, beta, d;
+      xNormalizeDubins(pStart, pTarget, pCircleRadius, alpha, beta, d);
+
+      // there is always at least one CSC or CCC solution
+      float bestLength = FLT_MAX;
+      float best[3] = {0.0f, 0.0f, 0.0f};
+      DubinsPathType bestType = DUBINS_LSL;
+      for (unsigned int i=0; i<6; i++)
+      {
+        const DubinsPathType type = static_cast<DubinsPathType>(i);
+        float t[3];
+        if (xComputeDubinsWord(type, alpha, beta, d, t) &&
+            (t[0] + t[1] + t[2] < bestLength))
+        {
+          bestLength = t[0] + t[1] + t[2];
+          bestType = type;
+          best[0] = t[0];
+          best[1] = t[1];
+          best[2] = t[2];
+        }
+      }
+
+      pPath.start = pStart;
+      pPath.radius = pCircleRadius;
+      pPath.type = bestType;
+      pPath.lengths[0] = best[0]*pCircleRadius;
+      pPath.lengths[1] = best[1]*pCircleRadius;
+      pPath.lengths[2] = best[2]*pCircleRadius;
+      return DUBINS_SUCCESS;
+    }
+
+
+    unsigned int sampleDubinsPath(
+        const DubinsPath&  pPath,
+        const float        pStep,
+        const float        pFrom,
+        Pose2D*            pPoses,
+        const unsigned int pMaxSize)
+    {
+      if (!(pStep > 0.0f))
+      {
+        return 0;
+      }
+
+      const float length = pPath.length();
+      unsigned int nbPoses = 0;
+      while (nbPoses < pMaxSize)
+      {
+        const float s = pFrom + static_cast<float>(nbPoses)*pStep;
+        if (s > length)
+        {
+          break;
+        }
+        pPoses[nbPoses] = pPath.sample(s);
+        ++nbPoses;
+      }
+      return nbPoses;
+    }
   }
 }
@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/alinterpolation.h>
+#include <algorithm>
+#include <stdexcept>
+
+#include "alsimd.h"
+
+namespace AL
+{
+  namespace Math
+  {
+    namespace
+    {
+      // Position and derivative of the polynomials of pNbJoints joints,
+      // whose coefficients are stored as N arrays of pNbJoints float, at
+      // pS, by the Horner scheme.
+      template <unsigned int N, typename T>
+      inline void xPolynomial(
+          const float*       pCoefficients,
+          const unsigned int pNbJoints,
+          const T&           pS,
+          T&                 pQ,
+          T&                 pDq)
+      {
+        const float* c = pCoefficients + (N - 1)*pNbJoints;
+        T q  = Simd::load<T>(c);
+        T dq = q*Simd::splat<T>(static_cast<float>(N - 1));
+        for (unsigned int k=N - 2; k>0; --k)
+        {
+          c -= pNbJoints;
+          const T ck = Simd::load<T>(c);
+          q  = q*pS + ck;
+          dq = dq*pS + ck*Simd::splat<T>(static_cast<float>(k));
+        }
+        pQ  = q*pS + Simd::load<T>(c - pNbJoints);
+        pDq = dq;
+      }
+
+      template <unsigned int N>
+      void xEvaluateSegment(
+          const float*         pCoefficients,
+          const unsigned int   pNbJoints,
+          const float          pS,
+          const float          pVelocityScale,
+          PositionAndVelocity* pOut)
+      {
+        // PositionAndVelocity is made of two float: q and dq are written
+        // with a stride of 2 float
+        unsigned int j = 0;
+        const Simd::Pack packS     = Simd::splat<Simd::Pack>(pS);
+        const Simd::Pack packScale = Simd::splat<Simd::Pack>(pVelocityScale);
+        for (; j + Simd::WIDTH <= pNbJoints; j += Simd::WIDTH)
+        {
+          Simd::Pack q;
+          Simd::Pack dq;
+          xPolynomial<N>(pCoefficients + j, pNbJoints, packS, q, dq);
+          Simd::scatter(&pOut[j].q, 2, q);
+          Simd::scatter(&pOut[j].dq, 2, dq*packScale);
+        }
+
+        for (; j < pNbJoints; ++j)
+        {
+          float q  = 0.0f;
+          float dq = 0.0f;
+          xPolynomial<N>(pCoefficients + j, pNbJoints, pS, q, dq);
+          pOut[j].q  = q;
+          pOut[j].dq = dq*pVelocityScale;
+        }
+      }
+    }
+
+    JointTrajectory::JointTrajectory(
+      const unsigned int      pNbJoints,
+      const InterpolationType pType):
+      fNbJoints(pNbJoints),
+      fType(pType),
+      fNbCoefficients((pType == INTERPOLATION_CUBIC) ? 4 : 6),
+      fLastPositions(pNbJoints, 0.0f),
+      fLastVelocities(pNbJoints, 0.0f)
+    {
+      if (pNbJoints == 0)
+      {
+        throw std::invalid_argument(
+          "ALMath: JointTrajectory needs at least one joint.");
+      }
+      if ((pType < INTERPOLATION_CUBIC) || (pType > INTERPOLATION_MINIMUM_JERK))
+      {
+        throw std::invalid_argument(
+          "ALMath: JointTrajectory unknown interpolation type.");
+      }
+    }
+
+    void JointTrajectory::addWaypoint(
+      const float  pTime,
+      const float* pPositions,
+      const float* pVelocities)
+    {
+      if (!fTimes.empty() && !(pTime > fTimes.back()))
+      {
+        throw std::invalid_argument(
+          "ALMath: JointTrajectory waypoint times must be increasing.");
+      }
+
+      const bool hasVelocities =
+          (pVelocities != NULL) && (fType != INTERPOLATION_MINIMUM_JERK);
+      if (!fTimes.empty())
+      {
+        // the polynomial of s = (t - t0)/duration in [0, 1], whose
+        // derivative at the ends is the waypoint velocity times duration
+        const float duration = pTime - fTimes.back();
+        const std::size_t offset = fCoefficients.size();
+        fCoefficients.resize(offset + fNbCoefficients*fNbJoints);
+        float* c = &fCoefficients[offset];
+        for (unsigned int j=0; j<fNbJoints; ++j)
+        {
+          const float p0 = fLastPositions[j];
+          const float d  = pPositions[j] - p0;
+          const float v0 = fLastVelocities[j]*duration;
+          const float v1 = hasVelocities ? pVelocities[j]*duration : 0.0f;
+
+          c[j]             = p0;
+          c[fNbJoints + j] = v0;
+          if (fType == INTERPOLATION_CUBIC)
+          {
+            c[2*fNbJoints + j] = 3.0f*d - 2.0f*v0 - v1;
+            c[3*fNbJoints + j] = -2.0f*d + v0 + v1;
+          }
+          else
+          {
+            // zero acceleration at both ends
+            c[2*fNbJoints + j] = 0.0f;
+            c[3*fNbJoints + j] = 10.0f*d - 6.0f*v0 - 4.0f*v1;
+            c[4*fNbJoints + j] = -15.0f*d + 8.0f*v0 + 7.0f*v1;
+            c[5*fNbJoints + j] = 6.0f*d - 3.0f*v0 - 3.0f*v1;
+          }
+        }
+      }
+
+      fTimes.push_back(pTime);
+      std::copy(pPositions, pPositions + fNbJoints, fLastPositions.begin());
+      if (hasVelocities)
+      {
+        std::copy(pVelocities, pVelocities + fNbJoints, fLastVelocities.begin());
+      }
+      else
+      {
+        std::fill(fLastVelocities.begin(), fLastVelocities.end(), 0.0f);
+      }
+    }
+
+    void JointTrajectory::clear()
+    {
+      fTimes.clear();
+      fCoefficients.clear();
+    }
+
+    void JointTrajectory::reserve(const unsigned int pNbWaypoints)
+    {
+      fTimes.reserve(pNbWaypoints);
+      if (pNbWaypoints > 1)
+      {
+        fCoefficients.reserve((pNbWaypoints - 1)*fNbCoefficients*fNbJoints);
+      }
+    }
+
+    unsigned int JointTrajectory::getNbJoints() const
+    {
+      return fNbJoints;
+    }
+
+    unsigned int JointTrajectory::getNbWaypoints() const
+    {
+      return static_cast<unsigned int>(fTimes.size());
+    }
+
+    InterpolationType JointTrajectory::getInterpolationType() const
+    {
+      return fType;
+    }
+
+    float JointTrajectory::getStartTime() const
+    {
+      return fTimes.empty() ? 0.0f : fTimes.front();
+    }
+
+    float JointTrajectory::getFinalTime() const
+    {
+      return fTimes.empty() ? 0.0f : fTimes.back();
+    }
+
+    void JointTrajectory::evaluate(
+      const float          pTime,
+      PositionAndVelocity* pOut) const
+    {
+      if (fTimes.empty())
+      {
+        throw std::runtime_error(
+          "ALMath: JointTrajectory has no waypoint.");
+      }
+      xEvaluate(xSearchSegment(pTime), pTime, pOut);
+    }
+
+    unsigned int JointTrajectory::xSearchSegment(const float pTime) const
+    {
+      if (fTimes.size() < 3)
+      {
+        return 0;
+      }
+      // the first segment whose final time is after pTime, the last
+      // segment after the end
+      return static_cast<unsigned int>(
+            std::upper_bound(fTimes.begin() + 1, fTimes.end() - 1, pTime) -
+            (fTimes.begin() + 1));
+    }
+
+    unsigned int JointTrajectory::xFindSegment(
+      const float        pTime,
+      const unsigned int pHint) const
+    {
+      if (fTimes.size() < 3)
+      {
+        return 0;
+      }
+      const unsigned int nbSegments = static_cast<unsigned int>(fTimes.size()) - 1;
+      unsigned int segment = std::min(pHint, nbSegments - 1);
+      while ((segment + 1 < nbSegments) && (pTime >= fTimes[segment + 1]))
+      {
+        ++segment;
+      }
+      while ((segment > 0) && (pTime < fTimes[segment]))
+      {
+        --segment;
+      }
+      return segment;
+    }
+
+    void JointTrajectory::xEvaluate(
+      const unsigned int   pSegment,
+      const float          pTime,
+      PositionAndVelocity* pOut) const
+    {
+      if (fTimes.size() < 2)
+      {
+        for (unsigned int j=0; j<fNbJoints; ++j)
+        {
+          pOut[j].q  = fLastPositions[j];
+          pOut[j].dq = 0.0f;
+        }
+        return;
+      }
+
+      const float t0 = fTimes[pSegment];
+      const float duration = fTimes[pSegment + 1] - t0;
+      float s = (pTime - t0)/duration;
+      float velocityScale = 1.0f/duration;
+      if (s < 0.0f)
+      {
+        s = 0.0f;
+        velocityScale = 0.0f;
+      }
+      else if (s > 1.0f)
+      {
+        s = 1.0f;
+        velocityScale = 0.0f;
+      }
+
+      const float* coefficients = &fCoefficients[pSegment*fNbCoefficients*fNbJoints];
+      if (fNbCoefficients == 4)
+      {
+        xEvaluateSegment<4>(coefficients, fNbJoints, s, velocityScale, pOut);
+      }
+      else
+      {
+        xEvaluateSegment<6>(coefficients, fNbJoints, s, velocityScale, pOut);
+      }
+    }
+
+    JointTrajectoryCursor::JointTrajectoryCursor(
+      const JointTrajectory& pTrajectory,
+      const float            pPeriod):
+      fTrajectory(&pTrajectory),
+      fPeriod(pPeriod),
+      fOrigin(pTrajectory.getStartTime()),
+      fTick(0),
+      fSegment(0)
+    {
+      if (pPeriod <= 0.0f)
+      {
+        throw std::invalid_argument(
+          "ALMath: JointTrajectoryCursor period must be positive.");
+      }
+    }
+
+    void JointTrajectoryCursor::seek(const float pTime)
+    {
+      fOrigin  = pTime;
+      fTick    = 0;
+      fSegment = fTrajectory->xSearchSegment(pTime);
+    }
+
+    void JointTrajectoryCursor::next(PositionAndVelocity* pOut)
+    {
+      if (fTrajectory->fTimes.empty())
+      {
+        throw std::runtime_error(
+          "ALMath: JointTrajectory has no waypoint.");
+      }
+      const float time = getTime();
+      fSegment = fTrajectory->xFindSegment(time, fSegment);
+      fTrajectory->xEvaluate(fSegment, time, pOut);
+      ++fTick;
+    }
+
+    float JointTrajectoryCursor::getTime() const
+    {
+      return fOrigin + static_cast<float>(fTick)*fPeriod;
+    }
+
+    bool JointTrajectoryCursor::isFinished() const
+    {
+      return (fTrajectory->getNbWaypoints() == 0) ||
+          (getTime() > fTrajectory->getFinalTime());
+    }
+
+  } // namespace Math
+} // namespace AL
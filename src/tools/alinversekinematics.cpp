@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/alinversekinematics.h>
+#include <almath/tools/almath.h>
+#include <almath/tools/altransformhelpers.h>
+#include <almath/types/alvelocity6d.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#if defined(_WIN32)
+# ifndef NOMINMAX
+#  define NOMINMAX
+# endif
+# include <windows.h>
+#else
+# include <time.h>
+#endif
+
+namespace AL
+{
+  namespace Math
+  {
+    namespace
+    {
+      // Monotonic wall clock in seconds: unlike std::clock, which is the
+      // processor time of the whole process, it measures the latency of
+      // the calling thread, preemption included.
+      double xNow()
+      {
+#if defined(_WIN32)
+        LARGE_INTEGER counter, frequency;
+        QueryPerformanceCounter(&counter);
+        QueryPerformanceFrequency(&frequency);
+        return static_cast<double>(counter.QuadPart)/
+            static_cast<double>(frequency.QuadPart);
+#else
+        struct timespec t;
+        clock_gettime(CLOCK_MONOTONIC, &t);
+        return static_cast<double>(t.tv_sec) + 1.0e-9*static_cast<double>(t.tv_nsec);
+#endif
+      }
+
+      // Solve pA*pX = pB in place in pB, with pA a pSize x pSize symmetric
+      // positive definite matrix, by a Cholesky decomposition of pA in
+      // place.
+      void xCholeskySolve(
+          float*             pA,
+          const unsigned int pSize,
+          float*             pB)
+      {
+        for (unsigned int j=0; j<pSize; ++j)
+        {
+          float d = pA[j*pSize + j];
+          for (unsigned int k=0; k<j; ++k)
+          {
+            d -= pA[j*pSize + k]*pA[j*pSize + k];
+          }
+          // guard against a zero damping at a singularity
+          d = sqrtf(std::max(d, 1.0e-12f));
+          pA[j*pSize + j] = d;
+          for (unsigned int i=j+1; i<pSize; ++i)
+          {
+            float s = pA[i*pSize + j];
+            for (unsigned int k=0; k<j; ++k)
+            {
+              s -= pA[i*pSize + k]*pA[j*pSize + k];
+            }
+            pA[i*pSize + j] = s/d;
+          }
+        }
+
+        // L*y = b, then L^t*x = y
+        for (unsigned int i=0; i<pSize; ++i)
+        {
+          for (unsigned int k=0; k<i; ++k)
+          {
+            pB[i] -= pA[i*pSize + k]*pB[k];
+          }
+          pB[i] /= pA[i*pSize + i];
+        }
+        for (unsigned int i=pSize; i-- > 0;)
+        {
+          for (unsigned int k=i+1; k<pSize; ++k)
+          {
+            pB[i] -= pA[k*pSize + i]*pB[k];
+          }
+          pB[i] /= pA[i*pSize + i];
+        }
+      }
+    }
+
+    InverseKinematicsSolver::InverseKinematicsSolver(
+      KinematicTree&     pTree,
+      const unsigned int pLink,
+      const Transform&   pTip):
+      fTree(&pTree),
+      fLink(pLink),
+      fTip(pTip),
+      fAxisMask(AXIS_MASK_ALL),
+      fDamping(0.01f),
+      fTolerance(0.0001f),
+      fMaxIterations(20),
+      fMaxTime(0.0f),
+      fMinLimits(pTree.getNbJoints(), -std::numeric_limits<float>::max()),
+      fMaxLimits(pTree.getNbJoints(), std::numeric_limits<float>::max()),
+      fJacobian(6*pTree.getNbJoints()),
+      fJointValues(pTree.getNbJoints()),
+      fNbIterations(0),
+      fErrorNorm(0.0f)
+    {
+      if (pLink >= pTree.getNbLinks())
+      {
+        throw std::invalid_argument(
+          "ALMath: InverseKinematicsSolver link index out of range.");
+      }
+      for (unsigned int k=0; k<6; ++k)
+      {
+        fWeights[k] = 1.0f;
+        fError[k]   = 0.0f;
+      }
+    }
+
+    void InverseKinematicsSolver::setAxisMask(const AXIS_MASK& pAxisMask)
+    {
+      fAxisMask = pAxisMask;
+    }
+
+    void InverseKinematicsSolver::setAxisWeights(
+      const std::vector<float>& pWeights)
+    {
+      if (pWeights.size() != 6)
+      {
+        throw std::invalid_argument(
+          "ALMath: InverseKinematicsSolver needs 6 axis weights.");
+      }
+      std::copy(pWeights.begin(), pWeights.end(), fWeights);
+    }
+
+    void InverseKinematicsSolver::setJointLimits(
+      const unsigned int pJoint,
+      const float        pMin,
+      const float        pMax)
+    {
+      if (pJoint >= fMinLimits.size())
+      {
+        throw std::invalid_argument(
+          "ALMath: InverseKinematicsSolver joint index out of range.");
+      }
+      if (pMin > pMax)
+      {
+        throw std::invalid_argument(
+          "ALMath: InverseKinematicsSolver min limit greater than max limit.");
+      }
+      fMinLimits[pJoint] = pMin;
+      fMaxLimits[pJoint] = pMax;
+    }
+
+    void InverseKinematicsSolver::setDamping(const float pDamping)
+    {
+      if (pDamping < 0.0f)
+      {
+        throw std::invalid_argument(
+          "ALMath: InverseKinematicsSolver damping must be positive.");
+      }
+      fDamping = pDamping;
+    }
+
+    void InverseKinematicsSolver::setTolerance(const float pTolerance)
+    {
+      fTolerance = pTolerance;
+    }
+
+    void InverseKinematicsSolver::setMaxIterations(
+      const unsigned int pMaxIterations)
+    {
+      fMaxIterations = pMaxIterations;
+    }
+
+    void InverseKinematicsSolver::setMaxTime(const float pMaxTime)
+    {
+      fMaxTime = pMaxTime;
+    }
+
+    bool InverseKinematicsSolver::solve(const Transform& pTarget)
+    {
+      // the buffers are sized at construction
+      if (fTree->getNbJoints() != fJointValues.size())
+      {
+        throw std::invalid_argument(
+          "ALMath: InverseKinematicsSolver tree joints changed since construction.");
+      }
+      const double deadline = (fMaxTime > 0.0f) ?
+            xNow() + static_cast<double>(fMaxTime) : 0.0;
+      const std::vector<float>& values = fTree->getJointValues();
+      std::copy(values.begin(), values.end(), fJointValues.begin());
+
+      fNbIterations = 0;
+      fErrorNorm = xComputeError(pTarget);
+      while ((fErrorNorm > fTolerance) && (fNbIterations < fMaxIterations))
+      {
+        xComputeStep();
+        ++fNbIterations;
+        fErrorNorm = xComputeError(pTarget);
+
+        if ((fMaxTime > 0.0f) && (xNow() >= deadline))
+        {
+          break;
+        }
+      }
+      return fErrorNorm <= fTolerance;
+    }
+
+    unsigned int InverseKinematicsSolver::getNbIterations() const
+    {
+      return fNbIterations;
+    }
+
+    float InverseKinematicsSolver::getError() const
+    {
+      return fErrorNorm;
+    }
+
+    float InverseKinematicsSolver::xComputeError(const Transform& pTarget)
+    {
+      fEffector = fTree->getLinkTransform(fLink)*fTip;
+      const Transform relative = transformInverse(fEffector)*pTarget;
+      Velocity6D error;
+      transformLogarithmInPlace(relative, error);
+      // the geometric Jacobian gives the velocity of the effector point:
+      // the linear error is the translation to the target rather than the
+      // linear part of the logarithm, so that a partial AXIS_MASK on the
+      // position still converges to the target position.
+      fError[0] = relative.r1_c4;
+      fError[1] = relative.r2_c4;
+      fError[2] = relative.r3_c4;
+      fError[3] = error.wxd;
+      fError[4] = error.wyd;
+      fError[5] = error.wzd;
+
+      float norm = 0.0f;
+      for (unsigned int k=0; k<6; ++k)
+      {
+        fError[k] = fAxisMask.test(k) ? fWeights[k]*fError[k] : 0.0f;
+        norm += fError[k]*fError[k];
+      }
+      return sqrtf(norm);
+    }
+
+    void InverseKinematicsSolver::xComputeStep()
+    {
+      const unsigned int nbJoints = static_cast<unsigned int>(fJointValues.size());
+      if (nbJoints == 0)
+      {
+        return;
+      }
+
+      // the Jacobian of the effector, in the effector frame
+      float* J = &fJacobian[0];
+      fTree->computeJacobian(fLink, position3DFromTransform(fTip),
+                             AXIS_MASK_ALL, J);
+      changeReferenceTransposeJacobian(fEffector, J, nbJoints, J);
+
+      // the weighted rows of the controlled axes
+      const float* rows[6];
+      float e[6];
+      unsigned int nbRows = 0;
+      for (unsigned int k=0; k<6; ++k)
+      {
+        if (!fAxisMask.test(k))
+        {
+          continue;
+        }
+        float* row = J + k*nbJoints;
+        for (unsigned int j=0; j<nbJoints; ++j)
+        {
+          row[j] *= fWeights[k];
+        }
+        rows[nbRows] = row;
+        e[nbRows] = fError[k];
+        ++nbRows;
+      }
+      if (nbRows == 0)
+      {
+        return;
+      }
+
+      // (J J^t + damping^2 I) y = e
+      float A[36];
+      for (unsigned int a=0; a<nbRows; ++a)
+      {
+        for (unsigned int b=0; b<=a; ++b)
+        {
+          float dot = 0.0f;
+          for (unsigned int j=0; j<nbJoints; ++j)
+          {
+            dot += rows[a][j]*rows[b][j];
+          }
+          A[a*nbRows + b] = dot;
+          A[b*nbRows + a] = dot;
+        }
+        A[a*nbRows + a] += fDamping*fDamping;
+      }
+      xCholeskySolve(A, nbRows, e);
+
+      // dq = J^t y
+      for (unsigned int j=0; j<nbJoints; ++j)
+      {
+        float dq = 0.0f;
+        for (unsigned int a=0; a<nbRows; ++a)
+        {
+          dq += rows[a][j]*e[a];
+        }
+        fJointValues[j] += dq;
+        clipData(fMinLimits[j], fMaxLimits[j], fJointValues[j]);
+      }
+      fTree->setJointValues(&fJointValues[0]);
+    }
+
+  } // namespace Math
+} // namespace AL
@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/alkinematictree.h>
+#include <almath/tools/altransformhelpers.h>
+#include <algorithm>
+#include <stdexcept>
+
+#include "alsimd.h"
+#include "altrigbackend.h"
+
+namespace AL
+{
+  namespace Math
+  {
+    namespace
+    {
+      // The columns pJoint to pJoint + Simd::Traits<T>::WIDTH of a
+      // geometric Jacobian, from the joint axes, the joint origins and the
+      // weights of the revolute and of the prismatic part of the columns,
+      // stored as 8 arrays of pNbJoints float.
+      template <typename T>
+      inline void xJacobianColumns(
+          const float*       pData,
+          const unsigned int pNbJoints,
+          const unsigned int pJoint,
+          const T            (&pPoint)[3],
+          T                  (&pColumns)[6])
+      {
+        const float* data = pData + pJoint;
+        T a[3];
+        T r[3];
+        for (unsigned int k=0; k<3; ++k)
+        {
+          a[k] = Simd::load<T>(data + k*pNbJoints);
+          r[k] = pPoint[k] - Simd::load<T>(data + (3 + k)*pNbJoints);
+        }
+        const T revolute  = Simd::load<T>(data + 6*pNbJoints);
+        const T prismatic = Simd::load<T>(data + 7*pNbJoints);
+
+        pColumns[0] = revolute*(a[1]*r[2] - a[2]*r[1]) + prismatic*a[0];
+        pColumns[1] = revolute*(a[2]*r[0] - a[0]*r[2]) + prismatic*a[1];
+        pColumns[2] = revolute*(a[0]*r[1] - a[1]*r[0]) + prismatic*a[2];
+        pColumns[3] = revolute*a[0];
+        pColumns[4] = revolute*a[1];
+        pColumns[5] = revolute*a[2];
+      }
+    }
+
+    KinematicTree::KinematicTree():
+      fHasDirty(false)
+    {
+    }
+
+    unsigned int KinematicTree::addLink(
+      const int        pParent,
+      const Transform& pOffset,
+      const JointType  pJointType)
+    {
+      if ((pParent < -1) || (pParent >= static_cast<int>(fParents.size())))
+      {
+        throw std::invalid_argument(
+          "ALMath: KinematicTree parent must be -1 or an existing link.");
+      }
+      if ((pJointType < JOINT_FIXED) || (pJointType > JOINT_PRISMATIC_Z))
+      {
+        throw std::invalid_argument(
+          "ALMath: KinematicTree unknown joint type.");
+      }
+
+      const unsigned int link = static_cast<unsigned int>(fParents.size());
+      fParents.push_back(pParent);
+      fJointTypes.push_back(pJointType);
+      fOffsets.push_back(pOffset);
+      if (pJointType == JOINT_FIXED)
+      {
+        fJointIndexes.push_back(-1);
+      }
+      else
+      {
+        fJointIndexes.push_back(static_cast<int>(fJointLinks.size()));
+        fJointLinks.push_back(link);
+        fJointValues.push_back(0.0f);
+        fJacobianData.resize(8*fJointLinks.size());
+      }
+      fTransforms.push_back(Transform());
+      fIsDirty.push_back(1);
+      fHasDirty = true;
+      return link;
+    }
+
+    unsigned int KinematicTree::addLink(
+      const Transform& pOffset,
+      const JointType  pJointType)
+    {
+      return addLink(static_cast<int>(fParents.size()) - 1, pOffset, pJointType);
+    }
+
+    unsigned int KinematicTree::getNbLinks() const
+    {
+      return static_cast<unsigned int>(fParents.size());
+    }
+
+    unsigned int KinematicTree::getNbJoints() const
+    {
+      return static_cast<unsigned int>(fJointLinks.size());
+    }
+
+    int KinematicTree::getParent(const unsigned int pLink) const
+    {
+      xCheckLink(pLink);
+      return fParents[pLink];
+    }
+
+    JointType KinematicTree::getJointType(const unsigned int pLink) const
+    {
+      xCheckLink(pLink);
+      return fJointTypes[pLink];
+    }
+
+    int KinematicTree::getJointIndex(const unsigned int pLink) const
+    {
+      xCheckLink(pLink);
+      return fJointIndexes[pLink];
+    }
+
+    unsigned int KinematicTree::getJointLink(const unsigned int pJoint) const
+    {
+      xCheckJoint(pJoint);
+      return fJointLinks[pJoint];
+    }
+
+    void KinematicTree::setJointValue(
+      const unsigned int pJoint,
+      const float        pValue)
+    {
+      xCheckJoint(pJoint);
+      if (fJointValues[pJoint] != pValue)
+      {
+        fJointValues[pJoint] = pValue;
+        fIsDirty[fJointLinks[pJoint]] = 1;
+        fHasDirty = true;
+      }
+    }
+
+    void KinematicTree::setJointValues(const float* pValues)
+    {
+      for (unsigned int j=0; j<fJointValues.size(); ++j)
+      {
+        if (fJointValues[j] != pValues[j])
+        {
+          fJointValues[j] = pValues[j];
+          fIsDirty[fJointLinks[j]] = 1;
+          fHasDirty = true;
+        }
+      }
+    }
+
+    float KinematicTree::getJointValue(const unsigned int pJoint) const
+    {
+      xCheckJoint(pJoint);
+      return fJointValues[pJoint];
+    }
+
+    const std::vector<float>& KinematicTree::getJointValues() const
+    {
+      return fJointValues;
+    }
+
+    unsigned int KinematicTree::update()
+    {
+      if (!fHasDirty)
+      {
+        return 0;
+      }
+
+      // the parents come first, so that a single pass propagates the
+      // dirty flags to the whole subtrees
+      unsigned int nbUpdated = 0;
+      for (unsigned int i=0; i<fParents.size(); ++i)
+      {
+        const int parent = fParents[i];
+        if ((parent >= 0) && fIsDirty[parent])
+        {
+          fIsDirty[i] = 1;
+        }
+        if (!fIsDirty[i])
+        {
+          continue;
+        }
+
+        Transform& H = fTransforms[i];
+        if (parent >= 0)
+        {
+          H = fTransforms[parent]*fOffsets[i];
+        }
+        else
+        {
+          H = fOffsets[i];
+        }
+
+        const JointType type = fJointTypes[i];
+        if (type != JOINT_FIXED)
+        {
+          const float q = fJointValues[fJointIndexes[i]];
+          if (type <= JOINT_REVOLUTE_Z)
+          {
+            float s = 0.0f;
+            float c = 0.0f;
+            Trig::sinCos(q, s, c);
+            if (type == JOINT_REVOLUTE_X)
+            {
+              transformMultiplyByRotX(H, c, s);
+            }
+            else if (type == JOINT_REVOLUTE_Y)
+            {
+              transformMultiplyByRotY(H, c, s);
+            }
+            else
+            {
+              transformMultiplyByRotZ(H, c, s);
+            }
+          }
+          else if (type == JOINT_PRISMATIC_X)
+          {
+            transformMultiplyByTranslation(H, q, 0.0f, 0.0f);
+          }
+          else if (type == JOINT_PRISMATIC_Y)
+          {
+            transformMultiplyByTranslation(H, 0.0f, q, 0.0f);
+          }
+          else
+          {
+            transformMultiplyByTranslation(H, 0.0f, 0.0f, q);
+          }
+        }
+        ++nbUpdated;
+      }
+
+      std::fill(fIsDirty.begin(), fIsDirty.end(), static_cast<unsigned char>(0));
+      fHasDirty = false;
+      return nbUpdated;
+    }
+
+    const Transform& KinematicTree::getLinkTransform(const unsigned int pLink)
+    {
+      xCheckLink(pLink);
+      update();
+      return fTransforms[pLink];
+    }
+
+    const std::vector<Transform>& KinematicTree::getLinkTransforms()
+    {
+      update();
+      return fTransforms;
+    }
+
+    void KinematicTree::computeJacobian(
+      const unsigned int pLink,
+      const Position3D&  pPoint,
+      const AXIS_MASK&   pAxisMask,
+      float*             pJacobian)
+    {
+      xCheckLink(pLink);
+      update();
+
+      const unsigned int nbJoints = getNbJoints();
+      if (nbJoints == 0)
+      {
+        return;
+      }
+
+      // axis, origin and weights of each joint: the weights are zero for
+      // the joints which do not move pLink
+      float* axisX     = &fJacobianData[0];
+      float* axisY     = axisX + nbJoints;
+      float* axisZ     = axisY + nbJoints;
+      float* originX   = axisZ + nbJoints;
+      float* originY   = originX + nbJoints;
+      float* originZ   = originY + nbJoints;
+      float* revolute  = originZ + nbJoints;
+      float* prismatic = revolute + nbJoints;
+      std::fill(revolute, revolute + 2*nbJoints, 0.0f);
+      for (int link=static_cast<int>(pLink); link>=0; link=fParents[link])
+      {
+        const int joint = fJointIndexes[link];
+        if (joint < 0)
+        {
+          continue;
+        }
+        const Transform& H = fTransforms[link];
+        const JointType type = fJointTypes[link];
+        const unsigned int axis = (type <= JOINT_REVOLUTE_Z) ?
+              type - JOINT_REVOLUTE_X : type - JOINT_PRISMATIC_X;
+        const float* column = &H.r1_c1 + axis;
+        axisX[joint]   = column[0];
+        axisY[joint]   = column[4];
+        axisZ[joint]   = column[8];
+        originX[joint] = H.r1_c4;
+        originY[joint] = H.r2_c4;
+        originZ[joint] = H.r3_c4;
+        if (type <= JOINT_REVOLUTE_Z)
+        {
+          revolute[joint] = 1.0f;
+        }
+        else
+        {
+          prismatic[joint] = 1.0f;
+        }
+      }
+
+      // the rows to write, NULL for the masked ones
+      float* rows[6];
+      unsigned int nbRows = 0;
+      for (unsigned int k=0; k<6; ++k)
+      {
+        rows[k] = pAxisMask.test(k) ? pJacobian + (nbRows++)*nbJoints : NULL;
+      }
+
+      const Position3D point = fTransforms[pLink]*pPoint;
+      Simd::Pack packPoint[3] = {Simd::splat<Simd::Pack>(point.x),
+                                 Simd::splat<Simd::Pack>(point.y),
+                                 Simd::splat<Simd::Pack>(point.z)};
+      unsigned int j = 0;
+      for (; j + Simd::WIDTH <= nbJoints; j += Simd::WIDTH)
+      {
+        Simd::Pack columns[6];
+        xJacobianColumns(&fJacobianData[0], nbJoints, j, packPoint, columns);
+        for (unsigned int k=0; k<6; ++k)
+        {
+          if (rows[k] != NULL)
+          {
+            Simd::store(rows[k] + j, columns[k]);
+          }
+        }
+      }
+
+      const float floatPoint[3] = {point.x, point.y, point.z};
+      for (; j < nbJoints; ++j)
+      {
+        float columns[6];
+        xJacobianColumns(&fJacobianData[0], nbJoints, j, floatPoint, columns);
+        for (unsigned int k=0; k<6; ++k)
+        {
+          if (rows[k] != NULL)
+          {
+            rows[k][j] = columns[k];
+          }
+        }
+      }
+    }
+
+    void KinematicTree::xCheckLink(const unsigned int pLink) const
+    {
+      if (pLink >= fParents.size())
+      {
+        throw std::invalid_argument(
+          "ALMath: KinematicTree link index out of range.");
+      }
+    }
+
+    void KinematicTree::xCheckJoint(const unsigned int pJoint) const
+    {
+      if (pJoint >= fJointLinks.size())
+      {
+        throw std::invalid_argument(
+          "ALMath: KinematicTree joint index out of range.");
+      }
+    }
+
+  } // namespace Math
+} // namespace AL
@@ -291,5 +291,15 @@ namespace AL {
       return pStream;
     }
 
+    std::ostream& operator<< (std::ostream& pStream, const QuatTransform& p)
+    {
+      pStream << "{q: ";
+      pStream << p.q;
+      pStream << ", p: ";
+      pStream << p.p;
+      pStream << "}";
+      return pStream;
+    }
+
   }
 }
@@ -0,0 +1,937 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+// Private header, not installed.
+//
+// Thin layer over the SIMD instruction set selected at compile time
+// (AVX, SSE2, NEON). The batch kernels of ALMath are written once as
+// templates over the lane type: Simd::Pack processes Simd::WIDTH elements
+// at once, float processes the remaining tail of the batch (and is the only
+// lane type when ALMATH_NO_SIMD is defined or no instruction set is found).
+
+#pragma once
+#ifndef _LIBALMATH_SRC_TOOLS_ALSIMD_H_
+#define _LIBALMATH_SRC_TOOLS_ALSIMD_H_
+
+#include <cmath>
+#include <cstddef>
+
+#if !defined(ALMATH_NO_SIMD)
+# if defined(__AVX__)
+#  include <immintrin.h>
+#  define ALMATH_SIMD_AVX
+# elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#  include <emmintrin.h>
+#  define ALMATH_SIMD_SSE
+# elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#  include <arm_neon.h>
+#  define ALMATH_SIMD_NEON
+# endif
+#endif
+
+namespace AL {
+  namespace Math {
+    namespace Simd {
+
+      template <typename T>
+      struct Traits {};
+
+      template <typename T>
+      T load(const float* pIn);
+
+      template <typename T>
+      T splat(const float pVal);
+
+      /****************************
+      SCALAR LANE
+      ****************************/
+      template <>
+      struct Traits<float>
+      {
+        typedef bool Mask;
+        enum { WIDTH = 1 };
+      };
+
+      template <>
+      inline float load<float>(const float* pIn) { return *pIn; }
+
+      template <>
+      inline float splat<float>(const float pVal) { return pVal; }
+
+      inline void store(float* pOut, const float pVal) { *pOut = pVal; }
+
+      inline float sqrt(const float pA) { return sqrtf(pA); }
+      inline float rsqrt(const float pA) { return 1.0f/sqrtf(pA); }
+      inline float abs(const float pA) { return fabsf(pA); }
+      inline float floor(const float pA) { return floorf(pA); }
+      inline float min(const float pA, const float pB) { return (pA < pB) ? pA : pB; }
+      inline float max(const float pA, const float pB) { return (pA > pB) ? pA : pB; }
+
+      inline bool lessThan(const float pA, const float pB) { return pA < pB; }
+      inline bool greaterThan(const float pA, const float pB) { return pA > pB; }
+      inline bool logicalAnd(const bool pA, const bool pB) { return pA && pB; }
+      inline bool logicalOr(const bool pA, const bool pB) { return pA || pB; }
+      inline bool logicalXor(const bool pA, const bool pB) { return pA != pB; }
+      inline bool logicalNot(const bool pA) { return !pA; }
+      inline bool any(const bool pA) { return pA; }
+
+      inline float select(const bool pMask, const float pA, const float pB)
+      {
+        return pMask ? pA : pB;
+      }
+
+      /****************************
+      AVX: 8 lanes
+      ****************************/
+#if defined(ALMATH_SIMD_AVX)
+      struct Pack
+      {
+        __m256 v;
+        Pack() {}
+        Pack(const __m256 pV) : v(pV) {}
+      };
+
+      struct PackMask
+      {
+        __m256 v;
+        PackMask() {}
+        PackMask(const __m256 pV) : v(pV) {}
+      };
+
+      template <>
+      struct Traits<Pack>
+      {
+        typedef PackMask Mask;
+        enum { WIDTH = 8 };
+      };
+
+      template <>
+      inline Pack load<Pack>(const float* pIn) { return _mm256_loadu_ps(pIn); }
+
+      template <>
+      inline Pack splat<Pack>(const float pVal) { return _mm256_set1_ps(pVal); }
+
+      inline void store(float* pOut, const Pack& pVal) { _mm256_storeu_ps(pOut, pVal.v); }
+
+      inline Pack operator+ (const Pack& pA, const Pack& pB) { return _mm256_add_ps(pA.v, pB.v); }
+      inline Pack operator- (const Pack& pA, const Pack& pB) { return _mm256_sub_ps(pA.v, pB.v); }
+      inline Pack operator* (const Pack& pA, const Pack& pB) { return _mm256_mul_ps(pA.v, pB.v); }
+      inline Pack operator/ (const Pack& pA, const Pack& pB) { return _mm256_div_ps(pA.v, pB.v); }
+      inline Pack operator- (const Pack& pA) { return _mm256_xor_ps(pA.v, _mm256_set1_ps(-0.0f)); }
+
+      inline Pack sqrt(const Pack& pA) { return _mm256_sqrt_ps(pA.v); }
+      inline Pack abs(const Pack& pA) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), pA.v); }
+      inline Pack floor(const Pack& pA) { return _mm256_floor_ps(pA.v); }
+      inline Pack min(const Pack& pA, const Pack& pB) { return _mm256_min_ps(pA.v, pB.v); }
+      inline Pack max(const Pack& pA, const Pack& pB) { return _mm256_max_ps(pA.v, pB.v); }
+
+      inline Pack rsqrt(const Pack& pA)
+      {
+        // hardware estimate (12 bits) refined by one Newton-Raphson step
+        const __m256 r = _mm256_rsqrt_ps(pA.v);
+        const __m256 rar = _mm256_mul_ps(_mm256_mul_ps(pA.v, r), r);
+        return _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), r),
+                             _mm256_sub_ps(_mm256_set1_ps(3.0f), rar));
+      }
+
+      inline PackMask lessThan(const Pack& pA, const Pack& pB) { return _mm256_cmp_ps(pA.v, pB.v, _CMP_LT_OQ); }
+      inline PackMask greaterThan(const Pack& pA, const Pack& pB) { return _mm256_cmp_ps(pA.v, pB.v, _CMP_GT_OQ); }
+      inline PackMask logicalAnd(const PackMask& pA, const PackMask& pB) { return _mm256_and_ps(pA.v, pB.v); }
+      inline PackMask logicalOr(const PackMask& pA, const PackMask& pB) { return _mm256_or_ps(pA.v, pB.v); }
+      inline PackMask logicalXor(const PackMask& pA, const PackMask& pB) { return _mm256_xor_ps(pA.v, pB.v); }
+      inline PackMask logicalNot(const PackMask& pA)
+      {
+        return _mm256_xor_ps(pA.v, _mm256_castsi256_ps(_mm256_set1_epi32(-1)));
+      }
+      inline bool any(const PackMask& pA) { return _mm256_movemask_ps(pA.v) != 0; }
+
+      inline Pack select(const PackMask& pMask, const Pack& pA, const Pack& pB)
+      {
+        // not _mm256_blendv_ps: gcc folds it to a vector condition that
+        // AVX (without AVX2) cannot compare, and splits it lane by lane
+        return _mm256_or_ps(_mm256_and_ps(pMask.v, pA.v),
+                            _mm256_andnot_ps(pMask.v, pB.v));
+      }
+
+      /****************************
+      SSE2: 4 lanes
+      ****************************/
+#elif defined(ALMATH_SIMD_SSE)
+      struct Pack
+      {
+        __m128 v;
+        Pack() {}
+        Pack(const __m128 pV) : v(pV) {}
+      };
+
+      struct PackMask
+      {
+        __m128 v;
+        PackMask() {}
+        PackMask(const __m128 pV) : v(pV) {}
+      };
+
+      template <>
+      struct Traits<Pack>
+      {
+        typedef PackMask Mask;
+        enum { WIDTH = 4 };
+      };
+
+      template <>
+      inline Pack load<Pack>(const float* pIn) { return _mm_loadu_ps(pIn); }
+
+      template <>
+      inline Pack splat<Pack>(const float pVal) { return _mm_set1_ps(pVal); }
+
+      inline void store(float* pOut, const Pack& pVal) { _mm_storeu_ps(pOut, pVal.v); }
+
+      inline Pack operator+ (const Pack& pA, const Pack& pB) { return _mm_add_ps(pA.v, pB.v); }
+      inline Pack operator- (const Pack& pA, const Pack& pB) { return _mm_sub_ps(pA.v, pB.v); }
+      inline Pack operator* (const Pack& pA, const Pack& pB) { return _mm_mul_ps(pA.v, pB.v); }
+      inline Pack operator/ (const Pack& pA, const Pack& pB) { return _mm_div_ps(pA.v, pB.v); }
+      inline Pack operator- (const Pack& pA) { return _mm_xor_ps(pA.v, _mm_set1_ps(-0.0f)); }
+
+      inline Pack sqrt(const Pack& pA) { return _mm_sqrt_ps(pA.v); }
+      inline Pack abs(const Pack& pA) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), pA.v); }
+      inline Pack min(const Pack& pA, const Pack& pB) { return _mm_min_ps(pA.v, pB.v); }
+      inline Pack max(const Pack& pA, const Pack& pB) { return _mm_max_ps(pA.v, pB.v); }
+
+      inline Pack floor(const Pack& pA)
+      {
+        // truncation, then correct the negative non integer values.
+        // Only valid for |pA| < 2^31, which is all we need for angles.
+        const __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(pA.v));
+        return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, pA.v), _mm_set1_ps(1.0f)));
+      }
+
+      inline Pack rsqrt(const Pack& pA)
+      {
+        // hardware estimate (12 bits) refined by one Newton-Raphson step
+        const __m128 r = _mm_rsqrt_ps(pA.v);
+        const __m128 rar = _mm_mul_ps(_mm_mul_ps(pA.v, r), r);
+        return _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), r),
+                          _mm_sub_ps(_mm_set1_ps(3.0f), rar));
+      }
+
+      inline PackMask lessThan(const Pack& pA, const Pack& pB) { return _mm_cmplt_ps(pA.v, pB.v); }
+      inline PackMask greaterThan(const Pack& pA, const Pack& pB) { return _mm_cmpgt_ps(pA.v, pB.v); }
+      inline PackMask logicalAnd(const PackMask& pA, const PackMask& pB) { return _mm_and_ps(pA.v, pB.v); }
+      inline PackMask logicalOr(const PackMask& pA, const PackMask& pB) { return _mm_or_ps(pA.v, pB.v); }
+      inline PackMask logicalXor(const PackMask& pA, const PackMask& pB) { return _mm_xor_ps(pA.v, pB.v); }
+      inline PackMask logicalNot(const PackMask& pA)
+      {
+        return _mm_xor_ps(pA.v, _mm_castsi128_ps(_mm_set1_epi32(-1)));
+      }
+      inline bool any(const PackMask& pA) { return _mm_movemask_ps(pA.v) != 0; }
+
+      inline Pack select(const PackMask& pMask, const Pack& pA, const Pack& pB)
+      {
+        return _mm_or_ps(_mm_and_ps(pMask.v, pA.v), _mm_andnot_ps(pMask.v, pB.v));
+      }
+
+      /****************************
+      NEON: 4 lanes
+      ****************************/
+#elif defined(ALMATH_SIMD_NEON)
+      struct Pack
+      {
+        float32x4_t v;
+        Pack() {}
+        Pack(const float32x4_t pV) : v(pV) {}
+      };
+
+      struct PackMask
+      {
+        uint32x4_t v;
+        PackMask() {}
+        PackMask(const uint32x4_t pV) : v(pV) {}
+      };
+
+      template <>
+      struct Traits<Pack>
+      {
+        typedef PackMask Mask;
+        enum { WIDTH = 4 };
+      };
+
+      template <>
+      inline Pack load<Pack>(const float* pIn) { return vld1q_f32(pIn); }
+
+      template <>
+      inline Pack splat<Pack>(const float pVal) { return vdupq_n_f32(pVal); }
+
+      inline void store(float* pOut, const Pack& pVal) { vst1q_f32(pOut, pVal.v); }
+
+      inline Pack operator+ (const Pack& pA, const Pack& pB) { return vaddq_f32(pA.v, pB.v); }
+      inline Pack operator- (const Pack& pA, const Pack& pB) { return vsubq_f32(pA.v, pB.v); }
+      inline Pack operator* (const Pack& pA, const Pack& pB) { return vmulq_f32(pA.v, pB.v); }
+      inline Pack operator- (const Pack& pA) { return vnegq_f32(pA.v); }
+
+      inline Pack operator/ (const Pack& pA, const Pack& pB)
+      {
+# if defined(__aarch64__)
+        return vdivq_f32(pA.v, pB.v);
+# else
+        // reciprocal estimate refined by two Newton-Raphson steps
+        float32x4_t r = vrecpeq_f32(pB.v);
+        r = vmulq_f32(vrecpsq_f32(pB.v, r), r);
+        r = vmulq_f32(vrecpsq_f32(pB.v, r), r);
+        return vmulq_f32(pA.v, r);
+# endif
+      }
+
+      inline Pack rsqrt(const Pack& pA)
+      {
+        float32x4_t r = vrsqrteq_f32(pA.v);
+        r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(pA.v, r), r), r);
+        return vmulq_f32(vrsqrtsq_f32(vmulq_f32(pA.v, r), r), r);
+      }
+
+      inline Pack sqrt(const Pack& pA)
+      {
+# if defined(__aarch64__)
+        return vsqrtq_f32(pA.v);
+# else
+        // sqrt(a) = a * rsqrt(a), forced to 0 where rsqrt(0) is infinite
+        const uint32x4_t isZero = vceqq_f32(pA.v, vdupq_n_f32(0.0f));
+        return vbslq_f32(isZero, vdupq_n_f32(0.0f), vmulq_f32(pA.v, rsqrt(pA).v));
+# endif
+      }
+
+      inline Pack abs(const Pack& pA) { return vabsq_f32(pA.v); }
+      inline Pack min(const Pack& pA, const Pack& pB) { return vminq_f32(pA.v, pB.v); }
+      inline Pack max(const Pack& pA, const Pack& pB) { return vmaxq_f32(pA.v, pB.v); }
+
+      inline Pack floor(const Pack& pA)
+      {
+# if defined(__aarch64__)
+        return vrndmq_f32(pA.v);
+# else
+        const float32x4_t t = vcvtq_f32_s32(vcvtq_s32_f32(pA.v));
+        const uint32x4_t greater = vcgtq_f32(t, pA.v);
+        return vsubq_f32(t, vbslq_f32(greater, vdupq_n_f32(1.0f), vdupq_n_f32(0.0f)));
+# endif
+      }
+
+      inline PackMask lessThan(const Pack& pA, const Pack& pB) { return vcltq_f32(pA.v, pB.v); }
+      inline PackMask greaterThan(const Pack& pA, const Pack& pB) { return vcgtq_f32(pA.v, pB.v); }
+      inline PackMask logicalAnd(const PackMask& pA, const PackMask& pB) { return vandq_u32(pA.v, pB.v); }
+      inline PackMask logicalOr(const PackMask& pA, const PackMask& pB) { return vorrq_u32(pA.v, pB.v); }
+      inline PackMask logicalXor(const PackMask& pA, const PackMask& pB) { return veorq_u32(pA.v, pB.v); }
+      inline PackMask logicalNot(const PackMask& pA) { return vmvnq_u32(pA.v); }
+      inline bool any(const PackMask& pA)
+      {
+        const uint32x2_t r = vorr_u32(vget_low_u32(pA.v), vget_high_u32(pA.v));
+        return (vget_lane_u32(r, 0) | vget_lane_u32(r, 1)) != 0;
+      }
+
+      inline Pack select(const PackMask& pMask, const Pack& pA, const Pack& pB)
+      {
+        return vbslq_f32(pMask.v, pA.v, pB.v);
+      }
+
+      /****************************
+      NO INSTRUCTION SET
+      ****************************/
+#else
+      typedef float Pack;
+#endif
+
+      /// Number of elements processed by one Pack.
+      static const std::size_t WIDTH = Traits<Pack>::WIDTH;
+
+      /****************************
+      TRIGONOMETRY
+      ****************************/
+      // Compute sin and cos together. The angle is reduced to
+      // [-pi/4, pi/4] (three parts Cody-Waite reduction, valid for
+      // |pAngle| < 8192) and evaluated with the minimax polynomials of
+      // Cephes. Max absolute error: 2.0e-7 on [-100, 100].
+      template <typename T>
+      inline void sinCos(
+        const T& pAngle,
+        T&       pSin,
+        T&       pCos)
+      {
+        typedef typename Traits<T>::Mask Mask;
+
+        // quadrant: q = round(pAngle/(pi/2))
+        const T q = floor(pAngle*splat<T>(0.636619772367581343f) + splat<T>(0.5f));
+        T r = pAngle - q*splat<T>(1.5703125f);
+        r = r - q*splat<T>(4.837512969970703125e-4f);
+        r = r - q*splat<T>(7.54978995489188216e-8f);
+
+        const T r2 = r*r;
+        const T s = ((splat<T>(-1.9515295891e-4f)*r2 +
+                      splat<T>(8.3321608736e-3f))*r2 +
+                     splat<T>(-1.6666654611e-1f))*r2*r + r;
+        const T c = ((splat<T>(2.443315711809948e-5f)*r2 +
+                      splat<T>(-1.388731625493765e-3f))*r2 +
+                     splat<T>(4.166664568298827e-2f))*r2*r2 -
+            splat<T>(0.5f)*r2 + splat<T>(1.0f);
+
+        // bit 0 and bit 1 of q, computed with exact float operations
+        const T half = q*splat<T>(0.5f);
+        const T halfFloor = floor(half);
+        const Mask odd = greaterThan(half - halfFloor, splat<T>(0.25f));
+        const T quarter = halfFloor*splat<T>(0.5f);
+        const Mask upper = greaterThan(quarter - floor(quarter), splat<T>(0.25f));
+
+        const T sinAbs = select(odd, c, s);
+        const T cosAbs = select(odd, s, c);
+        pSin = select(upper, -sinAbs, sinAbs);
+        pCos = select(logicalXor(upper, odd), -cosAbs, cosAbs);
+      }
+
+      // Scalar version of sinCos: the quadrant is computed with integer
+      // operations instead of floor, which is a libm call without SSE4.1.
+      inline void sinCos(
+        const float& pAngle,
+        float&       pSin,
+        float&       pCos)
+      {
+        const float fq = pAngle*0.636619772367581343f;
+        const int q = static_cast<int>(fq + ((fq < 0.0f) ? -0.5f : 0.5f));
+        const float qf = static_cast<float>(q);
+        float r = pAngle - qf*1.5703125f;
+        r = r - qf*4.837512969970703125e-4f;
+        r = r - qf*7.54978995489188216e-8f;
+
+        const float r2 = r*r;
+        const float s = ((-1.9515295891e-4f*r2 + 8.3321608736e-3f)*r2 +
+                         -1.6666654611e-1f)*r2*r + r;
+        const float c = ((2.443315711809948e-5f*r2 + -1.388731625493765e-3f)*r2 +
+                         4.166664568298827e-2f)*r2*r2 - 0.5f*r2 + 1.0f;
+
+        switch (q & 3)
+        {
+        case 0: pSin = s;  pCos = c;  break;
+        case 1: pSin = c;  pCos = -s; break;
+        case 2: pSin = -s; pCos = -c; break;
+        default: pSin = -c; pCos = s; break;
+        }
+      }
+
+      // Four quadrant arc tangent. The ratio is reduced to [0, 1] and
+      // evaluated with a degree 15 odd minimax polynomial.
+      // Max absolute error: 4.0e-7 rad. Return 0 for atan2(0, 0).
+      template <typename T>
+      inline T atan2(
+        const T& pY,
+        const T& pX)
+      {
+        const T zero = splat<T>(0.0f);
+        const T ax = abs(pX);
+        const T ay = abs(pY);
+        const T num = min(ax, ay);
+        const T den = max(ax, ay);
+
+        const T a = num/select(greaterThan(den, zero), den, splat<T>(1.0f));
+        const T s = a*a;
+        T r = (((((((splat<T>(-0.00405678599f)*s +
+                     splat<T>(0.0218712039f))*s +
+                    splat<T>(-0.0559245605f))*s +
+                   splat<T>(0.0964311907f))*s +
+                  splat<T>(-0.13909f))*s +
+                 splat<T>(0.199466416f))*s +
+                splat<T>(-0.333298676f))*s +
+               splat<T>(0.999999337f))*a;
+
+        r = select(greaterThan(ay, ax), splat<T>(1.57079632679489661923f) - r, r);
+        r = select(lessThan(pX, zero), splat<T>(3.14159265358979323846f) - r, r);
+        return select(lessThan(pY, zero), -r, r);
+      }
+
+      /****************************
+      ARRAY OF STRUCTURES ACCESS
+      ****************************/
+      // Load one lane from each of the WIDTH structures starting at pIn,
+      // pStride floats apart.
+      template <typename T>
+      inline T gather(
+        const float*      pIn,
+        const std::size_t pStride)
+      {
+        float lanes[Traits<T>::WIDTH];
+        for (std::size_t i=0; i<static_cast<std::size_t>(Traits<T>::WIDTH); ++i)
+        {
+          lanes[i] = pIn[i*pStride];
+        }
+        return load<T>(lanes);
+      }
+
+      template <typename T>
+      inline void scatter(
+        float*            pOut,
+        const std::size_t pStride,
+        const T&          pVal)
+      {
+        float lanes[Traits<T>::WIDTH];
+        store(lanes, pVal);
+        for (std::size_t i=0; i<static_cast<std::size_t>(Traits<T>::WIDTH); ++i)
+        {
+          pOut[i*pStride] = lanes[i];
+        }
+      }
+
+      // Load the WIDTH structures of 4 float stored contiguously at pIn,
+      // one member per lane type. The SIMD versions transpose 4x4 blocks
+      // and may permute the structures among the lanes: store4 undoes the
+      // same permutation, so use them only for lane-wise computations.
+      template <typename T>
+      inline void load4(
+        const float* pIn,
+        T&           pA,
+        T&           pB,
+        T&           pC,
+        T&           pD)
+      {
+        pA = gather<T>(pIn + 0, 4);
+        pB = gather<T>(pIn + 1, 4);
+        pC = gather<T>(pIn + 2, 4);
+        pD = gather<T>(pIn + 3, 4);
+      }
+
+      template <typename T>
+      inline void store4(
+        float*   pOut,
+        const T& pA,
+        const T& pB,
+        const T& pC,
+        const T& pD)
+      {
+        scatter(pOut + 0, 4, pA);
+        scatter(pOut + 1, 4, pB);
+        scatter(pOut + 2, 4, pC);
+        scatter(pOut + 3, 4, pD);
+      }
+
+      // Load the 4 first float of the WIDTH structures starting at pIn,
+      // pStride float apart, one member per lane type. Unlike load4, the
+      // lanes keep the order of the structures.
+      template <typename T>
+      inline void gather4(
+        const float*      pIn,
+        const std::size_t pStride,
+        T&                pA,
+        T&                pB,
+        T&                pC,
+        T&                pD)
+      {
+        pA = gather<T>(pIn + 0, pStride);
+        pB = gather<T>(pIn + 1, pStride);
+        pC = gather<T>(pIn + 2, pStride);
+        pD = gather<T>(pIn + 3, pStride);
+      }
+
+      template <typename T>
+      inline void scatter4(
+        float*            pOut,
+        const std::size_t pStride,
+        const T&          pA,
+        const T&          pB,
+        const T&          pC,
+        const T&          pD)
+      {
+        scatter(pOut + 0, pStride, pA);
+        scatter(pOut + 1, pStride, pB);
+        scatter(pOut + 2, pStride, pC);
+        scatter(pOut + 3, pStride, pD);
+      }
+
+      // Load the WIDTH structures of 3 float stored contiguously at pIn,
+      // one member per lane type, keeping the order of the structures.
+      template <typename T>
+      inline void load3(
+        const float* pIn,
+        T&           pA,
+        T&           pB,
+        T&           pC)
+      {
+        pA = gather<T>(pIn + 0, 3);
+        pB = gather<T>(pIn + 1, 3);
+        pC = gather<T>(pIn + 2, 3);
+      }
+
+      template <typename T>
+      inline void store3(
+        float*   pOut,
+        const T& pA,
+        const T& pB,
+        const T& pC)
+      {
+        scatter(pOut + 0, 3, pA);
+        scatter(pOut + 1, 3, pB);
+        scatter(pOut + 2, 3, pC);
+      }
+
+#if defined(ALMATH_SIMD_AVX) || defined(ALMATH_SIMD_SSE)
+      // De-interleave 4 structures of 3 float:
+      // pA = [x0 y0 z0 x1], pB = [y1 z1 x2 y2], pC = [z2 x3 y3 z3]
+      // become [x0 x1 x2 x3], [y0 y1 y2 y3] and [z0 z1 z2 z3].
+      inline void xDeinterleave3(__m128& pA, __m128& pB, __m128& pC)
+      {
+        const __m128 t0 = _mm_shuffle_ps(pB, pC, _MM_SHUFFLE(2, 1, 3, 2));
+        const __m128 t1 = _mm_shuffle_ps(pA, pB, _MM_SHUFFLE(1, 0, 2, 1));
+        const __m128 x = _mm_shuffle_ps(pA, t0, _MM_SHUFFLE(2, 0, 3, 0));
+        const __m128 y = _mm_shuffle_ps(t1, t0, _MM_SHUFFLE(3, 1, 2, 0));
+        const __m128 z = _mm_shuffle_ps(t1, pC, _MM_SHUFFLE(3, 0, 3, 1));
+        pA = x;
+        pB = y;
+        pC = z;
+      }
+
+      // Inverse of xDeinterleave3.
+      inline void xInterleave3(__m128& pA, __m128& pB, __m128& pC)
+      {
+        const __m128 xyLo = _mm_unpacklo_ps(pA, pB);
+        const __m128 xyHi = _mm_unpackhi_ps(pA, pB);
+        const __m128 z0x1 = _mm_shuffle_ps(pC, xyLo, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128 y1z1 = _mm_shuffle_ps(xyLo, pC, _MM_SHUFFLE(1, 1, 3, 3));
+        const __m128 z2x3 = _mm_shuffle_ps(pC, xyHi, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m128 y3z3 = _mm_shuffle_ps(xyHi, pC, _MM_SHUFFLE(3, 3, 3, 3));
+        pA = _mm_shuffle_ps(xyLo, z0x1, _MM_SHUFFLE(2, 0, 1, 0));
+        pB = _mm_shuffle_ps(y1z1, xyHi, _MM_SHUFFLE(1, 0, 2, 0));
+        pC = _mm_shuffle_ps(z2x3, y3z3, _MM_SHUFFLE(2, 0, 2, 0));
+      }
+#endif
+
+#if defined(ALMATH_SIMD_AVX)
+      // build the register from the lanes instead of reloading a stack
+      // copy, which would stall on the store forwarding
+      template <>
+      inline Pack gather<Pack>(const float* pIn, const std::size_t pStride)
+      {
+        return _mm256_setr_ps(pIn[0], pIn[pStride], pIn[2*pStride],
+                              pIn[3*pStride], pIn[4*pStride], pIn[5*pStride],
+                              pIn[6*pStride], pIn[7*pStride]);
+      }
+
+      template <>
+      inline void scatter<Pack>(
+        float*            pOut,
+        const std::size_t pStride,
+        const Pack&       pVal)
+      {
+        const __m128 lo = _mm256_castps256_ps128(pVal.v);
+        const __m128 hi = _mm256_extractf128_ps(pVal.v, 1);
+        _mm_store_ss(pOut, lo);
+        _mm_store_ss(pOut + pStride, _mm_shuffle_ps(lo, lo, 1));
+        _mm_store_ss(pOut + 2*pStride, _mm_movehl_ps(lo, lo));
+        _mm_store_ss(pOut + 3*pStride, _mm_shuffle_ps(lo, lo, 3));
+        _mm_store_ss(pOut + 4*pStride, hi);
+        _mm_store_ss(pOut + 5*pStride, _mm_shuffle_ps(hi, hi, 1));
+        _mm_store_ss(pOut + 6*pStride, _mm_movehl_ps(hi, hi));
+        _mm_store_ss(pOut + 7*pStride, _mm_shuffle_ps(hi, hi, 3));
+      }
+
+      // 4x4 transpose in each 128 bits half: the first half gets the
+      // structures 0, 2, 4, 6 and the second half 1, 3, 5, 7.
+      inline void xTranspose4(__m256& pA, __m256& pB, __m256& pC, __m256& pD)
+      {
+        const __m256 t0 = _mm256_unpacklo_ps(pA, pB);
+        const __m256 t1 = _mm256_unpackhi_ps(pA, pB);
+        const __m256 t2 = _mm256_unpacklo_ps(pC, pD);
+        const __m256 t3 = _mm256_unpackhi_ps(pC, pD);
+        pA = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        pB = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        pC = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        pD = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+      }
+
+      inline void load4(const float* pIn, Pack& pA, Pack& pB, Pack& pC, Pack& pD)
+      {
+        __m256 a = _mm256_loadu_ps(pIn);
+        __m256 b = _mm256_loadu_ps(pIn + 8);
+        __m256 c = _mm256_loadu_ps(pIn + 16);
+        __m256 d = _mm256_loadu_ps(pIn + 24);
+        xTranspose4(a, b, c, d);
+        pA = a;
+        pB = b;
+        pC = c;
+        pD = d;
+      }
+
+      inline void store4(float* pOut, const Pack& pA, const Pack& pB,
+                         const Pack& pC, const Pack& pD)
+      {
+        __m256 a = pA.v;
+        __m256 b = pB.v;
+        __m256 c = pC.v;
+        __m256 d = pD.v;
+        xTranspose4(a, b, c, d);
+        _mm256_storeu_ps(pOut, a);
+        _mm256_storeu_ps(pOut + 8, b);
+        _mm256_storeu_ps(pOut + 16, c);
+        _mm256_storeu_ps(pOut + 24, d);
+      }
+
+      inline void gather4(const float* pIn, const std::size_t pStride,
+                          Pack& pA, Pack& pB, Pack& pC, Pack& pD)
+      {
+        // structure i in the first half and i + 4 in the second one,
+        // so that the transpose keeps them in order
+        __m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(
+            _mm_loadu_ps(pIn)), _mm_loadu_ps(pIn + 4*pStride), 1);
+        __m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(
+            _mm_loadu_ps(pIn + pStride)), _mm_loadu_ps(pIn + 5*pStride), 1);
+        __m256 c = _mm256_insertf128_ps(_mm256_castps128_ps256(
+            _mm_loadu_ps(pIn + 2*pStride)), _mm_loadu_ps(pIn + 6*pStride), 1);
+        __m256 d = _mm256_insertf128_ps(_mm256_castps128_ps256(
+            _mm_loadu_ps(pIn + 3*pStride)), _mm_loadu_ps(pIn + 7*pStride), 1);
+        xTranspose4(a, b, c, d);
+        pA = a;
+        pB = b;
+        pC = c;
+        pD = d;
+      }
+
+      inline void scatter4(float* pOut, const std::size_t pStride,
+                           const Pack& pA, const Pack& pB,
+                           const Pack& pC, const Pack& pD)
+      {
+        __m256 a = pA.v;
+        __m256 b = pB.v;
+        __m256 c = pC.v;
+        __m256 d = pD.v;
+        xTranspose4(a, b, c, d);
+        _mm_storeu_ps(pOut, _mm256_castps256_ps128(a));
+        _mm_storeu_ps(pOut + pStride, _mm256_castps256_ps128(b));
+        _mm_storeu_ps(pOut + 2*pStride, _mm256_castps256_ps128(c));
+        _mm_storeu_ps(pOut + 3*pStride, _mm256_castps256_ps128(d));
+        _mm_storeu_ps(pOut + 4*pStride, _mm256_extractf128_ps(a, 1));
+        _mm_storeu_ps(pOut + 5*pStride, _mm256_extractf128_ps(b, 1));
+        _mm_storeu_ps(pOut + 6*pStride, _mm256_extractf128_ps(c, 1));
+        _mm_storeu_ps(pOut + 7*pStride, _mm256_extractf128_ps(d, 1));
+      }
+
+      inline void load3(const float* pIn, Pack& pA, Pack& pB, Pack& pC)
+      {
+        __m128 a0 = _mm_loadu_ps(pIn);
+        __m128 b0 = _mm_loadu_ps(pIn + 4);
+        __m128 c0 = _mm_loadu_ps(pIn + 8);
+        __m128 a1 = _mm_loadu_ps(pIn + 12);
+        __m128 b1 = _mm_loadu_ps(pIn + 16);
+        __m128 c1 = _mm_loadu_ps(pIn + 20);
+        xDeinterleave3(a0, b0, c0);
+        xDeinterleave3(a1, b1, c1);
+        pA = _mm256_insertf128_ps(_mm256_castps128_ps256(a0), a1, 1);
+        pB = _mm256_insertf128_ps(_mm256_castps128_ps256(b0), b1, 1);
+        pC = _mm256_insertf128_ps(_mm256_castps128_ps256(c0), c1, 1);
+      }
+
+      inline void store3(float* pOut, const Pack& pA, const Pack& pB,
+                         const Pack& pC)
+      {
+        __m128 a0 = _mm256_castps256_ps128(pA.v);
+        __m128 b0 = _mm256_castps256_ps128(pB.v);
+        __m128 c0 = _mm256_castps256_ps128(pC.v);
+        __m128 a1 = _mm256_extractf128_ps(pA.v, 1);
+        __m128 b1 = _mm256_extractf128_ps(pB.v, 1);
+        __m128 c1 = _mm256_extractf128_ps(pC.v, 1);
+        xInterleave3(a0, b0, c0);
+        xInterleave3(a1, b1, c1);
+        _mm_storeu_ps(pOut, a0);
+        _mm_storeu_ps(pOut + 4, b0);
+        _mm_storeu_ps(pOut + 8, c0);
+        _mm_storeu_ps(pOut + 12, a1);
+        _mm_storeu_ps(pOut + 16, b1);
+        _mm_storeu_ps(pOut + 20, c1);
+      }
+#elif defined(ALMATH_SIMD_SSE)
+      template <>
+      inline Pack gather<Pack>(const float* pIn, const std::size_t pStride)
+      {
+        return _mm_setr_ps(pIn[0], pIn[pStride], pIn[2*pStride],
+                           pIn[3*pStride]);
+      }
+
+      template <>
+      inline void scatter<Pack>(
+        float*            pOut,
+        const std::size_t pStride,
+        const Pack&       pVal)
+      {
+        const __m128 v = pVal.v;
+        _mm_store_ss(pOut, v);
+        _mm_store_ss(pOut + pStride, _mm_shuffle_ps(v, v, 1));
+        _mm_store_ss(pOut + 2*pStride, _mm_movehl_ps(v, v));
+        _mm_store_ss(pOut + 3*pStride, _mm_shuffle_ps(v, v, 3));
+      }
+
+      inline void load4(const float* pIn, Pack& pA, Pack& pB, Pack& pC, Pack& pD)
+      {
+        __m128 a = _mm_loadu_ps(pIn);
+        __m128 b = _mm_loadu_ps(pIn + 4);
+        __m128 c = _mm_loadu_ps(pIn + 8);
+        __m128 d = _mm_loadu_ps(pIn + 12);
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+        pA = a;
+        pB = b;
+        pC = c;
+        pD = d;
+      }
+
+      inline void store4(float* pOut, const Pack& pA, const Pack& pB,
+                         const Pack& pC, const Pack& pD)
+      {
+        __m128 a = pA.v;
+        __m128 b = pB.v;
+        __m128 c = pC.v;
+        __m128 d = pD.v;
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+        _mm_storeu_ps(pOut, a);
+        _mm_storeu_ps(pOut + 4, b);
+        _mm_storeu_ps(pOut + 8, c);
+        _mm_storeu_ps(pOut + 12, d);
+      }
+
+      inline void gather4(const float* pIn, const std::size_t pStride,
+                          Pack& pA, Pack& pB, Pack& pC, Pack& pD)
+      {
+        __m128 a = _mm_loadu_ps(pIn);
+        __m128 b = _mm_loadu_ps(pIn + pStride);
+        __m128 c = _mm_loadu_ps(pIn + 2*pStride);
+        __m128 d = _mm_loadu_ps(pIn + 3*pStride);
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+        pA = a;
+        pB = b;
+        pC = c;
+        pD = d;
+      }
+
+      inline void scatter4(float* pOut, const std::size_t pStride,
+                           const Pack& pA, const Pack& pB,
+                           const Pack& pC, const Pack& pD)
+      {
+        __m128 a = pA.v;
+        __m128 b = pB.v;
+        __m128 c = pC.v;
+        __m128 d = pD.v;
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+        _mm_storeu_ps(pOut, a);
+        _mm_storeu_ps(pOut + pStride, b);
+        _mm_storeu_ps(pOut + 2*pStride, c);
+        _mm_storeu_ps(pOut + 3*pStride, d);
+      }
+
+      inline void load3(const float* pIn, Pack& pA, Pack& pB, Pack& pC)
+      {
+        __m128 a = _mm_loadu_ps(pIn);
+        __m128 b = _mm_loadu_ps(pIn + 4);
+        __m128 c = _mm_loadu_ps(pIn + 8);
+        xDeinterleave3(a, b, c);
+        pA = a;
+        pB = b;
+        pC = c;
+      }
+
+      inline void store3(float* pOut, const Pack& pA, const Pack& pB,
+                         const Pack& pC)
+      {
+        __m128 a = pA.v;
+        __m128 b = pB.v;
+        __m128 c = pC.v;
+        xInterleave3(a, b, c);
+        _mm_storeu_ps(pOut, a);
+        _mm_storeu_ps(pOut + 4, b);
+        _mm_storeu_ps(pOut + 8, c);
+      }
+#elif defined(ALMATH_SIMD_NEON)
+      template <>
+      inline Pack gather<Pack>(const float* pIn, const std::size_t pStride)
+      {
+        float32x4_t v = vdupq_n_f32(pIn[0]);
+        v = vsetq_lane_f32(pIn[pStride], v, 1);
+        v = vsetq_lane_f32(pIn[2*pStride], v, 2);
+        v = vsetq_lane_f32(pIn[3*pStride], v, 3);
+        return v;
+      }
+
+      inline void load4(const float* pIn, Pack& pA, Pack& pB, Pack& pC, Pack& pD)
+      {
+        const float32x4x4_t v = vld4q_f32(pIn);
+        pA = v.val[0];
+        pB = v.val[1];
+        pC = v.val[2];
+        pD = v.val[3];
+      }
+
+      inline void store4(float* pOut, const Pack& pA, const Pack& pB,
+                         const Pack& pC, const Pack& pD)
+      {
+        float32x4x4_t v;
+        v.val[0] = pA.v;
+        v.val[1] = pB.v;
+        v.val[2] = pC.v;
+        v.val[3] = pD.v;
+        vst4q_f32(pOut, v);
+      }
+
+      inline void xTranspose4(float32x4_t& pA, float32x4_t& pB,
+                              float32x4_t& pC, float32x4_t& pD)
+      {
+        const float32x4x2_t t0 = vtrnq_f32(pA, pB);
+        const float32x4x2_t t1 = vtrnq_f32(pC, pD);
+        pA = vcombine_f32(vget_low_f32(t0.val[0]), vget_low_f32(t1.val[0]));
+        pB = vcombine_f32(vget_low_f32(t0.val[1]), vget_low_f32(t1.val[1]));
+        pC = vcombine_f32(vget_high_f32(t0.val[0]), vget_high_f32(t1.val[0]));
+        pD = vcombine_f32(vget_high_f32(t0.val[1]), vget_high_f32(t1.val[1]));
+      }
+
+      inline void gather4(const float* pIn, const std::size_t pStride,
+                          Pack& pA, Pack& pB, Pack& pC, Pack& pD)
+      {
+        float32x4_t a = vld1q_f32(pIn);
+        float32x4_t b = vld1q_f32(pIn + pStride);
+        float32x4_t c = vld1q_f32(pIn + 2*pStride);
+        float32x4_t d = vld1q_f32(pIn + 3*pStride);
+        xTranspose4(a, b, c, d);
+        pA = a;
+        pB = b;
+        pC = c;
+        pD = d;
+      }
+
+      inline void scatter4(float* pOut, const std::size_t pStride,
+                           const Pack& pA, const Pack& pB,
+                           const Pack& pC, const Pack& pD)
+      {
+        float32x4_t a = pA.v;
+        float32x4_t b = pB.v;
+        float32x4_t c = pC.v;
+        float32x4_t d = pD.v;
+        xTranspose4(a, b, c, d);
+        vst1q_f32(pOut, a);
+        vst1q_f32(pOut + pStride, b);
+        vst1q_f32(pOut + 2*pStride, c);
+        vst1q_f32(pOut + 3*pStride, d);
+      }
+
+      inline void load3(const float* pIn, Pack& pA, Pack& pB, Pack& pC)
+      {
+        const float32x4x3_t v = vld3q_f32(pIn);
+        pA = v.val[0];
+        pB = v.val[1];
+        pC = v.val[2];
+      }
+
+      inline void store3(float* pOut, const Pack& pA, const Pack& pB,
+                         const Pack& pC)
+      {
+        float32x4x3_t v;
+        v.val[0] = pA.v;
+        v.val[1] = pB.v;
+        v.val[2] = pC.v;
+        vst3q_f32(pOut, v);
+      }
+#endif
+
+    } // namespace Simd
+  } // namespace Math
+} // namespace AL
+#endif  // _LIBALMATH_SRC_TOOLS_ALSIMD_H_
@@ -4,13 +4,18 @@
  * found in the COPYING file.
  */
 
+#include <algorithm>
 #include <cmath>
 
 #include <almath/tools/altransformhelpers.h>
+#include <almath/types/alarithmetic.h>
 #include <stdexcept>
 #include <almath/tools/altrigonometry.h>
 #include <almath/tools/almathio.h>
 
+#include "alsimd.h"
+#include "altrigbackend.h"
+
 namespace AL {
   namespace Math {
 
@@ -251,6 +256,236 @@ namespace AL {
     }
 
 
+    /****************************
+    BATCH
+    ****************************/
+    // <summary> Logarithm of the Simd::Traits<T>::WIDTH Transform at pT. </summary>
+    // Branch free version of transformLogarithmInPlace: every case is
+    // computed and the result of each lane is selected with masks.
+    template <typename T>
+    inline void xTransformLogarithm(
+        const Transform* pT,
+        Velocity6D*      pVOut)
+    {
+      typedef typename Simd::Traits<T>::Mask Mask;
+      const std::size_t stride = sizeof(Transform)/sizeof(float);
+      const float* in = &pT->r1_c1;
+
+      const T r11 = Simd::gather<T>(in + 0, stride);
+      const T r12 = Simd::gather<T>(in + 1, stride);
+      const T r13 = Simd::gather<T>(in + 2, stride);
+      const T p1  = Simd::gather<T>(in + 3, stride);
+      const T r21 = Simd::gather<T>(in + 4, stride);
+      const T r22 = Simd::gather<T>(in + 5, stride);
+      const T r23 = Simd::gather<T>(in + 6, stride);
+      const T p2  = Simd::gather<T>(in + 7, stride);
+      const T r31 = Simd::gather<T>(in + 8, stride);
+      const T r32 = Simd::gather<T>(in + 9, stride);
+      const T r33 = Simd::gather<T>(in + 10, stride);
+      const T p3  = Simd::gather<T>(in + 11, stride);
+
+      const T zero    = Simd::splat<T>(0.0f);
+      const T one     = Simd::splat<T>(1.0f);
+      const T half    = Simd::splat<T>(0.5f);
+      const T epsilon = Simd::splat<T>(0.001f);
+
+      const T d1 = r32 - r23;
+      const T d2 = r13 - r31;
+      const T d3 = r21 - r12;
+
+      const T si = half*Simd::sqrt(d1*d1 + d2*d2 + d3*d3);
+      const T co = half*(r11 + r22 + r33 - one);
+      const T angle = Simd::atan2(si, co);
+
+      const Mask small    = Simd::lessThan(si, epsilon);
+      const Mask nearZero = Simd::greaterThan(co, one - epsilon);
+      const Mask nearPi   = Simd::logicalAnd(
+            small, Simd::lessThan(co, epsilon - one));
+
+      // si < epsilon and co far from +1: the rotation part is not handled
+      // by the scalar version either, the rotation is then considered null.
+      T coeff = angle/(si + si + Simd::select(small, epsilon, zero));
+      coeff = Simd::select(
+            Simd::logicalAnd(small, Simd::logicalNot(nearZero)), zero, coeff);
+
+      const T lambda = Simd::select(
+            Simd::lessThan(angle, epsilon),
+            Simd::splat<T>(1.0f/12.0f),
+            Simd::select(
+              Simd::greaterThan(angle, Simd::splat<T>(PI) - epsilon),
+              Simd::splat<T>(0.101f),
+              half*(si + si - angle*(one + co))/(angle*angle*si)));
+
+      const T c2 = coeff*coeff*lambda;
+      const T c1 = half*coeff;
+
+      T wxd = coeff*d1;
+      T wyd = coeff*d2;
+      T wzd = coeff*d3;
+
+      T xd = p2*(c2*d2*d1 + c1*d3) +
+             p3*(c2*d3*d1 - c1*d2) +
+             p1*(one - c2*(d2*d2 + d3*d3));
+
+      T yd = p2*(one - c2*(d1*d1 + d3*d3)) +
+             p1*(c2*d2*d1 - c1*d3) +
+             p3*(c2*d3*d2 + c1*d1);
+
+      T zd = p3*(one - c2*(d1*d1 + d2*d2)) +
+             p1*(c2*d3*d1 + c1*d2) +
+             p2*(c2*d3*d2 - c1*d1);
+
+      // angle near pi, rotation around one of the axis
+      const T f = one - angle*angle*Simd::splat<T>(1.0f/(PI*PI));
+      const T h = half*angle;
+      const T limit = one - epsilon;
+
+      const Mask m1 = Simd::logicalAnd(nearPi, Simd::greaterThan(r11, limit));
+      const Mask m2 = Simd::logicalAnd(
+            Simd::logicalAnd(nearPi, Simd::logicalNot(m1)),
+            Simd::greaterThan(r22, limit));
+      const Mask m3 = Simd::logicalAnd(
+            Simd::logicalAnd(nearPi, Simd::logicalNot(Simd::logicalOr(m1, m2))),
+            Simd::greaterThan(r33, limit));
+
+      wxd = Simd::select(m1, angle, Simd::select(Simd::logicalOr(m2, m3), zero, wxd));
+      wyd = Simd::select(m2, angle, Simd::select(Simd::logicalOr(m1, m3), zero, wyd));
+      wzd = Simd::select(m3, angle, Simd::select(Simd::logicalOr(m1, m2), zero, wzd));
+
+      xd = Simd::select(m1, p1,
+           Simd::select(m2, f*p1 - h*p3,
+           Simd::select(m3, f*p1 + h*p2, xd)));
+      yd = Simd::select(m1, f*p2 + h*p3,
+           Simd::select(m2, p2,
+           Simd::select(m3, f*p2 - h*p1, yd)));
+      zd = Simd::select(m1, f*p3 - h*p2,
+           Simd::select(m2, f*p3 + h*p1,
+           Simd::select(m3, p3, zd)));
+
+      const std::size_t outStride = sizeof(Velocity6D)/sizeof(float);
+      float* out = &pVOut->xd;
+      Simd::scatter(out + 0, outStride, xd);
+      Simd::scatter(out + 1, outStride, yd);
+      Simd::scatter(out + 2, outStride, zd);
+      Simd::scatter(out + 3, outStride, wxd);
+      Simd::scatter(out + 4, outStride, wyd);
+      Simd::scatter(out + 5, outStride, wzd);
+    }
+
+
+    void transformLogarithmBatch(
+        const Transform*   pT,
+        const unsigned int pSize,
+        Velocity6D*        pVel)
+    {
+      unsigned int i = 0;
+      for (; i + Simd::WIDTH <= pSize; i += Simd::WIDTH)
+      {
+        xTransformLogarithm<Simd::Pack>(pT + i, pVel + i);
+      }
+      for (; i < pSize; ++i)
+      {
+        xTransformLogarithm<float>(pT + i, pVel + i);
+      }
+    }
+
+
+    // <summary> Exponential of the Simd::Traits<T>::WIDTH Velocity6D pM. </summary>
+    // Branch free version of velocityExponentialInPlace. pM holds xd, yd,
+    // zd, wxd, wyd and wzd, and pH the resulting Transform row by row.
+    template <typename T>
+    inline void xVelocityExponential(
+        const T (&pM)[6],
+        T       (&pH)[12])
+    {
+      typedef typename Simd::Traits<T>::Mask Mask;
+      const T xd  = pM[0];
+      const T yd  = pM[1];
+      const T zd  = pM[2];
+      const T wxd = pM[3];
+      const T wyd = pM[4];
+      const T wzd = pM[5];
+
+      const T one = Simd::splat<T>(1.0f);
+
+      const T t = Simd::sqrt(wxd*wxd + wyd*wyd + wzd*wzd);
+      const Mask small = Simd::lessThan(t, Simd::splat<T>(0.001f)); // seuil
+      const T tSafe = Simd::select(small, one, t);
+
+      T s, c;
+      Simd::sinCos(tSafe, s, c);
+
+      const T CC  = Simd::select(small, Simd::splat<T>(0.5f),
+                                 (one - c)/(tSafe*tSafe));
+      const T SC  = Simd::select(small, one - t*t/Simd::splat<T>(6.0f),
+                                 s/tSafe);
+      const T dSC = Simd::select(small, Simd::splat<T>(0.166666667f),
+                                 (tSafe - s)/(tSafe*tSafe*tSafe));
+
+      pH[0]  = one - CC*(wzd*wzd + wyd*wyd);
+      pH[1]  = CC*wxd*wyd - SC*wzd;
+      pH[2]  = SC*wyd + CC*wxd*wzd;
+      pH[4]  = SC*wzd + CC*wxd*wyd;
+      pH[5]  = one - CC*(wxd*wxd + wzd*wzd);
+      pH[6]  = CC*wyd*wzd - SC*wxd;
+      pH[8]  = CC*wxd*wzd - SC*wyd;
+      pH[9]  = SC*wxd + CC*wyd*wzd;
+      pH[10] = one - CC*(wxd*wxd + wyd*wyd);
+
+      pH[3]  = (SC + dSC*wxd*wxd)*xd +
+               (dSC*wxd*wyd - CC*wzd)*yd +
+               (CC*wyd + dSC*wxd*wzd)*zd;
+      pH[7]  = (CC*wzd + dSC*wyd*wxd)*xd +
+               (SC + dSC*wyd*wyd)*yd +
+               (dSC*wyd*wzd - CC*wxd)*zd;
+      pH[11] = (dSC*wzd*wxd - CC*wyd)*xd +
+               (CC*wxd + dSC*wzd*wyd)*yd +
+               (SC + dSC*wzd*wzd)*zd;
+    }
+
+    // <summary> Exponential of the Simd::Traits<T>::WIDTH Velocity6D at pM. </summary>
+    template <typename T>
+    inline void xVelocityExponential(
+        const Velocity6D* pM,
+        Transform*        tM)
+    {
+      const std::size_t stride = sizeof(Velocity6D)/sizeof(float);
+      const float* in = &pM->xd;
+      T m[6];
+      for (unsigned int k=0; k<6; ++k)
+      {
+        m[k] = Simd::gather<T>(in + k, stride);
+      }
+
+      T h[12];
+      xVelocityExponential(m, h);
+
+      const std::size_t outStride = sizeof(Transform)/sizeof(float);
+      float* out = &tM->r1_c1;
+      for (unsigned int k=0; k<12; ++k)
+      {
+        Simd::scatter(out + k, outStride, h[k]);
+      }
+    }
+
+
+    void velocityExponentialBatch(
+        const Velocity6D*  pVel,
+        const unsigned int pSize,
+        Transform*         pT)
+    {
+      unsigned int i = 0;
+      for (; i + Simd::WIDTH <= pSize; i += Simd::WIDTH)
+      {
+        xVelocityExponential<Simd::Pack>(pVel + i, pT + i);
+      }
+      for (; i < pSize; ++i)
+      {
+        xVelocityExponential<float>(pVel + i, pT + i);
+      }
+    }
+
+
     void changeReferenceVelocity6D(
         const Transform&  pH,
         const Velocity6D& pVIn,
@@ -514,11 +749,12 @@ namespace AL {
       pPos.x = pT.r1_c4;
       pPos.y = pT.r2_c4;
       pPos.z = pT.r3_c4;
-      pPos.wz = atan2(pT.r2_c1, pT.r1_c1);
-      float sy = sinf(pPos.wz);
-      float cy = cosf(pPos.wz);
-      pPos.wy = atan2(-pT.r3_c1, cy*pT.r1_c1+sy*pT.r2_c1);
-      pPos.wx = atan2(sy*pT.r1_c3-cy*pT.r2_c3, cy*pT.r2_c2-sy*pT.r1_c2);
+      pPos.wz = Trig::atan2(pT.r2_c1, pT.r1_c1);
+      float sy = 0.0f;
+      float cy = 0.0f;
+      Trig::sinCos(pPos.wz, sy, cy);
+      pPos.wy = Trig::atan2(-pT.r3_c1, cy*pT.r1_c1+sy*pT.r2_c1);
+      pPos.wx = Trig::atan2(sy*pT.r1_c3-cy*pT.r2_c3, cy*pT.r2_c2-sy*pT.r1_c2);
     }
 
 
@@ -534,8 +770,15 @@ namespace AL {
         const Pose2D& pPose,
         Transform&    pT)
     {
+      float s = 0.0f;
+      float c = 0.0f;
+      Trig::sinCos(pPose.theta, s, c);
+
       pT = Transform(pPose.x, pPose.y, 0.0f);
-      pT *= transformFromRotZ(pPose.theta);
+      pT.r1_c1 = c;
+      pT.r1_c2 = -s;
+      pT.r2_c1 = s;
+      pT.r2_c2 = c;
     }
 
 
@@ -553,7 +796,7 @@ namespace AL {
     {
       pPos.x = pT.r1_c4;
       pPos.y = pT.r2_c4;
-      pPos.theta = atan2(pT.r2_c1, pT.r1_c1);
+      pPos.theta = Trig::atan2(pT.r2_c1, pT.r1_c1);
     }
 
 
@@ -639,11 +882,12 @@ namespace AL {
     Rotation3D rotation3DFromTransform(const Transform& pT)
     {
       Rotation3D R;
-      R.wz = atan2(pT.r2_c1,pT.r1_c1);
-      float sy = sinf(R.wz);
-      float cy = cosf(R.wz);
-      R.wy = atan2(-pT.r3_c1, cy*pT.r1_c1+sy*pT.r2_c1);
-      R.wx = atan2(sy*pT.r1_c3-cy*pT.r2_c3, cy*pT.r2_c2-sy*pT.r1_c2);
+      R.wz = Trig::atan2(pT.r2_c1,pT.r1_c1);
+      float sy = 0.0f;
+      float cy = 0.0f;
+      Trig::sinCos(R.wz, sy, cy);
+      R.wy = Trig::atan2(-pT.r3_c1, cy*pT.r1_c1+sy*pT.r2_c1);
+      R.wx = Trig::atan2(sy*pT.r1_c3-cy*pT.r2_c3, cy*pT.r2_c2-sy*pT.r1_c2);
       return R;
     }
 
@@ -651,11 +895,12 @@ namespace AL {
     Rotation3D rotation3DFromRotation(const Rotation& pR)
     {
       Rotation3D R;
-      R.wz = atan2(pR.r2_c1,pR.r1_c1);
-      float sy = sinf(R.wz);
-      float cy = cosf(R.wz);
-      R.wy = atan2(-pR.r3_c1, cy*pR.r1_c1+sy*pR.r2_c1);
-      R.wx = atan2(sy*pR.r1_c3-cy*pR.r2_c3, cy*pR.r2_c2-sy*pR.r1_c2);
+      R.wz = Trig::atan2(pR.r2_c1,pR.r1_c1);
+      float sy = 0.0f;
+      float cy = 0.0f;
+      Trig::sinCos(R.wz, sy, cy);
+      R.wy = Trig::atan2(-pR.r3_c1, cy*pR.r1_c1+sy*pR.r2_c1);
+      R.wx = Trig::atan2(sy*pR.r1_c3-cy*pR.r2_c3, cy*pR.r2_c2-sy*pR.r1_c2);
       return R;
     }
 
@@ -663,11 +908,110 @@ namespace AL {
         const Transform& pT,
         const Position3D&  pPos)
     {
-      Position3D result;
-      result.x = (pT.r1_c1 * pPos.x) + (pT.r1_c2 * pPos.y) + (pT.r1_c3 * pPos.z) + pT.r1_c4;
-      result.y = (pT.r2_c1 * pPos.x) + (pT.r2_c2 * pPos.y) + (pT.r2_c3 * pPos.z) + pT.r2_c4;
-      result.z = (pT.r3_c1 * pPos.x) + (pT.r3_c2 * pPos.y) + (pT.r3_c3 * pPos.z) + pT.r3_c4;
-      return result;
+      return Detail::transformApply(pT, pPos);
+    }
+
+    // The coefficients of a Transform, each one broadcast to every lane.
+    template <typename T>
+    struct xSplatTransform
+    {
+      T r11, r12, r13, r14;
+      T r21, r22, r23, r24;
+      T r31, r32, r33, r34;
+
+      explicit xSplatTransform(const Transform& pT):
+        r11(Simd::splat<T>(pT.r1_c1)), r12(Simd::splat<T>(pT.r1_c2)),
+        r13(Simd::splat<T>(pT.r1_c3)), r14(Simd::splat<T>(pT.r1_c4)),
+        r21(Simd::splat<T>(pT.r2_c1)), r22(Simd::splat<T>(pT.r2_c2)),
+        r23(Simd::splat<T>(pT.r2_c3)), r24(Simd::splat<T>(pT.r2_c4)),
+        r31(Simd::splat<T>(pT.r3_c1)), r32(Simd::splat<T>(pT.r3_c2)),
+        r33(Simd::splat<T>(pT.r3_c3)), r34(Simd::splat<T>(pT.r3_c4)) {}
+
+      // same computation as operator*(Transform, Position3D)
+      inline void apply(T& pX, T& pY, T& pZ) const
+      {
+        const T x = r11*pX + r12*pY + r13*pZ + r14;
+        const T y = r21*pX + r22*pY + r23*pZ + r24;
+        const T z = r31*pX + r32*pY + r33*pZ + r34;
+        pX = x;
+        pY = y;
+        pZ = z;
+      }
+    };
+
+    void transformPoints(
+        const Transform&   pT,
+        const float*       pXYZ,
+        const unsigned int pSize,
+        float*             pOut)
+    {
+      const xSplatTransform<Simd::Pack> packT(pT);
+      const int nbPacks = static_cast<int>(pSize/Simd::WIDTH);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (nbPacks > 4096)
+#endif
+      for (int p=0; p<nbPacks; ++p)
+      {
+        const std::size_t i = 3*static_cast<std::size_t>(p)*Simd::WIDTH;
+        Simd::Pack x, y, z;
+        Simd::load3(pXYZ + i, x, y, z);
+        packT.apply(x, y, z);
+        Simd::store3(pOut + i, x, y, z);
+      }
+
+      const xSplatTransform<float> floatT(pT);
+      for (std::size_t i=3*static_cast<std::size_t>(nbPacks)*Simd::WIDTH;
+           i<3*static_cast<std::size_t>(pSize); i+=3)
+      {
+        float x = pXYZ[i];
+        float y = pXYZ[i + 1];
+        float z = pXYZ[i + 2];
+        floatT.apply(x, y, z);
+        pOut[i]     = x;
+        pOut[i + 1] = y;
+        pOut[i + 2] = z;
+      }
+    }
+
+    void transformPoints(
+        const Transform&   pT,
+        const float*       pX,
+        const float*       pY,
+        const float*       pZ,
+        const unsigned int pSize,
+        float*             pOutX,
+        float*             pOutY,
+        float*             pOutZ)
+    {
+      const xSplatTransform<Simd::Pack> packT(pT);
+      const int nbPacks = static_cast<int>(pSize/Simd::WIDTH);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (nbPacks > 4096)
+#endif
+      for (int p=0; p<nbPacks; ++p)
+      {
+        const std::size_t i = static_cast<std::size_t>(p)*Simd::WIDTH;
+        Simd::Pack x = Simd::load<Simd::Pack>(pX + i);
+        Simd::Pack y = Simd::load<Simd::Pack>(pY + i);
+        Simd::Pack z = Simd::load<Simd::Pack>(pZ + i);
+        packT.apply(x, y, z);
+        Simd::store(pOutX + i, x);
+        Simd::store(pOutY + i, y);
+        Simd::store(pOutZ + i, z);
+      }
+
+      const xSplatTransform<float> floatT(pT);
+      for (std::size_t i=static_cast<std::size_t>(nbPacks)*Simd::WIDTH;
+           i<pSize; ++i)
+      {
+        float x = pX[i];
+        float y = pY[i];
+        float z = pZ[i];
+        floatT.apply(x, y, z);
+        pOutX[i] = x;
+        pOutY[i] = y;
+        pOutZ[i] = z;
+      }
     }
 
 
@@ -916,8 +1260,9 @@ namespace AL {
       // Usefull initialization
       pT = AL::Math::Transform();
 
-      float c = cosf(pTheta);
-      float s = sinf(pTheta);
+      float s = 0.0f;
+      float c = 0.0f;
+      Trig::sinCos(pTheta, s, c);
 
       pT.r1_c4 = pM.x;
       pT.r2_c4 = pM.y;
@@ -1046,23 +1391,217 @@ namespace AL {
       return HOut;
     }
 
-    Transform transformFromQuaternion(
-        const Quaternion& pQua)
+    // Load the Simd::Traits<T>::WIDTH Transform starting at pT: the
+    // rotation parts row by row in pR and the translations in pP.
+    template <typename T>
+    inline void xLoadTransform(
+        const Transform* pT,
+        T                (&pR)[9],
+        T                (&pP)[3])
     {
-      Transform TOut;
+      const std::size_t stride = sizeof(Transform)/sizeof(float);
+      Simd::gather4(&pT->r1_c1, stride, pR[0], pR[1], pR[2], pP[0]);
+      Simd::gather4(&pT->r2_c1, stride, pR[3], pR[4], pR[5], pP[1]);
+      Simd::gather4(&pT->r3_c1, stride, pR[6], pR[7], pR[8], pP[2]);
+    }
 
-      TOut.r1_c1 = 1.0f - 2.0f*(powf(pQua.y, 2) + powf(pQua.z, 2));
-      TOut.r1_c2 = 2.0f*(pQua.x*pQua.y - pQua.z*pQua.w);
-      TOut.r1_c3 = 2.0f*(pQua.x*pQua.z + pQua.y*pQua.w);
+    template <typename T>
+    inline void xLoadRotation(
+        const Transform* pT,
+        T                (&pR)[9])
+    {
+      T translation[3];
+      xLoadTransform(pT, pR, translation);
+    }
 
-      TOut.r2_c1 = 2.0f*(pQua.x*pQua.y + pQua.z*pQua.w);
-      TOut.r2_c2 = 1.0f - 2.0f*(powf(pQua.x, 2) + powf(pQua.z, 2));
-      TOut.r2_c3 = 2.0f*(pQua.y*pQua.z - pQua.x*pQua.w);
+    template <typename T>
+    inline void xLoadRotation(
+        const Rotation* pRot,
+        T               (&pR)[9])
+    {
+      const std::size_t stride = sizeof(Rotation)/sizeof(float);
+      const float* in = &pRot->r1_c1;
+      for (unsigned int i=0; i<9; ++i)
+      {
+        pR[i] = Simd::gather<T>(in + i, stride);
+      }
+    }
+
+    // Store pR in the rotation parts of the Simd::Traits<T>::WIDTH
+    // Transform starting at pT, with a zero translation.
+    template <typename T>
+    inline void xStoreRotation(
+        const T    (&pR)[9],
+        Transform* pT)
+    {
+      const std::size_t stride = sizeof(Transform)/sizeof(float);
+      const T zero = Simd::splat<T>(0.0f);
+      Simd::scatter4(&pT->r1_c1, stride, pR[0], pR[1], pR[2], zero);
+      Simd::scatter4(&pT->r2_c1, stride, pR[3], pR[4], pR[5], zero);
+      Simd::scatter4(&pT->r3_c1, stride, pR[6], pR[7], pR[8], zero);
+    }
 
-      TOut.r3_c1 = 2.0f*(pQua.x*pQua.z - pQua.y*pQua.w);
-      TOut.r3_c2 = 2.0f*(pQua.y*pQua.z + pQua.x*pQua.w);
-      TOut.r3_c3 = 1.0f - 2.0f*(powf(pQua.x, 2) + powf(pQua.y, 2));
+    template <typename T>
+    inline void xStoreRotation(
+        const T   (&pR)[9],
+        Rotation* pRot)
+    {
+      const std::size_t stride = sizeof(Rotation)/sizeof(float);
+      float* out = &pRot->r1_c1;
+      for (unsigned int i=0; i<9; ++i)
+      {
+        Simd::scatter(out + i, stride, pR[i]);
+      }
+    }
 
+    // Rotation matrices, row by row, of the Simd::Traits<T>::WIDTH unit
+    // Quaternion starting at pQua.
+    template <typename T>
+    inline void xRotationFromQuaternion(
+        const Quaternion* pQua,
+        T                 (&pR)[9])
+    {
+      T w, x, y, z;
+      Simd::gather4(&pQua->w, 4, w, x, y, z);
+
+      const T one = Simd::splat<T>(1.0f);
+      const T two = Simd::splat<T>(2.0f);
+      const T xx = x*x;
+      const T yy = y*y;
+      const T zz = z*z;
+
+      pR[0] = one - two*(yy + zz);
+      pR[1] = two*(x*y - z*w);
+      pR[2] = two*(x*z + y*w);
+      pR[3] = two*(x*y + z*w);
+      pR[4] = one - two*(xx + zz);
+      pR[5] = two*(y*z - x*w);
+      pR[6] = two*(x*z - y*w);
+      pR[7] = two*(y*z + x*w);
+      pR[8] = one - two*(xx + yy);
+    }
+
+    // Quaternion of the Simd::Traits<T>::WIDTH rotation matrices pR,
+    // stored from pQua.
+    // Branch free Shepperd method: the quaternion is computed from the
+    // largest of 1 + trace, 1 + r11 - r22 - r33, 1 - r11 + r22 - r33 and
+    // 1 - r11 - r22 + r33, which is 4 times the square of one of its
+    // components. The other components are then 4 times its product by
+    // the chosen one: q is num normalized, with num[chosen] = d.
+    // Normalizing num rather than dividing by 2*sqrt(d) keeps the result
+    // unit for a drifted, non orthonormal, rotation matrix.
+    // The returned quaternion has w >= 0, as the scalar version.
+    template <typename T>
+    inline void xQuaternionFromRotation(
+        const T     (&pR)[9],
+        Quaternion* pQua)
+    {
+      typedef typename Simd::Traits<T>::Mask Mask;
+      const T& r11 = pR[0];
+      const T& r12 = pR[1];
+      const T& r13 = pR[2];
+      const T& r21 = pR[3];
+      const T& r22 = pR[4];
+      const T& r23 = pR[5];
+      const T& r31 = pR[6];
+      const T& r32 = pR[7];
+      const T& r33 = pR[8];
+
+      const T one = Simd::splat<T>(1.0f);
+      const T a = r32 - r23;
+      const T b = r13 - r31;
+      const T c = r21 - r12;
+      const T e = r12 + r21;
+      const T f = r13 + r31;
+      const T g = r23 + r32;
+
+      // w is the largest
+      T d  = one + r11 + r22 + r33;
+      T nw = d;
+      T nx = a;
+      T ny = b;
+      T nz = c;
+
+      // x is the largest
+      const T dx = one + r11 - r22 - r33;
+      Mask m = Simd::greaterThan(dx, d);
+      d  = Simd::select(m, dx, d);
+      nw = Simd::select(m, a, nw);
+      nx = Simd::select(m, dx, nx);
+      ny = Simd::select(m, e, ny);
+      nz = Simd::select(m, f, nz);
+
+      // y is the largest
+      const T dy = one - r11 + r22 - r33;
+      m  = Simd::greaterThan(dy, d);
+      d  = Simd::select(m, dy, d);
+      nw = Simd::select(m, b, nw);
+      nx = Simd::select(m, e, nx);
+      ny = Simd::select(m, dy, ny);
+      nz = Simd::select(m, g, nz);
+
+      // z is the largest
+      const T dz = one - r11 - r22 + r33;
+      m  = Simd::greaterThan(dz, d);
+      d  = Simd::select(m, dz, d);
+      nw = Simd::select(m, c, nw);
+      nx = Simd::select(m, f, nx);
+      ny = Simd::select(m, g, ny);
+      nz = Simd::select(m, dz, nz);
+
+      // d >= 1, as the four candidates sum to 4, so num is never zero
+      T k = Simd::rsqrt(nw*nw + nx*nx + ny*ny + nz*nz);
+      k = Simd::select(Simd::lessThan(nw, Simd::splat<T>(0.0f)), -k, k);
+      Simd::scatter4(&pQua->w, 4, k*nw, k*nx, k*ny, k*nz);
+    }
+
+    template <typename Matrix>
+    inline void xQuaternionFromMatrixBatch(
+        const Matrix*      pIn,
+        const unsigned int pSize,
+        Quaternion*        pQua)
+    {
+      unsigned int i = 0;
+      for (; i + Simd::WIDTH <= pSize; i += Simd::WIDTH)
+      {
+        Simd::Pack r[9];
+        xLoadRotation(pIn + i, r);
+        xQuaternionFromRotation(r, pQua + i);
+      }
+      for (; i < pSize; ++i)
+      {
+        float r[9];
+        xLoadRotation(pIn + i, r);
+        xQuaternionFromRotation(r, pQua + i);
+      }
+    }
+
+    template <typename Matrix>
+    inline void xMatrixFromQuaternionBatch(
+        const Quaternion*  pQua,
+        const unsigned int pSize,
+        Matrix*            pOut)
+    {
+      unsigned int i = 0;
+      for (; i + Simd::WIDTH <= pSize; i += Simd::WIDTH)
+      {
+        Simd::Pack r[9];
+        xRotationFromQuaternion(pQua + i, r);
+        xStoreRotation(r, pOut + i);
+      }
+      for (; i < pSize; ++i)
+      {
+        float r[9];
+        xRotationFromQuaternion(pQua + i, r);
+        xStoreRotation(r, pOut + i);
+      }
+    }
+
+    Transform transformFromQuaternion(
+        const Quaternion& pQua)
+    {
+      Transform TOut;
+      xMatrixFromQuaternionBatch(&pQua, 1, &TOut);
       return TOut;
     }
 
@@ -1070,81 +1609,420 @@ namespace AL {
     Quaternion quaternionFromTransform(
         const Transform& pT)
     {
-      // TR2Q   Convert homogeneous transform to a unit-quaternion
-      //
-      //   Q = tr2q(T)
-      //
-      //   Return a unit quaternion corresponding to the rotational part of the
-      //   homogeneous transform T.
-      //
-      //   See also: Q2TR
+      // Shepperd method, as xQuaternionFromRotation, with a single
+      // square root and the normalization folded in one multiplication
+      const float a = pT.r3_c2 - pT.r2_c3;
+      const float b = pT.r1_c3 - pT.r3_c1;
+      const float c = pT.r2_c1 - pT.r1_c2;
+      const float e = pT.r1_c2 + pT.r2_c1;
+      const float f = pT.r1_c3 + pT.r3_c1;
+      const float g = pT.r2_c3 + pT.r3_c2;
+
+      const float dw = 1.0f + pT.r1_c1 + pT.r2_c2 + pT.r3_c3;
+      const float dx = 1.0f + pT.r1_c1 - pT.r2_c2 - pT.r3_c3;
+      const float dy = 1.0f - pT.r1_c1 + pT.r2_c2 - pT.r3_c3;
+      const float dz = 1.0f - pT.r1_c1 - pT.r2_c2 + pT.r3_c3;
+
+      float d = dw;
+      Quaternion quaOut(dw, a, b, c);
+      if (dx > d)
+      {
+        d = dx;
+        quaOut = Quaternion(a, dx, e, f);
+      }
+      if (dy > d)
+      {
+        d = dy;
+        quaOut = Quaternion(b, e, dy, g);
+      }
+      if (dz > d)
+      {
+        d = dz;
+        quaOut = Quaternion(c, f, g, dz);
+      }
 
-      Quaternion quaOut;
+      // d >= 1, as the four candidates sum to 4, so quaOut is never zero
+      float k = 1.0f/sqrtf(quaOut.w*quaOut.w + quaOut.x*quaOut.x +
+                           quaOut.y*quaOut.y + quaOut.z*quaOut.z);
+      if (quaOut.w < 0.0f)
+      {
+        k = -k;
+      }
+      quaOut.w *= k;
+      quaOut.x *= k;
+      quaOut.y *= k;
+      quaOut.z *= k;
+      return quaOut;
+    } // end quaternionFromTransform
 
-      float kx = pT.r3_c2 - pT.r2_c3; // Oz - Ay
-      float ky = pT.r1_c3 - pT.r3_c1; // Ax - Nz
-      float kz = pT.r2_c1 - pT.r1_c2; // Ny - Ox
+    void quaternionFromTransformBatch(
+        const Transform*   pT,
+        const unsigned int pSize,
+        Quaternion*        pQua)
+    {
+      xQuaternionFromMatrixBatch(pT, pSize, pQua);
+    }
 
-      float kx1 = 0.0f;
-      float ky1 = 0.0f;
-      float kz1 = 0.0f;
-      bool add  = false;
+    void quaternionFromRotationBatch(
+        const Rotation*    pRot,
+        const unsigned int pSize,
+        Quaternion*        pQua)
+    {
+      xQuaternionFromMatrixBatch(pRot, pSize, pQua);
+    }
 
-      if ((pT.r1_c1 >= pT.r2_c2) && (pT.r1_c1 >= pT.r3_c3))
+    void transformFromQuaternionBatch(
+        const Quaternion*  pQua,
+        const unsigned int pSize,
+        Transform*         pT)
+    {
+      xMatrixFromQuaternionBatch(pQua, pSize, pT);
+    }
+
+    void rotationFromQuaternionBatch(
+        const Quaternion*  pQua,
+        const unsigned int pSize,
+        Rotation*          pRot)
+    {
+      xMatrixFromQuaternionBatch(pQua, pSize, pRot);
+    }
+
+    // Axes of an EulerConvention: R = Ra(angle a)*Rb(angle b)*Rc(angle c),
+    // with sign = 1 when (a, b, c) is a circular permutation of (x, y, z)
+    // and -1 otherwise.
+    struct xEulerAxes
+    {
+      unsigned int a;
+      unsigned int b;
+      unsigned int c;
+      float        sign;
+    };
+
+    inline xEulerAxes xGetEulerAxes(const EulerConvention pConvention)
+    {
+      static const xEulerAxes axes[6] = {
+        {2, 1, 0, -1.0f}, // EULER_ZYX
+        {0, 1, 2,  1.0f}, // EULER_XYZ
+        {0, 2, 1, -1.0f}, // EULER_XZY
+        {1, 0, 2, -1.0f}, // EULER_YXZ
+        {1, 2, 0,  1.0f}, // EULER_YZX
+        {2, 0, 1,  1.0f}  // EULER_ZXY
+      };
+      if (static_cast<unsigned int>(pConvention) > 5u)
       {
-        kx1 = pT.r1_c1 - pT.r2_c2 - pT.r3_c3 + 1.0f; // Nx - Oy - Az + 1
-        ky1 = pT.r2_c1 + pT.r1_c2;                   // Ny + Ox
-        kz1 = pT.r3_c1 + pT.r1_c3;                   // Nz + Ax
-        add = (kx >= 0.0f);
+        throw std::invalid_argument("ALMath: unknown EulerConvention.");
       }
-      else if (pT.r2_c2 >= pT.r3_c3)
+      return axes[pConvention];
+    }
+
+    // Euler angles of the Simd::Traits<T>::WIDTH rotation matrices pR,
+    // in pAngles[axis].
+    // The outer angle is computed first, then removed from the matrix
+    // so that the two other ones are read from a product of two
+    // rotations: this is the computation of rotation3DFromRotation,
+    // which stays accurate near the gimbal lock.
+    template <typename T>
+    inline void xEulerFromRotation(
+        const T           (&pR)[9],
+        const xEulerAxes& pAxes,
+        T                 (&pAngles)[3])
+    {
+      const unsigned int a = 3*pAxes.a;
+      const unsigned int b = 3*pAxes.b;
+      const unsigned int c = 3*pAxes.c;
+      const T sign = Simd::splat<T>(pAxes.sign);
+
+      // Ra(-angle a)*R = Rb(angle b)*Rc(angle c) =: M
+      pAngles[pAxes.a] = Simd::atan2(-sign*pR[b + pAxes.c], pR[c + pAxes.c]);
+      T sa, ca;
+      Simd::sinCos(pAngles[pAxes.a], sa, ca);
+      const T ssa = sign*sa;
+
+      // M[c][c]
+      const T mcc = ca*pR[c + pAxes.c] - ssa*pR[b + pAxes.c];
+      // M[b][a] and M[b][b]
+      const T mba = ca*pR[b + pAxes.a] + ssa*pR[c + pAxes.a];
+      const T mbb = ca*pR[b + pAxes.b] + ssa*pR[c + pAxes.b];
+
+      pAngles[pAxes.b] = Simd::atan2(sign*pR[a + pAxes.c], mcc);
+      pAngles[pAxes.c] = Simd::atan2(sign*mba, mbb);
+    }
+
+    template <typename Matrix>
+    inline void xRotation3DFromMatrixBatch(
+        const Matrix*         pIn,
+        const unsigned int    pSize,
+        Rotation3D*           pRot3D,
+        const EulerConvention pConvention)
+    {
+      const xEulerAxes axes = xGetEulerAxes(pConvention);
+      const std::size_t stride = sizeof(Rotation3D)/sizeof(float);
+      unsigned int i = 0;
+      for (; i + Simd::WIDTH <= pSize; i += Simd::WIDTH)
       {
-        kx1 = pT.r2_c1 + pT.r1_c2;                   // Ny + Ox
-        ky1 = pT.r2_c2 - pT.r1_c1 - pT.r3_c3 + 1.0f; // Oy - Nx - Az + 1
-        kz1 = pT.r3_c2 + pT.r2_c3;                   // Oz + Ay
-        add = (ky >= 0.0f);
+        Simd::Pack r[9];
+        Simd::Pack angles[3];
+        xLoadRotation(pIn + i, r);
+        xEulerFromRotation(r, axes, angles);
+        Simd::scatter(&pRot3D[i].wx, stride, angles[0]);
+        Simd::scatter(&pRot3D[i].wy, stride, angles[1]);
+        Simd::scatter(&pRot3D[i].wz, stride, angles[2]);
       }
-      else
+      for (; i < pSize; ++i)
       {
-        kx1 = pT.r3_c1 + pT.r1_c3;                   // Nz + Ax
-        ky1 = pT.r3_c2 + pT.r2_c3;                   // Oz + Ay
-        kz1 = pT.r3_c3 - pT.r1_c1 - pT.r2_c2 + 1.0f; // Az - Nx - Oy + 1
-        add = (kz >= 0.0f);
+        float r[9];
+        float angles[3];
+        xLoadRotation(pIn + i, r);
+        xEulerFromRotation(r, axes, angles);
+        pRot3D[i] = Rotation3D(angles[0], angles[1], angles[2]);
       }
+    }
+
+    void rotation3DFromRotationBatch(
+        const Rotation*       pRot,
+        const unsigned int    pSize,
+        Rotation3D*           pRot3D,
+        const EulerConvention pConvention)
+    {
+      xRotation3DFromMatrixBatch(pRot, pSize, pRot3D, pConvention);
+    }
+
+    void rotation3DFromTransformBatch(
+        const Transform*      pT,
+        const unsigned int    pSize,
+        Rotation3D*           pRot3D,
+        const EulerConvention pConvention)
+    {
+      xRotation3DFromMatrixBatch(pT, pSize, pRot3D, pConvention);
+    }
 
-      if (add)
+    void position6DFromTransformBatch(
+        const Transform*      pT,
+        const unsigned int    pSize,
+        Position6D*           pPos,
+        const EulerConvention pConvention)
+    {
+      const xEulerAxes axes = xGetEulerAxes(pConvention);
+      const std::size_t stride = sizeof(Position6D)/sizeof(float);
+      unsigned int i = 0;
+      for (; i + Simd::WIDTH <= pSize; i += Simd::WIDTH)
       {
-        kx = kx + kx1;
-        ky = ky + ky1;
-        kz = kz + kz1;
+        Simd::Pack r[9];
+        Simd::Pack p[3];
+        Simd::Pack angles[3];
+        xLoadTransform(pT + i, r, p);
+        xEulerFromRotation(r, axes, angles);
+        Simd::scatter(&pPos[i].x, stride, p[0]);
+        Simd::scatter(&pPos[i].y, stride, p[1]);
+        Simd::scatter(&pPos[i].z, stride, p[2]);
+        Simd::scatter(&pPos[i].wx, stride, angles[0]);
+        Simd::scatter(&pPos[i].wy, stride, angles[1]);
+        Simd::scatter(&pPos[i].wz, stride, angles[2]);
       }
-      else
+      for (; i < pSize; ++i)
       {
-        kx = kx - kx1;
-        ky = ky - ky1;
-        kz = kz - kz1;
+        float r[9];
+        float p[3];
+        float angles[3];
+        xLoadTransform(pT + i, r, p);
+        xEulerFromRotation(r, axes, angles);
+        pPos[i] = Position6D(p[0], p[1], p[2], angles[0], angles[1], angles[2]);
       }
+    }
 
-      float nm = sqrtf(powf(kx,2) + powf(ky,2) + powf(kz,2));
 
-      if (nm == 0.0f)
+    // Multiply the linear rows and the angular rows of the 6xpNbColumns
+    // matrix pJIn, stored row by row, by the 3x3 matrix pR.
+    inline void xChangeReferenceJacobian(
+        const float        (&pR)[9],
+        const float*       pJIn,
+        const unsigned int pNbColumns,
+        float*             pJOut)
+    {
+      Simd::Pack r[9];
+      for (unsigned int k=0; k<9; ++k)
       {
-        quaOut = Quaternion();
+        r[k] = Simd::splat<Simd::Pack>(pR[k]);
       }
-      else
+
+      for (unsigned int block=0; block<2; ++block)
       {
-        float trace = pT.r1_c1 + pT.r2_c2 + pT.r3_c3 + 1.0f;
-        if (trace < 0.0f)
+        const float* in0 = pJIn + 3*block*pNbColumns;
+        const float* in1 = in0 + pNbColumns;
+        const float* in2 = in1 + pNbColumns;
+        float* out0 = pJOut + 3*block*pNbColumns;
+        float* out1 = out0 + pNbColumns;
+        float* out2 = out1 + pNbColumns;
+
+        unsigned int j = 0;
+        for (; j + Simd::WIDTH <= pNbColumns; j += Simd::WIDTH)
+        {
+          const Simd::Pack x = Simd::load<Simd::Pack>(in0 + j);
+          const Simd::Pack y = Simd::load<Simd::Pack>(in1 + j);
+          const Simd::Pack z = Simd::load<Simd::Pack>(in2 + j);
+          Simd::store(out0 + j, r[0]*x + r[1]*y + r[2]*z);
+          Simd::store(out1 + j, r[3]*x + r[4]*y + r[5]*z);
+          Simd::store(out2 + j, r[6]*x + r[7]*y + r[8]*z);
+        }
+        for (; j < pNbColumns; ++j)
         {
-          trace = 0.0f;
+          const float x = in0[j];
+          const float y = in1[j];
+          const float z = in2[j];
+          out0[j] = pR[0]*x + pR[1]*y + pR[2]*z;
+          out1[j] = pR[3]*x + pR[4]*y + pR[5]*z;
+          out2[j] = pR[6]*x + pR[7]*y + pR[8]*z;
         }
+      }
+    }
+
+    void changeReferenceJacobian(
+        const Transform&   pT,
+        const float*       pJIn,
+        const unsigned int pNbColumns,
+        float*             pJOut)
+    {
+      float r[9];
+      xLoadRotation(&pT, r);
+      xChangeReferenceJacobian(r, pJIn, pNbColumns, pJOut);
+    }
+
+    void changeReferenceTransposeJacobian(
+        const Transform&   pT,
+        const float*       pJIn,
+        const unsigned int pNbColumns,
+        float*             pJOut)
+    {
+      float r[9];
+      xLoadRotation(&pT, r);
+      const float rt[9] = {r[0], r[3], r[6],
+                           r[1], r[4], r[7],
+                           r[2], r[5], r[8]};
+      xChangeReferenceJacobian(rt, pJIn, pNbColumns, pJOut);
+    }
 
-        float qs = 0.5f*sqrtf(trace);
-        float s = sqrtf(1.0f - powf(qs,2)) / nm;
-        quaOut = Quaternion(qs, s*kx, s*ky, s*kz);
+
+    TransformInterpolator::TransformInterpolator()
+    {
+    }
+
+    TransformInterpolator::TransformInterpolator(
+        const Transform& pTIn1,
+        const Transform& pTIn2)
+    {
+      set(pTIn1, pTIn2);
+    }
+
+    void TransformInterpolator::set(
+        const Transform& pTIn1,
+        const Transform& pTIn2)
+    {
+      fTIn1 = pTIn1;
+      transformLogarithmInPlace(transformInverse(pTIn1)*pTIn2, fVelocity);
+    }
+
+    const Velocity6D& TransformInterpolator::getVelocity() const
+    {
+      return fVelocity;
+    }
+
+    void TransformInterpolator::interpolateInPlace(
+        const float pVal,
+        Transform&  pTOut) const
+    {
+      Transform H;
+      velocityExponentialInPlace(pVal*fVelocity, H);
+      pTOut = fTIn1*H;
+    }
+
+    Transform TransformInterpolator::interpolate(const float pVal) const
+    {
+      Transform TOut;
+      interpolateInPlace(pVal, TOut);
+      return TOut;
+    }
+
+    // pTOut = pT1*exp(pVal*pV) for the Simd::Traits<T>::WIDTH parameters
+    // pVal.
+    template <typename T>
+    inline void xInterpolate(
+        const xSplatTransform<T>& pT1,
+        const T                   (&pV)[6],
+        const T                   pVal,
+        Transform*                pTOut)
+    {
+      T m[6];
+      for (unsigned int k=0; k<6; ++k)
+      {
+        m[k] = pVal*pV[k];
       }
-      return quaOut;
-    } // end quaternionFromTransform
+      T h[12];
+      xVelocityExponential(m, h);
+
+      // the rotation columns are rotated by pT1, the translation is moved
+      // as a point
+      T x = h[3];
+      T y = h[7];
+      T z = h[11];
+      pT1.apply(x, y, z);
+      T r[9];
+      for (unsigned int j=0; j<3; ++j)
+      {
+        r[j]     = pT1.r11*h[j] + pT1.r12*h[4 + j] + pT1.r13*h[8 + j];
+        r[3 + j] = pT1.r21*h[j] + pT1.r22*h[4 + j] + pT1.r23*h[8 + j];
+        r[6 + j] = pT1.r31*h[j] + pT1.r32*h[4 + j] + pT1.r33*h[8 + j];
+      }
+
+      const std::size_t stride = sizeof(Transform)/sizeof(float);
+      Simd::scatter4(&pTOut->r1_c1, stride, r[0], r[1], r[2], x);
+      Simd::scatter4(&pTOut->r2_c1, stride, r[3], r[4], r[5], y);
+      Simd::scatter4(&pTOut->r3_c1, stride, r[6], r[7], r[8], z);
+    }
+
+    void TransformInterpolator::interpolateBatch(
+        const float*       pVal,
+        const unsigned int pSize,
+        Transform*         pTOut) const
+    {
+      const float v[6] = {fVelocity.xd, fVelocity.yd, fVelocity.zd,
+                          fVelocity.wxd, fVelocity.wyd, fVelocity.wzd};
+
+      const xSplatTransform<Simd::Pack> packT1(fTIn1);
+      Simd::Pack packV[6];
+      for (unsigned int k=0; k<6; ++k)
+      {
+        packV[k] = Simd::splat<Simd::Pack>(v[k]);
+      }
+      unsigned int i = 0;
+      for (; i + Simd::WIDTH <= pSize; i += Simd::WIDTH)
+      {
+        xInterpolate(packT1, packV, Simd::load<Simd::Pack>(pVal + i), pTOut + i);
+      }
+
+      const xSplatTransform<float> floatT1(fTIn1);
+      for (; i < pSize; ++i)
+      {
+        xInterpolate(floatT1, v, pVal[i], pTOut + i);
+      }
+    }
+
+    void TransformInterpolator::sample(
+        const unsigned int pSize,
+        Transform*         pTOut) const
+    {
+      const float last = (pSize > 1) ? static_cast<float>(pSize - 1) : 1.0f;
+      float val[Simd::WIDTH];
+      for (unsigned int i=0; i<pSize; i+=Simd::WIDTH)
+      {
+        const unsigned int size = std::min(
+              pSize - i, static_cast<unsigned int>(Simd::WIDTH));
+        for (unsigned int k=0; k<size; ++k)
+        {
+          val[k] = static_cast<float>(i + k)/last;
+        }
+        interpolateBatch(val, size, pTOut + i);
+      }
+    }
 
   } // namespace Math
 } // namespace AL
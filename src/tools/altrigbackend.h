@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+// Private header, not installed.
+//
+// Trigonometry used by the rotation construction of ALMath. It is libm by
+// default, and the polynomial approximations of alsimd.h (see fastSinCos
+// and fastAtan2) when ALMath is built with ALMATH_WITH_FAST_TRIG, see
+// alconfig.h.
+
+#pragma once
+#ifndef _LIBALMATH_SRC_TOOLS_ALTRIGBACKEND_H_
+#define _LIBALMATH_SRC_TOOLS_ALTRIGBACKEND_H_
+
+#include <almath/types/alconfig.h>
+#include <cmath>
+
+#ifdef ALMATH_FAST_TRIG
+# include "alsimd.h"
+#endif
+
+namespace AL {
+  namespace Math {
+    namespace Trig {
+
+      inline void sinCos(
+        const float pAngle,
+        float&      pSin,
+        float&      pCos)
+      {
+#ifdef ALMATH_FAST_TRIG
+        Simd::sinCos(pAngle, pSin, pCos);
+#else
+        pSin = sinf(pAngle);
+        pCos = cosf(pAngle);
+#endif
+      }
+
+      inline float atan2(
+        const float pY,
+        const float pX)
+      {
+#ifdef ALMATH_FAST_TRIG
+        return Simd::atan2(pY, pX);
+#else
+        return atan2f(pY, pX);
+#endif
+      }
+
+    } // namespace Trig
+  } // namespace Math
+} // namespace AL
+
+#endif  // _LIBALMATH_SRC_TOOLS_ALTRIGBACKEND_H_
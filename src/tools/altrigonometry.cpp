@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/tools/altrigonometry.h>
+
+#include "alsimd.h"
+
+namespace AL {
+  namespace Math {
+
+    void fastSinCos(
+      const float pAngle,
+      float&      pSin,
+      float&      pCos)
+    {
+      Simd::sinCos(pAngle, pSin, pCos);
+    }
+
+    float fastAtan2(
+      const float pY,
+      const float pX)
+    {
+      return Simd::atan2(pY, pX);
+    }
+
+    void fastSinCosBatch(
+      const float*       pAngles,
+      const unsigned int pSize,
+      float*             pSin,
+      float*             pCos)
+    {
+      unsigned int i = 0;
+      for (; i + Simd::WIDTH <= pSize; i += Simd::WIDTH)
+      {
+        Simd::Pack s;
+        Simd::Pack c;
+        Simd::sinCos(Simd::load<Simd::Pack>(pAngles + i), s, c);
+        Simd::store(pSin + i, s);
+        Simd::store(pCos + i, c);
+      }
+      for (; i < pSize; ++i)
+      {
+        Simd::sinCos(pAngles[i], pSin[i], pCos[i]);
+      }
+    }
+
+    void fastAtan2Batch(
+      const float*       pY,
+      const float*       pX,
+      const unsigned int pSize,
+      float*             pAngles)
+    {
+      unsigned int i = 0;
+      for (; i + Simd::WIDTH <= pSize; i += Simd::WIDTH)
+      {
+        Simd::store(pAngles + i, Simd::atan2(
+                      Simd::load<Simd::Pack>(pY + i),
+                      Simd::load<Simd::Pack>(pX + i)));
+      }
+      for (; i < pSize; ++i)
+      {
+        pAngles[i] = Simd::atan2(pY[i], pX[i]);
+      }
+    }
+
+  } // namespace Math
+} // namespace AL
@@ -6,6 +6,10 @@
 
 #include <almath/tools/avoidfootcollision.h>
 #include <cmath>
+#include <stdexcept>
+
+#include "alsimd.h"
+#include "altrigbackend.h"
 
 namespace AL
 {
@@ -213,20 +217,337 @@ namespace AL
       else
       {
         // we have to clip pMove
-        // compute angle
-        float theta = atan2(pMove.y, pMove.x);
+        // the ellipse point in the direction of pMove is pMove/sqrt(norm):
+        // no need of the polar angle
+        const float k = 1.0f/sqrtf(norm);
+        pMove.x = k*pMove.x;
+        pMove.y = k*pMove.y;
+        return true;
+      }
+    }
 
-        // then compute polar equation
-        float cosTheta = cosf(theta);
-        float sinTheta = sinf(theta);
-        float t = (a*b)/( sqrtf(b2*cosTheta*cosTheta + a2*sinTheta*sinTheta) );
+    /****************************
+    FOOT COLLISION MODEL
+    ****************************/
+    const unsigned int FootCollisionModel::MAX_VERTICES;
 
-        // finally compute new pMove
-        pMove.x = t*cosTheta;
-        pMove.y = t*sinTheta;
-        return true;
+    FootCollisionModel::FootCollisionModel(
+      const std::vector<AL::Math::Pose2D>& pLFootBoundingBox,
+      const std::vector<AL::Math::Pose2D>& pRFootBoundingBox,
+      const unsigned int                   pNbIteration):
+      fNbIteration(pNbIteration)
+    {
+      xInitPolygon(pLFootBoundingBox, fLFoot);
+      xInitPolygon(pRFootBoundingBox, fRFoot);
+    }
+
+
+    void FootCollisionModel::xInitPolygon(
+      const std::vector<AL::Math::Pose2D>& pBox,
+      Polygon&                             pPolygon)
+    {
+      if ((pBox.size() < 3) || (pBox.size() > MAX_VERTICES))
+      {
+        throw std::invalid_argument(
+          "ALMath: FootCollisionModel foot bounding box must have "
+          "between 3 and FootCollisionModel::MAX_VERTICES vertices.");
+      }
+
+      pPolygon.size = static_cast<unsigned int>(pBox.size());
+      for (unsigned int i=0; i<pPolygon.size; i++)
+      {
+        pPolygon.x[i] = pBox[i].x;
+        pPolygon.y[i] = pBox[i].y;
+      }
+      for (unsigned int i=0; i<pPolygon.size; i++)
+      {
+        const unsigned int iPlusOne = (i+1 == pPolygon.size) ? 0 : i+1;
+        pPolygon.nx[i] = -(pPolygon.y[iPlusOne] - pPolygon.y[i]);
+        pPolygon.ny[i] =   pPolygon.x[iPlusOne] - pPolygon.x[i];
+      }
+    } // end xInitPolygon()
+
+
+    bool FootCollisionModel::xIsInCollision(
+      const Polygon&          pFixed,
+      const Polygon&          pMoving,
+      const AL::Math::Pose2D& pMove)
+    {
+      float s = 0.0f;
+      float c = 0.0f;
+      Trig::sinCos(pMove.theta, s, c);
+
+      // moving polygon in the fixed foot frame
+      float mx[MAX_VERTICES];
+      float my[MAX_VERTICES];
+      float mnx[MAX_VERTICES];
+      float mny[MAX_VERTICES];
+      for (unsigned int i=0; i<pMoving.size; i++)
+      {
+        mx[i]  = pMove.x + c*pMoving.x[i] - s*pMoving.y[i];
+        my[i]  = pMove.y + s*pMoving.x[i] + c*pMoving.y[i];
+        mnx[i] = c*pMoving.nx[i] - s*pMoving.ny[i];
+        mny[i] = s*pMoving.nx[i] + c*pMoving.ny[i];
+      }
+
+      // separating axis test: the convex polygons are not in collision if
+      // their projections on one of the edge normals do not overlap.
+      // Touching polygons are not in collision.
+      const unsigned int nbAxis = pFixed.size + pMoving.size;
+      for (unsigned int a=0; a<nbAxis; a++)
+      {
+        const float ax = (a < pFixed.size) ? pFixed.nx[a] : mnx[a - pFixed.size];
+        const float ay = (a < pFixed.size) ? pFixed.ny[a] : mny[a - pFixed.size];
+
+        float minFixed = ax*pFixed.x[0] + ay*pFixed.y[0];
+        float maxFixed = minFixed;
+        for (unsigned int i=1; i<pFixed.size; i++)
+        {
+          const float p = ax*pFixed.x[i] + ay*pFixed.y[i];
+          minFixed = (p < minFixed) ? p : minFixed;
+          maxFixed = (p > maxFixed) ? p : maxFixed;
+        }
+
+        float minMoving = ax*mx[0] + ay*my[0];
+        float maxMoving = minMoving;
+        for (unsigned int i=1; i<pMoving.size; i++)
+        {
+          const float p = ax*mx[i] + ay*my[i];
+          minMoving = (p < minMoving) ? p : minMoving;
+          maxMoving = (p > maxMoving) ? p : maxMoving;
+        }
+
+        if ((maxFixed <= minMoving) || (maxMoving <= minFixed))
+        {
+          return false;
+        }
+      }
+      return true;
+    } // end xIsInCollision()
+
+
+    bool FootCollisionModel::isInCollision(
+      const bool              pIsLeftSupport,
+      const AL::Math::Pose2D& pMove) const
+    {
+      if (pIsLeftSupport)
+      {
+        return xIsInCollision(fLFoot, fRFoot, pMove);
+      }
+      return xIsInCollision(fRFoot, fLFoot, pMove);
+    }
+
+
+    bool FootCollisionModel::avoidCollision(
+      const bool        pIsLeftSupport,
+      AL::Math::Pose2D& pMove) const
+    {
+      const Polygon& fixedFoot  = pIsLeftSupport ? fLFoot : fRFoot;
+      const Polygon& movingFoot = pIsLeftSupport ? fRFoot : fLFoot;
+
+      if (!xIsInCollision(fixedFoot, movingFoot, pMove))
+      {
+        return false;
+      }
+
+      // dichotomy on the orientation, as xDichotomie
+      float min = 0.0f;
+      float max = pMove.theta;
+      float middle = 0.0f;
+      for (unsigned int i=0; i<fNbIteration; i++)
+      {
+        middle = (min + max)/2.0f;
+        pMove.theta = middle;
+        if (xIsInCollision(fixedFoot, movingFoot, pMove))
+          max = middle;
+        else
+          min = middle;
+      }
+      pMove.theta = (min + max)/2.0f;
+      return true;
+    } // end avoidCollision()
+
+
+    void FootCollisionModel::setNbIteration(const unsigned int pNbIteration)
+    {
+      fNbIteration = pNbIteration;
+    }
+
+
+    unsigned int FootCollisionModel::getNbIteration() const
+    {
+      return fNbIteration;
+    }
+
+
+    /****************************
+    BATCH
+    ****************************/
+    // <summary> Separating axis test of Simd::Traits<T>::WIDTH moves. </summary>
+    // Same test as FootCollisionModel::xIsInCollision, one move per lane.
+    template <typename T, typename Mask>
+    inline void FootCollisionModel::xIsInCollisionBatch(
+      const Polygon& pFixed,
+      const Polygon& pMoving,
+      const T&       pX,
+      const T&       pY,
+      const T&       pTheta,
+      Mask&          pIsInCollision)
+    {
+      T s, c;
+      Simd::sinCos(pTheta, s, c);
+
+      T mx[MAX_VERTICES];
+      T my[MAX_VERTICES];
+      T mnx[MAX_VERTICES];
+      T mny[MAX_VERTICES];
+      for (unsigned int i=0; i<pMoving.size; i++)
+      {
+        const T x  = Simd::splat<T>(pMoving.x[i]);
+        const T y  = Simd::splat<T>(pMoving.y[i]);
+        const T nx = Simd::splat<T>(pMoving.nx[i]);
+        const T ny = Simd::splat<T>(pMoving.ny[i]);
+        mx[i]  = pX + c*x - s*y;
+        my[i]  = pY + s*x + c*y;
+        mnx[i] = c*nx - s*ny;
+        mny[i] = s*nx + c*ny;
+      }
+
+      Mask separated = Simd::lessThan(pX, pX); // false
+      const unsigned int nbAxis = pFixed.size + pMoving.size;
+      for (unsigned int a=0; a<nbAxis; a++)
+      {
+        const T ax = (a < pFixed.size) ? Simd::splat<T>(pFixed.nx[a]) : mnx[a - pFixed.size];
+        const T ay = (a < pFixed.size) ? Simd::splat<T>(pFixed.ny[a]) : mny[a - pFixed.size];
+
+        T minFixed = ax*Simd::splat<T>(pFixed.x[0]) + ay*Simd::splat<T>(pFixed.y[0]);
+        T maxFixed = minFixed;
+        for (unsigned int i=1; i<pFixed.size; i++)
+        {
+          const T p = ax*Simd::splat<T>(pFixed.x[i]) + ay*Simd::splat<T>(pFixed.y[i]);
+          minFixed = Simd::min(minFixed, p);
+          maxFixed = Simd::max(maxFixed, p);
+        }
+
+        T minMoving = ax*mx[0] + ay*my[0];
+        T maxMoving = minMoving;
+        for (unsigned int i=1; i<pMoving.size; i++)
+        {
+          const T p = ax*mx[i] + ay*my[i];
+          minMoving = Simd::min(minMoving, p);
+          maxMoving = Simd::max(maxMoving, p);
+        }
+
+        separated = Simd::logicalOr(separated, Simd::logicalOr(
+                                      Simd::logicalNot(Simd::greaterThan(maxFixed, minMoving)),
+                                      Simd::logicalNot(Simd::greaterThan(maxMoving, minFixed))));
       }
+      pIsInCollision = Simd::logicalNot(separated);
     }
+
+
+    // <summary> Evaluate the Simd::Traits<T>::WIDTH moves at pIndex. </summary>
+    template <typename T>
+    inline void FootCollisionModel::xEvaluateFootsteps(
+      const Polygon&     pFixed,
+      const Polygon&     pMoving,
+      const unsigned int pNbIteration,
+      const float        pMaxFootX,
+      const float        pMaxFootY,
+      const unsigned int pIndex,
+      float*             pX,
+      float*             pY,
+      float*             pTheta,
+      bool*              pIsClipped,
+      bool*              pIsInCollision)
+    {
+      typedef typename Simd::Traits<T>::Mask Mask;
+      const T zero = Simd::splat<T>(0.0f);
+      const T one  = Simd::splat<T>(1.0f);
+      const T half = Simd::splat<T>(0.5f);
+
+      T x = Simd::load<T>(pX + pIndex);
+      T y = Simd::load<T>(pY + pIndex);
+      T theta = Simd::load<T>(pTheta + pIndex);
+
+      // clipFootWithEllipse: the clipped move is the intersection of the
+      // ellipse and the ray of the move, ie the move divided by sqrt(norm)
+      const float a = fabsf(pMaxFootX);
+      const float b = fabsf(pMaxFootY);
+      const T norm = x*x*Simd::splat<T>(1.0f/(a*a)) + y*y*Simd::splat<T>(1.0f/(b*b));
+      const Mask isClipped = Simd::logicalNot(Simd::lessThan(norm, Simd::splat<T>(1.00001f)));
+      const T scale = Simd::select(isClipped, one/Simd::sqrt(Simd::select(isClipped, norm, one)), one);
+      x = x*scale;
+      y = y*scale;
+
+      // avoidCollision: dichotomy on the orientation of the colliding lanes
+      Mask isInCollision;
+      xIsInCollisionBatch(pFixed, pMoving, x, y, theta, isInCollision);
+      if (Simd::any(isInCollision))
+      {
+        T min = zero;
+        T max = theta;
+        for (unsigned int i=0; i<pNbIteration; i++)
+        {
+          const T middle = (min + max)*half;
+          Mask collide;
+          xIsInCollisionBatch(pFixed, pMoving, x, y, middle, collide);
+          max = Simd::select(collide, middle, max);
+          min = Simd::select(collide, min, middle);
+        }
+        theta = Simd::select(isInCollision, (min + max)*half, theta);
+      }
+
+      Simd::store(pX + pIndex, x);
+      Simd::store(pY + pIndex, y);
+      Simd::store(pTheta + pIndex, theta);
+
+      float clipped[Simd::Traits<T>::WIDTH];
+      float collision[Simd::Traits<T>::WIDTH];
+      Simd::store(clipped, Simd::select(isClipped, one, zero));
+      Simd::store(collision, Simd::select(isInCollision, one, zero));
+      for (unsigned int i=0; i<static_cast<unsigned int>(Simd::Traits<T>::WIDTH); i++)
+      {
+        pIsClipped[pIndex + i] = (clipped[i] != 0.0f);
+        pIsInCollision[pIndex + i] = (collision[i] != 0.0f);
+      }
+    }
+
+
+    void FootCollisionModel::evaluateFootsteps(
+      const bool         pIsLeftSupport,
+      const float        pMaxFootX,
+      const float        pMaxFootY,
+      const unsigned int pSize,
+      float*             pX,
+      float*             pY,
+      float*             pTheta,
+      bool*              pIsClipped,
+      bool*              pIsInCollision) const
+    {
+      const Polygon& fixedFoot  = pIsLeftSupport ? fLFoot : fRFoot;
+      const Polygon& movingFoot = pIsLeftSupport ? fRFoot : fLFoot;
+
+      const int nbPacks = static_cast<int>(pSize/Simd::WIDTH);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (nbPacks > 64)
+#endif
+      for (int p=0; p<nbPacks; ++p)
+      {
+        xEvaluateFootsteps<Simd::Pack>(
+          fixedFoot, movingFoot, fNbIteration, pMaxFootX, pMaxFootY,
+          static_cast<unsigned int>(p)*static_cast<unsigned int>(Simd::WIDTH),
+          pX, pY, pTheta, pIsClipped, pIsInCollision);
+      }
+      for (unsigned int i=static_cast<unsigned int>(nbPacks)*static_cast<unsigned int>(Simd::WIDTH);
+           i<pSize; ++i)
+      {
+        xEvaluateFootsteps<float>(
+          fixedFoot, movingFoot, fNbIteration, pMaxFootX, pMaxFootY,
+          i, pX, pY, pTheta, pIsClipped, pIsInCollision);
+      }
+    }
+
   } // namespace Math
 } // namespace AL
 
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/types/aladjoint.h>
+#include <cmath>
+
+#include "../tools/alsimd.h"
+
+namespace AL {
+  namespace Math {
+
+    namespace {
+      // pOut = pA*pB, 3x3 matrices stored row by row
+      inline void xMultiply3(
+        const float* pA,
+        const float* pB,
+        float*       pOut)
+      {
+        for (unsigned int i=0; i<3; ++i)
+        {
+          for (unsigned int j=0; j<3; ++j)
+          {
+            pOut[3*i + j] = pA[3*i]*pB[j] + pA[3*i + 1]*pB[3 + j] +
+                pA[3*i + 2]*pB[6 + j];
+          }
+        }
+      }
+
+      inline void xTranspose3(
+        const float* pA,
+        float*       pOut)
+      {
+        for (unsigned int i=0; i<3; ++i)
+        {
+          for (unsigned int j=0; j<3; ++j)
+          {
+            pOut[3*i + j] = pA[3*j + i];
+          }
+        }
+      }
+
+      // The 6x6 matrix [M K; 0 M] (pLower false) or [M 0; K M]
+      // (pLower true), the shape of an Adjoint, of its transpose and of
+      // its inverse transpose.
+      template <typename T>
+      struct xBlocks
+      {
+        T    m[9];
+        T    k[9];
+        bool lower;
+
+        xBlocks(
+          const float* pM,
+          const float* pK,
+          const bool   pLower):
+          lower(pLower)
+        {
+          for (unsigned int i=0; i<9; ++i)
+          {
+            m[i] = Simd::splat<T>(pM[i]);
+            k[i] = Simd::splat<T>(pK[i]);
+          }
+        }
+
+        // apply to the Simd::Traits<T>::WIDTH Velocity6D from pIn
+        inline void apply(
+          const Velocity6D* pIn,
+          Velocity6D*       pOut) const
+        {
+          const std::size_t stride = sizeof(Velocity6D)/sizeof(float);
+          const float* in = &pIn->xd;
+          T v[6];
+          for (unsigned int i=0; i<6; ++i)
+          {
+            v[i] = Simd::gather<T>(in + i, stride);
+          }
+
+          // the block which is multiplied by K
+          const T* coupled = lower ? v : v + 3;
+          T res[6];
+          for (unsigned int i=0; i<3; ++i)
+          {
+            const T* mi = m + 3*i;
+            const T* ki = k + 3*i;
+            res[i]     = mi[0]*v[0] + mi[1]*v[1] + mi[2]*v[2];
+            res[i + 3] = mi[0]*v[3] + mi[1]*v[4] + mi[2]*v[5];
+            const T kv = ki[0]*coupled[0] + ki[1]*coupled[1] + ki[2]*coupled[2];
+            res[lower ? i + 3 : i] = res[lower ? i + 3 : i] + kv;
+          }
+
+          float* out = &pOut->xd;
+          for (unsigned int i=0; i<6; ++i)
+          {
+            Simd::scatter(out + i, stride, res[i]);
+          }
+        }
+      };
+
+      inline void xApplyBatch(
+        const float*       pM,
+        const float*       pK,
+        const bool         pLower,
+        const Velocity6D*  pIn,
+        const unsigned int pSize,
+        Velocity6D*        pOut)
+      {
+        const xBlocks<Simd::Pack> packBlocks(pM, pK, pLower);
+        unsigned int i = 0;
+        for (; i + Simd::WIDTH <= pSize; i += Simd::WIDTH)
+        {
+          packBlocks.apply(pIn + i, pOut + i);
+        }
+
+        const xBlocks<float> floatBlocks(pM, pK, pLower);
+        for (; i < pSize; ++i)
+        {
+          floatBlocks.apply(pIn + i, pOut + i);
+        }
+      }
+    }
+
+    const unsigned int Adjoint::SIZE;
+
+    Adjoint::Adjoint()
+    {
+      for (unsigned int i=0; i<9; ++i)
+      {
+        r[i]  = (i % 4 == 0) ? 1.0f : 0.0f;
+        pr[i] = 0.0f;
+      }
+    }
+
+    Adjoint::Adjoint(const Transform& pT)
+    {
+      r[0] = pT.r1_c1;
+      r[1] = pT.r1_c2;
+      r[2] = pT.r1_c3;
+      r[3] = pT.r2_c1;
+      r[4] = pT.r2_c2;
+      r[5] = pT.r2_c3;
+      r[6] = pT.r3_c1;
+      r[7] = pT.r3_c2;
+      r[8] = pT.r3_c3;
+
+      // [p]x R, column j being p x (column j of R)
+      const float px = pT.r1_c4;
+      const float py = pT.r2_c4;
+      const float pz = pT.r3_c4;
+      for (unsigned int j=0; j<3; ++j)
+      {
+        pr[j]     = py*r[6 + j] - pz*r[3 + j];
+        pr[3 + j] = pz*r[j] - px*r[6 + j];
+        pr[6 + j] = px*r[3 + j] - py*r[j];
+      }
+    }
+
+    Adjoint Adjoint::operator* (const Adjoint& pAd2) const
+    {
+      // [R1 K1; 0 R1]*[R2 K2; 0 R2] = [R1*R2 R1*K2 + K1*R2; 0 R1*R2]
+      Adjoint adOut;
+      float tmp[9];
+      xMultiply3(r, pAd2.r, adOut.r);
+      xMultiply3(r, pAd2.pr, adOut.pr);
+      xMultiply3(pr, pAd2.r, tmp);
+      for (unsigned int i=0; i<9; ++i)
+      {
+        adOut.pr[i] += tmp[i];
+      }
+      return adOut;
+    }
+
+    Velocity6D Adjoint::operator* (const Velocity6D& pV) const
+    {
+      Velocity6D vOut;
+      xBlocks<float>(r, pr, false).apply(&pV, &vOut);
+      return vOut;
+    }
+
+    Velocity6D Adjoint::transposeMultiply(const Velocity6D& pV) const
+    {
+      float rt[9];
+      float prt[9];
+      xTranspose3(r, rt);
+      xTranspose3(pr, prt);
+      Velocity6D vOut;
+      xBlocks<float>(rt, prt, true).apply(&pV, &vOut);
+      return vOut;
+    }
+
+    Velocity6D Adjoint::transformWrench(const Velocity6D& pWrench) const
+    {
+      Velocity6D wOut;
+      xBlocks<float>(r, pr, true).apply(&pWrench, &wOut);
+      return wOut;
+    }
+
+    Adjoint Adjoint::inverse() const
+    {
+      // [R K; 0 R]^-1 = [Rt -Rt*K*Rt; 0 Rt]
+      Adjoint adOut;
+      float tmp[9];
+      xTranspose3(r, adOut.r);
+      xMultiply3(adOut.r, pr, tmp);
+      xMultiply3(tmp, adOut.r, adOut.pr);
+      for (unsigned int i=0; i<9; ++i)
+      {
+        adOut.pr[i] = -adOut.pr[i];
+      }
+      return adOut;
+    }
+
+    bool Adjoint::isNear(
+      const Adjoint& pAd2,
+      const float&   pEpsilon) const
+    {
+      for (unsigned int i=0; i<9; ++i)
+      {
+        if ((fabsf(r[i] - pAd2.r[i]) > pEpsilon) ||
+            (fabsf(pr[i] - pAd2.pr[i]) > pEpsilon))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    void Adjoint::writeTo(float* pOut) const
+    {
+      for (unsigned int i=0; i<3; ++i)
+      {
+        for (unsigned int j=0; j<3; ++j)
+        {
+          pOut[6*i + j]           = r[3*i + j];
+          pOut[6*i + j + 3]       = pr[3*i + j];
+          pOut[6*(i + 3) + j]     = 0.0f;
+          pOut[6*(i + 3) + j + 3] = r[3*i + j];
+        }
+      }
+    }
+
+    void adjointMultiplyBatch(
+      const Adjoint&     pAd,
+      const Velocity6D*  pV,
+      const unsigned int pSize,
+      Velocity6D*        pOut)
+    {
+      xApplyBatch(pAd.r, pAd.pr, false, pV, pSize, pOut);
+    }
+
+    void adjointTransposeMultiplyBatch(
+      const Adjoint&     pAd,
+      const Velocity6D*  pV,
+      const unsigned int pSize,
+      Velocity6D*        pOut)
+    {
+      float rt[9];
+      float prt[9];
+      xTranspose3(pAd.r, rt);
+      xTranspose3(pAd.pr, prt);
+      xApplyBatch(rt, prt, true, pV, pSize, pOut);
+    }
+
+    void adjointTransformWrenchBatch(
+      const Adjoint&     pAd,
+      const Velocity6D*  pWrench,
+      const unsigned int pSize,
+      Velocity6D*        pOut)
+    {
+      xApplyBatch(pAd.r, pAd.pr, true, pWrench, pSize, pOut);
+    }
+
+  } // end namespace Math
+} // end namespace AL
@@ -5,26 +5,18 @@
  */
 
 #include <almath/types/alpose2d.h>
-#include <cmath>
+#include <almath/types/alpose2d.hxx>
 
 namespace AL {
   namespace Math {
 
-    Pose2D::Pose2D():x(0.0f), y(0.0f), theta(0.0f) {}
-
-    Pose2D::Pose2D(float pInit):x(pInit), y(pInit), theta(pInit) {}
+    const unsigned int Pose2D::SIZE;
 
     Pose2D::Pose2D(
-      float pX,
-      float pY,
-      float pTheta):
-      x(pX),
-      y(pY),
-      theta(pTheta) {}
-
-    Pose2D::Pose2D (const std::vector<float>& pFloats)
+      const float*       pFloats,
+      const unsigned int pSize)
     {
-      if (pFloats.size() == 3)
+      if (pSize == 3)
       {
         x = pFloats[0];
         y = pFloats[1];
@@ -38,174 +30,26 @@ namespace AL {
       }
     }
 
-    Pose2D Pose2D::operator+ (const Pose2D& pPos2) const
-    {
-      Pose2D res;
-      res.x = x + pPos2.x;
-      res.y = y + pPos2.y;
-      res.theta = theta + pPos2.theta;
-      return res;
-    }
-
-    Pose2D Pose2D::operator- (const Pose2D& pPos2) const
-    {
-      Pose2D res;
-      res.x = x - pPos2.x;
-      res.y = y - pPos2.y;
-      res.theta = theta - pPos2.theta;
-      return res;
-    }
-
-    Pose2D Pose2D::operator+ () const
-    {
-      Pose2D res;
-      res.x = x;
-      res.y = y;
-      res.theta = theta;
-      return res;
-    }
-
-    Pose2D Pose2D::operator- () const
-    {
-      Pose2D res;
-      res.x = -x;
-      res.y = -y;
-      res.theta = -theta;
-      return res;
-    }
-
-    Pose2D Pose2D::operator* (const Pose2D& pPos2) const
-    {
-      Pose2D pOut;
-      pOut.x = x + cosf(theta) * pPos2.x - sinf(theta) * pPos2.y;
-      pOut.y = y + sinf(theta) * pPos2.x + cosf(theta) * pPos2.y;
-      pOut.theta = theta + pPos2.theta;
-
-      return pOut;
-    }
-
-    Pose2D& Pose2D::operator*= (const Pose2D& pPos2)
-    {
-      x += cosf(theta) * pPos2.x - sinf(theta) * pPos2.y;
-      y += sinf(theta) * pPos2.x + cosf(theta) * pPos2.y;
-      theta += pPos2.theta;
-
-      return *this;
-    }
-
-    Pose2D& Pose2D::operator+= (const Pose2D& pPos2)
-    {
-      x     += pPos2.x;
-      y     += pPos2.y;
-      theta += pPos2.theta;
-      return *this;
-    }
-
-    Pose2D& Pose2D::operator-= (const Pose2D& pPos2)
-    {
-      x     -= pPos2.x;
-      y     -= pPos2.y;
-      theta -= pPos2.theta;
-      return *this;
-    }
-
-    bool Pose2D::operator==(const Pose2D& pPos2) const
-    {
-       if (
-         (x == pPos2.x) &&
-         (y == pPos2.y) &&
-         (theta == pPos2.theta) )
-       {
-        return true;
-      }
-      else
-      {
-        return false;
-      }
-    }
-
-    bool Pose2D::operator!=(const Pose2D& pPos2) const
+    Pose2D::Pose2D(const std::vector<float>& pFloats)
     {
-      return ! (*this==pPos2);
+      *this = Pose2D(pFloats.empty() ? 0 : &pFloats[0],
+                     static_cast<unsigned int>(pFloats.size()));
     }
 
-    float Pose2D::distanceSquared(const Pose2D& pPos) const
-    {
-      return Math::distanceSquared(*this, pPos);
-    }
 
-    float Pose2D::distance(const Pose2D& pPos2) const
+    void Pose2D::writeTo(float* pOut) const
     {
-      return Math::distance(*this, pPos2);
+      pOut[0] = x;
+      pOut[1] = y;
+      pOut[2] = theta;
     }
 
     std::vector<float> Pose2D::toVector() const
     {
-      std::vector<float> returnVector;
-      returnVector.resize(3);
-      returnVector[0] = x;
-      returnVector[1] = y;
-      returnVector[2] = theta;
-
+      std::vector<float> returnVector(SIZE);
+      writeTo(&returnVector[0]);
       return returnVector;
     }
 
-    float distanceSquared(
-      const Pose2D& pPos1,
-      const Pose2D& pPos2)
-    {
-      return (pPos1.x-pPos2.x)*(pPos1.x-pPos2.x)+(pPos1.y-pPos2.y)*(pPos1.y-pPos2.y);
-    }
-
-    float distance(
-      const Pose2D& pPos1,
-      const Pose2D& pPos2)
-    {
-      return sqrtf(distanceSquared(pPos1, pPos2));
-    }
-
-
-    bool Pose2D::isNear(
-      const Pose2D& pPos2,
-      const float&  pEpsilon) const
-    {
-
-      if (
-        (fabsf(x - pPos2.x) > pEpsilon) ||
-        (fabsf(y - pPos2.y) > pEpsilon) ||
-        (fabsf(theta - pPos2.theta) > pEpsilon))
-      {
-        return false;
-      }
-      else
-      {
-        return true;
-      }
-    }
-
-    Pose2D Pose2D::inverse() const
-    {
-      return Math::pose2DInverse(*this);
-    }
-
-    void pose2DInverse(
-      const Pose2D& pIn,
-      Pose2D&       pOut)
-    {
-      pOut.theta = -pIn.theta;
-
-      float cos = cosf(pOut.theta);
-      float sin = sinf(pOut.theta);
-
-      pOut.x = -( pIn.x*cos - pIn.y*sin);
-      pOut.y = -( pIn.y*cos + pIn.x*sin);
-    }
-
-    Pose2D pose2DInverse(const Pose2D& pIn)
-    {
-      Pose2D pOut;
-      pose2DInverse(pIn, pOut);
-      return pOut;
-    }
   } // end namespace math
 } // end namespace AL
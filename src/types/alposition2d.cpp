@@ -11,15 +11,19 @@
 namespace AL {
   namespace Math {
 
+    const unsigned int Position2D::SIZE;
+
     Position2D::Position2D() : x(0.0f), y(0.0f) {}
 
     Position2D::Position2D(float pInit) : x(pInit), y(pInit) {}
 
     Position2D::Position2D(float pX, float pY) : x(pX), y(pY) {}
 
-    Position2D::Position2D (const std::vector<float>& pFloats)
+    Position2D::Position2D(
+      const float*       pFloats,
+      const unsigned int pSize)
     {
-      if (pFloats.size() == 2)
+      if (pSize == 2)
       {
         x = pFloats[0];
         y = pFloats[1];
@@ -31,6 +35,12 @@ namespace AL {
       }
     }
 
+    Position2D::Position2D(const std::vector<float>& pFloats)
+    {
+      *this = Position2D(pFloats.empty() ? 0 : &pFloats[0],
+                         static_cast<unsigned int>(pFloats.size()));
+    }
+
     Position2D Position2D::operator+ (const Position2D& pPos2) const
     {
       Position2D res;
@@ -180,13 +190,16 @@ namespace AL {
       }
     }
 
-    std::vector<float> Position2D::toVector() const
+    void Position2D::writeTo(float* pOut) const
     {
-      std::vector<float> returnVector;
-      returnVector.resize(2);
-      returnVector[0] = x;
-      returnVector[1] = y;
+      pOut[0] = x;
+      pOut[1] = y;
+    }
 
+    std::vector<float> Position2D::toVector() const
+    {
+      std::vector<float> returnVector(SIZE);
+      writeTo(&returnVector[0]);
       return returnVector;
     }
 
@@ -11,6 +11,8 @@
 namespace AL {
   namespace Math {
 
+    const unsigned int Position6D::SIZE;
+
     Position6D::Position6D() : x(0.0f),
       y(0.0f),
       z(0.0f),
@@ -38,9 +40,11 @@ namespace AL {
       wy(pWy),
       wz(pWz) {}
 
-    Position6D::Position6D(const std::vector<float>& pFloats)
+    Position6D::Position6D(
+      const float*       pFloats,
+      const unsigned int pSize)
     {
-      if (pFloats.size() == 6)
+      if (pSize == 6)
       {
         x = pFloats[0];
         y = pFloats[1];
@@ -62,6 +66,12 @@ namespace AL {
       }
     }
 
+    Position6D::Position6D(const std::vector<float>& pFloats)
+    {
+      *this = Position6D(pFloats.empty() ? 0 : &pFloats[0],
+                         static_cast<unsigned int>(pFloats.size()));
+    }
+
     Position6D Position6D::operator+ (const Position6D& pPos2) const
     {
       Position6D res;
@@ -237,17 +247,20 @@ namespace AL {
       return Math::norm(*this);
     }
 
-    std::vector<float> Position6D::toVector() const
+    void Position6D::writeTo(float* pOut) const
     {
-      std::vector<float> returnVector;
-      returnVector.resize(6);
-      returnVector[0] = x;
-      returnVector[1] = y;
-      returnVector[2] = z;
-      returnVector[3] = wx;
-      returnVector[4] = wy;
-      returnVector[5] = wz;
+      pOut[0] = x;
+      pOut[1] = y;
+      pOut[2] = z;
+      pOut[3] = wx;
+      pOut[4] = wy;
+      pOut[5] = wz;
+    }
 
+    std::vector<float> Position6D::toVector() const
+    {
+      std::vector<float> returnVector(SIZE);
+      writeTo(&returnVector[0]);
       return returnVector;
     }
 
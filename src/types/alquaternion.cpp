@@ -5,25 +5,25 @@
  */
 
 #include <almath/types/alquaternion.h>
+#include <almath/types/alquaternion.hxx>
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 #include <almath/tools/altrigonometry.h>
 
+#include "../tools/alsimd.h"
+#include "../tools/altrigbackend.h"
+
 namespace AL {
   namespace Math {
 
-    Quaternion::Quaternion() : w(1.0f), x(0.0f), y(0.0f), z(0.0f) {}
+    const unsigned int Quaternion::SIZE;
 
     Quaternion::Quaternion(
-      float pW,
-      float pX,
-      float pY,
-      float pZ):
-      w(pW), x(pX), y(pY), z(pZ) {}
-
-    Quaternion::Quaternion(const std::vector<float>& pFloats)
+      const float*       pFloats,
+      const unsigned int pSize)
     {
-      if (pFloats.size() == 4)
+      if (pSize == 4)
       {
         w = pFloats[0];
         x = pFloats[1];
@@ -39,101 +39,10 @@ namespace AL {
       }
     }
 
-    Quaternion& Quaternion::operator*= (const Quaternion& pQua2)
-    {
-      float w1 = w;
-      float x1 = x;
-      float y1 = y;
-      float z1 = z;
-      w = w1*pQua2.w - x1*pQua2.x - y1*pQua2.y - z1*pQua2.z;
-      x = w1*pQua2.x + pQua2.w*x1 + y1*pQua2.z - z1*pQua2.y;
-      y = w1*pQua2.y + pQua2.w*y1 + z1*pQua2.x - x1*pQua2.z;
-      z = w1*pQua2.z + pQua2.w*z1 + x1*pQua2.y - y1*pQua2.x;
-      return *this;
-    }
-
-    Quaternion Quaternion::operator* (const Quaternion& pQua2) const
-    {
-      Quaternion qua;
-      qua.w = w*pQua2.w - x*pQua2.x - y*pQua2.y - z*pQua2.z;
-      qua.x = w*pQua2.x + pQua2.w*x + y*pQua2.z - z*pQua2.y;
-      qua.y = w*pQua2.y + pQua2.w*y + z*pQua2.x - x*pQua2.z;
-      qua.z = w*pQua2.z + pQua2.w*z + x*pQua2.y - y*pQua2.x;
-      return qua;
-    }
-
-
-    bool Quaternion::isNear(
-      const Quaternion& pQua2,
-      const float&      pEpsilon) const
-    {
-      if (
-          // |pQua1 - pQua2| < epsilon
-          (
-            (fabsf(w - pQua2.w) < pEpsilon) &&
-            (fabsf(x - pQua2.x) < pEpsilon) &&
-            (fabsf(y - pQua2.y) < pEpsilon) &&
-            (fabsf(z - pQua2.z) < pEpsilon)
-            ) ||
-          (
-            // |pQua1 + pQua2| < epsilon
-            (fabsf(w + pQua2.w) < pEpsilon) &&
-            (fabsf(x + pQua2.x) < pEpsilon) &&
-            (fabsf(y + pQua2.y) < pEpsilon) &&
-            (fabsf(z + pQua2.z) < pEpsilon)
-            )
-          )
-      {
-        return true;
-      }
-      else
-      {
-        return false;
-      }
-    }
-
-
-    Quaternion& Quaternion::operator*= (float pVal)
-    {
-      w *= pVal;
-      x *= pVal;
-      y *= pVal;
-      z *= pVal;
-      return *this;
-    }
-
-
-    Quaternion& Quaternion::operator/= (float pVal)
-    {
-      if (pVal == 0.0f)
-      {
-        throw std::runtime_error(
-          "ALQuaternion: operator/= Division by zeros.");
-      }
-      *this *= (1.0f/pVal);
-      return *this;
-    }
-
-
-    bool Quaternion::operator== (const Quaternion& pQua2) const
-    {
-      if(
-        (w == pQua2.w) &&
-        (x == pQua2.x) &&
-        (y == pQua2.y) &&
-        (z == pQua2.z))
-      {
-        return true;
-      }
-      else
-      {
-        return false;
-      }
-    }
-
-    bool Quaternion::operator!= (const Quaternion& pQua2) const
+    Quaternion::Quaternion(const std::vector<float>& pFloats)
     {
-      return !(*this==pQua2);
+      *this = Quaternion(pFloats.empty() ? 0 : &pFloats[0],
+                         static_cast<unsigned int>(pFloats.size()));
     }
 
 
@@ -145,8 +54,9 @@ namespace AL {
     {
       Quaternion qua = Quaternion();
 
-      float sin_a = sinf(0.5f*pAngle);
-      float cos_a = cosf(0.5f*pAngle);
+      float sin_a = 0.0f;
+      float cos_a = 0.0f;
+      Trig::sinCos(0.5f*pAngle, sin_a, cos_a);
 
       qua.w = cos_a;
       qua.x = pAxisX*sin_a;
@@ -172,72 +82,19 @@ namespace AL {
     }
 
 
-    std::vector<float> Quaternion::toVector() const
-    {
-      std::vector<float> returnVector;
-      returnVector.resize(4);
-      returnVector[0] = w;
-      returnVector[1] = x;
-      returnVector[2] = y;
-      returnVector[3] = z;
-
-      return returnVector;
-    }
-
-    float Quaternion::norm() const
-    {
-      return Math::norm(*this);
-    }
-
-    Quaternion Quaternion::normalize() const
-    {
-      return Math::normalize(*this);
-    }
-
-    float norm(const Quaternion& p)
-    {
-      return sqrtf( (p.w*p.w) + (p.x*p.x) + (p.y*p.y) + (p.z*p.z) );
-    }
-
-    Quaternion normalize(const Quaternion& pQua)
+    void Quaternion::writeTo(float* pOut) const
     {
-      Quaternion ret;
-      ret = pQua;
-      float tmpNorm = norm(pQua);
-
-      if (tmpNorm == 0.0f)
-      {
-        throw std::runtime_error(
-          "ALQuaternion: normalize Division by zeros.");
-      }
-
-      ret /= tmpNorm;
-      return ret;
+      pOut[0] = w;
+      pOut[1] = x;
+      pOut[2] = y;
+      pOut[3] = z;
     }
 
-
-    Quaternion Quaternion::inverse() const
-    {
-      return Math::quaternionInverse(*this);
-    }
-
-
-    void quaternionInverse(
-      const Quaternion& pQua,
-      Quaternion&       pQuaOut)
-    {
-      pQuaOut.w = pQua.w;
-      pQuaOut.x = -pQua.x;
-      pQuaOut.y = -pQua.y;
-      pQuaOut.z = -pQua.z;
-    }
-
-
-    Quaternion quaternionInverse(const Quaternion& pQua)
+    std::vector<float> Quaternion::toVector() const
     {
-      Quaternion pQuaOut;
-      quaternionInverse(pQua, pQuaOut);
-      return pQuaOut;
+      std::vector<float> returnVector(SIZE);
+      writeTo(&returnVector[0]);
+      return returnVector;
     }
 
 
@@ -250,7 +107,7 @@ namespace AL {
     {
       Quaternion copy = pQuaternion;
       copy.normalize();
-      pAngle          = 2.0f*acos(copy.w); // * AL::Math::_2_PI_;
+      pAngle          = 2.0f*acosf(copy.w); // * AL::Math::_2_PI_;
       float sin_angle = sqrtf(1.0f - powf(copy.w, 2));
 
       if (fabsf(sin_angle) < 0.0005f)
@@ -271,6 +128,266 @@ namespace AL {
       }
     }
 
+
+    Quaternion quaternionSlerp(
+      const Quaternion& pQua1,
+      const Quaternion& pQua2,
+      const float       pAlpha)
+    {
+      float cosAngle = pQua1.w*pQua2.w + pQua1.x*pQua2.x +
+          pQua1.y*pQua2.y + pQua1.z*pQua2.z;
+
+      // take the shortest path
+      float sign = 1.0f;
+      if (cosAngle < 0.0f)
+      {
+        cosAngle = -cosAngle;
+        sign     = -1.0f;
+      }
+
+      float k1 = 1.0f - pAlpha;
+      float k2 = pAlpha;
+      if (cosAngle < 0.9995f)
+      {
+        // same angle and trigonometry as quaternionSlerpBatch
+        const float sinAngle = sqrtf(std::max(1.0f - cosAngle*cosAngle, 0.0f));
+        const float angle    = Trig::atan2(sinAngle, cosAngle);
+        const float invSinus = 1.0f/sinAngle;
+        float s1, c1, s2, c2;
+        Trig::sinCos(k1*angle, s1, c1);
+        Trig::sinCos(k2*angle, s2, c2);
+        k1 = s1*invSinus;
+        k2 = s2*invSinus;
+      }
+      // else the quaternions are close: linear interpolation, normalized below
+      k2 *= sign;
+
+      Quaternion quaOut(
+        k1*pQua1.w + k2*pQua2.w,
+        k1*pQua1.x + k2*pQua2.x,
+        k1*pQua1.y + k2*pQua2.y,
+        k1*pQua1.z + k2*pQua2.z);
+      return quaOut.normalize();
+    }
+
+
+    /****************************
+    BATCH
+    ****************************/
+    namespace {
+      // The Simd::Traits<T>::WIDTH Quaternion at pQua, one per lane.
+      // Quaternion is 4 contiguous float: w, x, y, z.
+      template <typename T>
+      struct xQuaternions
+      {
+        T w, x, y, z;
+
+        explicit xQuaternions(const Quaternion* pQua)
+        {
+          Simd::load4(&pQua->w, w, x, y, z);
+        }
+
+        xQuaternions(const T& pW, const T& pX, const T& pY, const T& pZ):
+          w(pW), x(pX), y(pY), z(pZ) {}
+
+        void store(Quaternion* pQua) const
+        {
+          Simd::store4(&pQua->w, w, x, y, z);
+        }
+
+        T squaredNorm() const
+        {
+          return w*w + x*x + y*y + z*z;
+        }
+      };
+
+      template <typename T>
+      inline void xMultiply(
+        const Quaternion* pQua1,
+        const Quaternion* pQua2,
+        Quaternion*       pOut)
+      {
+        const xQuaternions<T> a(pQua1);
+        const xQuaternions<T> b(pQua2);
+        xQuaternions<T>(
+          a.w*b.w - a.x*b.x - a.y*b.y - a.z*b.z,
+          a.w*b.x + b.w*a.x + a.y*b.z - a.z*b.y,
+          a.w*b.y + b.w*a.y + a.z*b.x - a.x*b.z,
+          a.w*b.z + b.w*a.z + a.x*b.y - a.y*b.x).store(pOut);
+      }
+
+      template <typename T>
+      inline void xInverse(
+        const Quaternion* pQua,
+        Quaternion*       pOut)
+      {
+        const xQuaternions<T> a(pQua);
+        xQuaternions<T>(a.w, -a.x, -a.y, -a.z).store(pOut);
+      }
+
+      template <typename T>
+      inline void xNormalize(
+        const Quaternion* pQua,
+        Quaternion*       pOut)
+      {
+        const xQuaternions<T> a(pQua);
+        const T norm2 = a.squaredNorm();
+        if (Simd::any(Simd::logicalNot(
+                        Simd::greaterThan(norm2, Simd::splat<T>(0.0f)))))
+        {
+          throw std::runtime_error(
+            "ALQuaternion: normalize Division by zeros.");
+        }
+        const T r = Simd::rsqrt(norm2);
+        xQuaternions<T>(a.w*r, a.x*r, a.y*r, a.z*r).store(pOut);
+      }
+
+      // Branch free version of quaternionSlerp, or of quaternionNlerp if
+      // pIsSpherical is false.
+      template <typename T>
+      inline void xInterpolate(
+        const Quaternion* pQua1,
+        const Quaternion* pQua2,
+        const float       pAlpha,
+        const bool        pIsSpherical,
+        Quaternion*       pOut)
+      {
+        typedef typename Simd::Traits<T>::Mask Mask;
+        const xQuaternions<T> a(pQua1);
+        const xQuaternions<T> b(pQua2);
+        const T zero = Simd::splat<T>(0.0f);
+        const T one = Simd::splat<T>(1.0f);
+
+        // take the shortest path
+        T cosAngle = a.w*b.w + a.x*b.x + a.y*b.y + a.z*b.z;
+        const Mask isNegative = Simd::lessThan(cosAngle, zero);
+        cosAngle = Simd::abs(cosAngle);
+
+        T k1 = Simd::splat<T>(1.0f - pAlpha);
+        T k2 = Simd::splat<T>(pAlpha);
+        if (pIsSpherical)
+        {
+          // else the quaternions are close: linear interpolation
+          const Mask isFar = Simd::lessThan(cosAngle, Simd::splat<T>(0.9995f));
+          if (Simd::any(isFar))
+          {
+            const T sinAngle = Simd::sqrt(Simd::max(one - cosAngle*cosAngle, zero));
+            const T angle = Simd::atan2(sinAngle, cosAngle);
+            const T invSinus = one/Simd::select(isFar, sinAngle, one);
+            T s1, c1, s2, c2;
+            Simd::sinCos(k1*angle, s1, c1);
+            Simd::sinCos(k2*angle, s2, c2);
+            k1 = Simd::select(isFar, s1*invSinus, k1);
+            k2 = Simd::select(isFar, s2*invSinus, k2);
+          }
+        }
+        k2 = Simd::select(isNegative, -k2, k2);
+
+        const xQuaternions<T> c(
+          k1*a.w + k2*b.w,
+          k1*a.x + k2*b.x,
+          k1*a.y + k2*b.y,
+          k1*a.z + k2*b.z);
+        const T r = Simd::rsqrt(c.squaredNorm());
+        xQuaternions<T>(c.w*r, c.x*r, c.y*r, c.z*r).store(pOut);
+      }
+    }
+
+    Quaternion quaternionNlerp(
+      const Quaternion& pQua1,
+      const Quaternion& pQua2,
+      const float       pAlpha)
+    {
+      Quaternion quaOut;
+      xInterpolate<float>(&pQua1, &pQua2, pAlpha, false, &quaOut);
+      return quaOut;
+    }
+
+    void quaternionMultiplyBatch(
+      const Quaternion*  pQua1,
+      const Quaternion*  pQua2,
+      const unsigned int pSize,
+      Quaternion*        pOut)
+    {
+      unsigned int i = 0;
+      for (; i + Simd::WIDTH <= pSize; i += Simd::WIDTH)
+      {
+        xMultiply<Simd::Pack>(pQua1 + i, pQua2 + i, pOut + i);
+      }
+      for (; i < pSize; ++i)
+      {
+        xMultiply<float>(pQua1 + i, pQua2 + i, pOut + i);
+      }
+    }
+
+    void quaternionInverseBatch(
+      const Quaternion*  pQua,
+      const unsigned int pSize,
+      Quaternion*        pOut)
+    {
+      unsigned int i = 0;
+      for (; i + Simd::WIDTH <= pSize; i += Simd::WIDTH)
+      {
+        xInverse<Simd::Pack>(pQua + i, pOut + i);
+      }
+      for (; i < pSize; ++i)
+      {
+        xInverse<float>(pQua + i, pOut + i);
+      }
+    }
+
+    void quaternionNormalizeBatch(
+      const Quaternion*  pQua,
+      const unsigned int pSize,
+      Quaternion*        pOut)
+    {
+      unsigned int i = 0;
+      for (; i + Simd::WIDTH <= pSize; i += Simd::WIDTH)
+      {
+        xNormalize<Simd::Pack>(pQua + i, pOut + i);
+      }
+      for (; i < pSize; ++i)
+      {
+        xNormalize<float>(pQua + i, pOut + i);
+      }
+    }
+
+    void quaternionSlerpBatch(
+      const Quaternion*  pQua1,
+      const Quaternion*  pQua2,
+      const float        pAlpha,
+      const unsigned int pSize,
+      Quaternion*        pOut)
+    {
+      unsigned int i = 0;
+      for (; i + Simd::WIDTH <= pSize; i += Simd::WIDTH)
+      {
+        xInterpolate<Simd::Pack>(pQua1 + i, pQua2 + i, pAlpha, true, pOut + i);
+      }
+      for (; i < pSize; ++i)
+      {
+        xInterpolate<float>(pQua1 + i, pQua2 + i, pAlpha, true, pOut + i);
+      }
+    }
+
+    void quaternionNlerpBatch(
+      const Quaternion*  pQua1,
+      const Quaternion*  pQua2,
+      const float        pAlpha,
+      const unsigned int pSize,
+      Quaternion*        pOut)
+    {
+      unsigned int i = 0;
+      for (; i + Simd::WIDTH <= pSize; i += Simd::WIDTH)
+      {
+        xInterpolate<Simd::Pack>(pQua1 + i, pQua2 + i, pAlpha, false, pOut + i);
+      }
+      for (; i < pSize; ++i)
+      {
+        xInterpolate<float>(pQua1 + i, pQua2 + i, pAlpha, false, pOut + i);
+      }
+    }
+
   } // end namespace math
 } // end namespace al
 
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/types/alquattransform.h>
+#include <almath/tools/altransformhelpers.h>
+
+namespace AL {
+  namespace Math {
+
+    namespace {
+      // Rotate pPos by the unit quaternion pQua:
+      // t = 2*(v x pPos), pPos' = pPos + w*t + v x t
+      // with v the vector part of pQua.
+      inline Position3D xRotate(
+        const Quaternion& pQua,
+        const Position3D& pPos)
+      {
+        const float tx = 2.0f*(pQua.y*pPos.z - pQua.z*pPos.y);
+        const float ty = 2.0f*(pQua.z*pPos.x - pQua.x*pPos.z);
+        const float tz = 2.0f*(pQua.x*pPos.y - pQua.y*pPos.x);
+
+        return Position3D(
+          pPos.x + pQua.w*tx + pQua.y*tz - pQua.z*ty,
+          pPos.y + pQua.w*ty + pQua.z*tx - pQua.x*tz,
+          pPos.z + pQua.w*tz + pQua.x*ty - pQua.y*tx);
+      }
+    }
+
+    const unsigned int QuatTransform::SIZE;
+
+    QuatTransform::QuatTransform() {}
+
+    QuatTransform::QuatTransform(
+      const Quaternion& pQua,
+      const Position3D& pPos):
+      q(pQua), p(pPos) {}
+
+    QuatTransform::QuatTransform(const Transform& pT):
+      q(quaternionFromTransform(pT)),
+      p(pT.r1_c4, pT.r2_c4, pT.r3_c4) {}
+
+    QuatTransform::QuatTransform(
+      const float*       pFloats,
+      const unsigned int pSize)
+    {
+      if (pSize == SIZE)
+      {
+        q = Quaternion(pFloats[0], pFloats[1], pFloats[2], pFloats[3]);
+        p = Position3D(pFloats[4], pFloats[5], pFloats[6]);
+      }
+    }
+
+    QuatTransform& QuatTransform::operator*= (const QuatTransform& pQT2)
+    {
+      p += xRotate(q, pQT2.p);
+      q *= pQT2.q;
+      return *this;
+    }
+
+    QuatTransform QuatTransform::operator* (const QuatTransform& pQT2) const
+    {
+      return QuatTransform(q*pQT2.q, p + xRotate(q, pQT2.p));
+    }
+
+    Position3D QuatTransform::operator* (const Position3D& pPos) const
+    {
+      return p + xRotate(q, pPos);
+    }
+
+    bool QuatTransform::isNear(
+      const QuatTransform& pQT2,
+      const float&         pEpsilon) const
+    {
+      return (q.isNear(pQT2.q, pEpsilon) && p.isNear(pQT2.p, pEpsilon));
+    }
+
+    QuatTransform QuatTransform::inverse() const
+    {
+      return quatTransformInverse(*this);
+    }
+
+    QuatTransform QuatTransform::normalize() const
+    {
+      return QuatTransform(q.normalize(), p);
+    }
+
+    void QuatTransform::writeTo(float* pOut) const
+    {
+      pOut[0] = q.w;
+      pOut[1] = q.x;
+      pOut[2] = q.y;
+      pOut[3] = q.z;
+      pOut[4] = p.x;
+      pOut[5] = p.y;
+      pOut[6] = p.z;
+    }
+
+    Transform QuatTransform::toTransform() const
+    {
+      return transformFromQuatTransform(*this);
+    }
+
+    QuatTransform quatTransformInverse(const QuatTransform& pQT)
+    {
+      const Quaternion quaInv(pQT.q.w, -pQT.q.x, -pQT.q.y, -pQT.q.z);
+      const Position3D pos = xRotate(quaInv, pQT.p);
+      return QuatTransform(quaInv, Position3D(-pos.x, -pos.y, -pos.z));
+    }
+
+    QuatTransform quatTransformFromTransform(const Transform& pT)
+    {
+      return QuatTransform(pT);
+    }
+
+    Transform transformFromQuatTransform(const QuatTransform& pQT)
+    {
+      Transform tOut = transformFromQuaternion(pQT.q);
+      tOut.r1_c4 = pQT.p.x;
+      tOut.r2_c4 = pQT.p.y;
+      tOut.r3_c4 = pQT.p.z;
+      return tOut;
+    }
+
+    QuatTransform quatTransformInterpolation(
+      const QuatTransform& pQT1,
+      const QuatTransform& pQT2,
+      const float          pAlpha)
+    {
+      return QuatTransform(
+        quaternionSlerp(pQT1.q, pQT2.q, pAlpha),
+        pQT1.p + (pQT2.p - pQT1.p)*pAlpha);
+    }
+
+  } // end namespace math
+} // end namespace al
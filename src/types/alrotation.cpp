@@ -9,17 +9,23 @@
 #include <stdexcept>
 # include <cmath>
 
+#include "../tools/altrigbackend.h"
+
 namespace AL {
   namespace Math {
 
+  const unsigned int Rotation::SIZE;
+
   Rotation::Rotation():
     r1_c1(1.0f), r1_c2(0.0f), r1_c3(0.0f),
     r2_c1(0.0f), r2_c2(1.0f), r2_c3(0.0f),
     r3_c1(0.0f), r3_c2(0.0f), r3_c3(1.0f){}
 
-  Rotation::Rotation (const std::vector<float>& pFloats)
+  Rotation::Rotation(
+    const float*       pFloats,
+    const unsigned int pSize)
   {
-    if (pFloats.size() == 9)
+    if (pSize == 9)
     {
       r1_c1 = pFloats[0];
       r1_c2 = pFloats[1];
@@ -31,7 +37,7 @@ namespace AL {
       r3_c2 = pFloats[7];
       r3_c3 = pFloats[8];
     }
-    else if ((pFloats.size() == 12) || (pFloats.size() == 16))
+    else if ((pSize == 12) || (pSize == 16))
     {
       // if we give a transform, it take rotation part
       r1_c1 = pFloats[0];
@@ -62,6 +68,12 @@ namespace AL {
     }
   }
 
+  Rotation::Rotation(const std::vector<float>& pFloats)
+  {
+    *this = Rotation(pFloats.empty() ? 0 : &pFloats[0],
+                     static_cast<unsigned int>(pFloats.size()));
+  }
+
     Rotation& Rotation::operator*= (const Rotation& pRot2)
     {
       float c1 = r1_c1;
@@ -204,23 +216,23 @@ namespace AL {
     }
 
 
-    std::vector<float> Rotation::toVector() const
+    void Rotation::writeTo(float* pOut) const
     {
-      std::vector<float> returnVector;
-      returnVector.resize(9);
-
-      returnVector[0] = r1_c1;
-      returnVector[1] = r1_c2;
-      returnVector[2] = r1_c3;
-
-      returnVector[3] = r2_c1;
-      returnVector[4] = r2_c2;
-      returnVector[5] = r2_c3;
-
-      returnVector[6] = r3_c1;
-      returnVector[7] = r3_c2;
-      returnVector[8] = r3_c3;
+      pOut[0] = r1_c1;
+      pOut[1] = r1_c2;
+      pOut[2] = r1_c3;
+      pOut[3] = r2_c1;
+      pOut[4] = r2_c2;
+      pOut[5] = r2_c3;
+      pOut[6] = r3_c1;
+      pOut[7] = r3_c2;
+      pOut[8] = r3_c3;
+    }
 
+    std::vector<float> Rotation::toVector() const
+    {
+      std::vector<float> returnVector(SIZE);
+      writeTo(&returnVector[0]);
       return returnVector;
     }
 
@@ -304,12 +316,13 @@ namespace AL {
       }
 
       Rotation T = Rotation();
-      float t1 =  cosf(pAngle);
+      float t8 = 0.0f;
+      float t1 = 0.0f;
+      Trig::sinCos(pAngle, t8, t1);
       float t2 =  1.0f - t1;
       float t3 =  pX*pX;
       float t6 =  t2*pX;
       float t7 =  t6*pY;
-      float t8 =  sinf(pAngle);
       float t9 =  t8*pZ;
       float t11=  t6*pZ;
       float t12=  t8*pY;
@@ -347,8 +360,9 @@ namespace AL {
 
     Rotation rotationFromRotX(const float pRotX)
     {
-      float c = cosf(pRotX);
-      float s = sinf(pRotX);
+      float s = 0.0f;
+      float c = 0.0f;
+      Trig::sinCos(pRotX, s, c);
       Rotation T = Rotation();
       T.r2_c2 = c;
       T.r2_c3 = -s;
@@ -360,8 +374,9 @@ namespace AL {
 
     Rotation rotationFromRotY(const float pRotY)
     {
-      float c = cosf(pRotY);
-      float s = sinf(pRotY);
+      float s = 0.0f;
+      float c = 0.0f;
+      Trig::sinCos(pRotY, s, c);
       Rotation T = Rotation();
       T.r1_c1 = c;
       T.r1_c3 = s;
@@ -373,8 +388,9 @@ namespace AL {
 
     Rotation rotationFromRotZ(const float pRotZ)
     {
-      float c = cosf(pRotZ);
-      float s = sinf(pRotZ);
+      float s = 0.0f;
+      float c = 0.0f;
+      Trig::sinCos(pRotZ, s, c);
       Rotation T = Rotation();
       T.r1_c1 = c;
       T.r1_c2 = -s;
@@ -389,10 +405,27 @@ namespace AL {
       const float& pWY,
       const float& pWZ)
     {
+      float sx = 0.0f;
+      float cx = 0.0f;
+      float sy = 0.0f;
+      float cy = 0.0f;
+      float sz = 0.0f;
+      float cz = 0.0f;
+      Trig::sinCos(pWX, sx, cx);
+      Trig::sinCos(pWY, sy, cy);
+      Trig::sinCos(pWZ, sz, cz);
+
+      // rotZ(pWZ)*rotY(pWY)*rotX(pWX)
       Rotation T = Rotation();
-      T  = rotationFromRotZ(pWZ);
-      T *= rotationFromRotY(pWY);
-      T *= rotationFromRotX(pWX);
+      T.r1_c1 = cz*cy;
+      T.r1_c2 = cz*sy*sx - sz*cx;
+      T.r1_c3 = cz*sy*cx + sz*sx;
+      T.r2_c1 = sz*cy;
+      T.r2_c2 = sz*sy*sx + cz*cx;
+      T.r2_c3 = sz*sy*cx - cz*sx;
+      T.r3_c1 = -sy;
+      T.r3_c2 = cy*sx;
+      T.r3_c3 = cy*cx;
       return T;
     }
 
@@ -11,6 +11,8 @@
 namespace AL {
   namespace Math {
 
+  const unsigned int Rotation3D::SIZE;
+
   Rotation3D::Rotation3D(): wx(0.0f),
     wy(0.0f),
     wz(0.0f) {}
@@ -26,9 +28,11 @@ namespace AL {
     wy(pWy),
     wz(pWz) {}
 
-  Rotation3D::Rotation3D(const std::vector<float>& pFloats)
+  Rotation3D::Rotation3D(
+    const float*       pFloats,
+    const unsigned int pSize)
   {
-    if (pFloats.size() == 3)
+    if (pSize == 3)
     {
       wx = pFloats[0];
       wy = pFloats[1];
@@ -42,6 +46,12 @@ namespace AL {
     }
   }
 
+  Rotation3D::Rotation3D(const std::vector<float>& pFloats)
+  {
+    *this = Rotation3D(pFloats.empty() ? 0 : &pFloats[0],
+                       static_cast<unsigned int>(pFloats.size()));
+  }
+
     Rotation3D Rotation3D::operator+ (const Rotation3D& pRot2) const
     {
       Rotation3D res;
@@ -160,15 +170,17 @@ namespace AL {
     }
 
 
-    std::vector<float> Rotation3D::toVector() const
+    void Rotation3D::writeTo(float* pOut) const
     {
-      std::vector<float> returnVector;
-      returnVector.resize(3);
-
-      returnVector[0] = wx;
-      returnVector[1] = wy;
-      returnVector[2] = wz;
+      pOut[0] = wx;
+      pOut[1] = wy;
+      pOut[2] = wz;
+    }
 
+    std::vector<float> Rotation3D::toVector() const
+    {
+      std::vector<float> returnVector(SIZE);
+      writeTo(&returnVector[0]);
       return returnVector;
     }
 
@@ -5,21 +5,23 @@
  */
 
 #include <almath/types/altransform.h>
+#include <almath/types/altransform.hxx>
 #include <cmath>
 
+#include "../tools/altrigbackend.h"
+
 namespace AL {
   namespace Math {
 
-    Transform::Transform():
-        r1_c1(1.0f), r1_c2(0.0f), r1_c3(0.0f), r1_c4(0.0f),
-        r2_c1(0.0f), r2_c2(1.0f), r2_c3(0.0f), r2_c4(0.0f),
-        r3_c1(0.0f), r3_c2(0.0f), r3_c3(1.0f), r3_c4(0.0f) {}
+    const unsigned int Transform::SIZE;
 
-    Transform::Transform(const std::vector<float>& pFloats)
+    Transform::Transform(
+      const float*       pFloats,
+      const unsigned int pSize)
     {
       if (
-        (pFloats.size() == 12) ||
-        (pFloats.size() == 16))
+        (pSize == 12) ||
+        (pSize == 16))
       {
         r1_c1 = pFloats[0];
         r1_c2 = pFloats[1];
@@ -55,129 +57,10 @@ namespace AL {
       }
     }
 
-    Transform::Transform(
-      const float& pPosX,
-      const float& pPosY,
-      const float& pPosZ)
-    {
-      r1_c1 = 1.0f;
-      r1_c2 = 0.0f;
-      r1_c3 = 0.0f;
-
-      r2_c1 = 0.0f;
-      r2_c2 = 1.0f;
-      r2_c3 = 0.0f;
-
-      r3_c1 = 0.0f;
-      r3_c2 = 0.0f;
-      r3_c3 = 1.0f;
-
-      r1_c4 = pPosX;
-      r2_c4 = pPosY;
-      r3_c4 = pPosZ;
-    }
-
-    Transform& Transform::operator*= (const Transform& pT2)
-    {
-      float c1 = r1_c1;
-      float c2 = r1_c2;
-      float c3 = r1_c3;
-      r1_c1 = (c1 * pT2.r1_c1) + (c2 * pT2.r2_c1) + (c3 * pT2.r3_c1);
-      r1_c2 = (c1 * pT2.r1_c2) + (c2 * pT2.r2_c2) + (c3 * pT2.r3_c2);
-      r1_c3 = (c1 * pT2.r1_c3) + (c2 * pT2.r2_c3) + (c3 * pT2.r3_c3);
-      r1_c4 = (c1 * pT2.r1_c4) + (c2 * pT2.r2_c4) + (c3 * pT2.r3_c4) + r1_c4;
-      c1 = r2_c1;
-      c2 = r2_c2;
-      c3 = r2_c3;
-      r2_c1 = (c1 * pT2.r1_c1) + (c2 * pT2.r2_c1) + (c3 * pT2.r3_c1);
-      r2_c2 = (c1 * pT2.r1_c2) + (c2 * pT2.r2_c2) + (c3 * pT2.r3_c2);
-      r2_c3 = (c1 * pT2.r1_c3) + (c2 * pT2.r2_c3) + (c3 * pT2.r3_c3);
-      r2_c4 = (c1 * pT2.r1_c4) + (c2 * pT2.r2_c4) + (c3 * pT2.r3_c4) + r2_c4;
-      c1 = r3_c1;
-      c2 = r3_c2;
-      c3 = r3_c3;
-      r3_c1 = (c1 * pT2.r1_c1) + (c2 * pT2.r2_c1) + (c3 * pT2.r3_c1);
-      r3_c2 = (c1 * pT2.r1_c2) + (c2 * pT2.r2_c2) + (c3 * pT2.r3_c2);
-      r3_c3 = (c1 * pT2.r1_c3) + (c2 * pT2.r2_c3) + (c3 * pT2.r3_c3);
-      r3_c4 = (c1 * pT2.r1_c4) + (c2 * pT2.r2_c4) + (c3 * pT2.r3_c4) + r3_c4;
-      return *this;
-    }
-
-    Transform Transform::operator* (const Transform& pT2) const
-    {
-      Transform t;
-      t.r1_c1 = (r1_c1 * pT2.r1_c1) + (r1_c2 * pT2.r2_c1) + (r1_c3 * pT2.r3_c1);
-      t.r1_c2 = (r1_c1 * pT2.r1_c2) + (r1_c2 * pT2.r2_c2) + (r1_c3 * pT2.r3_c2);
-      t.r1_c3 = (r1_c1 * pT2.r1_c3) + (r1_c2 * pT2.r2_c3) + (r1_c3 * pT2.r3_c3);
-      t.r1_c4 = (r1_c1 * pT2.r1_c4) + (r1_c2 * pT2.r2_c4) + (r1_c3 * pT2.r3_c4) + r1_c4;
-
-      t.r2_c1 = (r2_c1 * pT2.r1_c1) + (r2_c2 * pT2.r2_c1) + (r2_c3 * pT2.r3_c1);
-      t.r2_c2 = (r2_c1 * pT2.r1_c2) + (r2_c2 * pT2.r2_c2) + (r2_c3 * pT2.r3_c2);
-      t.r2_c3 = (r2_c1 * pT2.r1_c3) + (r2_c2 * pT2.r2_c3) + (r2_c3 * pT2.r3_c3);
-      t.r2_c4 = (r2_c1 * pT2.r1_c4) + (r2_c2 * pT2.r2_c4) + (r2_c3 * pT2.r3_c4) + r2_c4;
-
-      t.r3_c1 = (r3_c1 * pT2.r1_c1) + (r3_c2 * pT2.r2_c1) + (r3_c3 * pT2.r3_c1);
-      t.r3_c2 = (r3_c1 * pT2.r1_c2) + (r3_c2 * pT2.r2_c2) + (r3_c3 * pT2.r3_c2);
-      t.r3_c3 = (r3_c1 * pT2.r1_c3) + (r3_c2 * pT2.r2_c3) + (r3_c3 * pT2.r3_c3);
-      t.r3_c4 = (r3_c1 * pT2.r1_c4) + (r3_c2 * pT2.r2_c4) + (r3_c3 * pT2.r3_c4) + r3_c4;
-      return t;
-    }
-
-    bool Transform::operator==(const Transform& pT2) const
-    {
-      if (
-        (r1_c1 == pT2.r1_c1) &&
-        (r1_c2 == pT2.r1_c2) &&
-        (r1_c3 == pT2.r1_c3) &&
-        (r1_c4 == pT2.r1_c4) &&
-        (r2_c1 == pT2.r2_c1) &&
-        (r2_c2 == pT2.r2_c2) &&
-        (r2_c3 == pT2.r2_c3) &&
-        (r2_c4 == pT2.r2_c4) &&
-        (r3_c1 == pT2.r3_c1) &&
-        (r3_c2 == pT2.r3_c2) &&
-        (r3_c3 == pT2.r3_c3) &&
-        (r3_c4 == pT2.r3_c4))
-      {
-        return true;
-      }
-      else
-      {
-        return false;
-      }
-    }
-
-    bool Transform::operator!=(const Transform& pT2) const
-    {
-      return !(*this==pT2);
-    }
-
-
-    bool Transform::isNear(
-      const Transform& pT2,
-      const float&     pEpsilon)const
+    Transform::Transform(const std::vector<float>& pFloats)
     {
-
-      if (
-        (fabsf(r1_c1 - pT2.r1_c1) > pEpsilon) ||
-        (fabsf(r1_c2 - pT2.r1_c2) > pEpsilon) ||
-        (fabsf(r1_c3 - pT2.r1_c3) > pEpsilon) ||
-        (fabsf(r2_c1 - pT2.r2_c1) > pEpsilon) ||
-        (fabsf(r2_c2 - pT2.r2_c2) > pEpsilon) ||
-        (fabsf(r2_c3 - pT2.r2_c3) > pEpsilon) ||
-        (fabsf(r3_c1 - pT2.r3_c1) > pEpsilon) ||
-        (fabsf(r3_c2 - pT2.r3_c2) > pEpsilon) ||
-        (fabsf(r3_c3 - pT2.r3_c3) > pEpsilon) ||
-        (fabsf(r1_c4 - pT2.r1_c4) > pEpsilon) ||
-        (fabsf(r2_c4 - pT2.r2_c4) > pEpsilon) ||
-        (fabsf(r3_c4 - pT2.r3_c4) > pEpsilon))
-      {
-        return false;
-      }
-      else
-      {
-        return true;
-      }
+      *this = Transform(pFloats.empty() ? 0 : &pFloats[0],
+                        static_cast<unsigned int>(pFloats.size()));
     }
 
 
@@ -246,11 +129,6 @@ namespace AL {
       return Math::determinant(*this);
     }
 
-    Transform Transform::inverse() const
-    {
-      return Math::transformInverse(*this);
-    }
-
 
     Transform Transform::fromRotX(const float pRotX)
     {
@@ -311,24 +189,28 @@ namespace AL {
       return Math::transformDistance(*this, pT2);
     }
 
-    std::vector<float> Transform::toVector() const
+    void Transform::writeTo(float* pOut) const
     {
-      std::vector<float> returnVector;
-      returnVector.resize(16);
-      returnVector[0]  = r1_c1;
-      returnVector[1]  = r1_c2;
-      returnVector[2]  = r1_c3;
-      returnVector[3]  = r1_c4;
+      pOut[0]  = r1_c1;
+      pOut[1]  = r1_c2;
+      pOut[2]  = r1_c3;
+      pOut[3]  = r1_c4;
 
-      returnVector[4]  = r2_c1;
-      returnVector[5]  = r2_c2;
-      returnVector[6]  = r2_c3;
-      returnVector[7]  = r2_c4;
+      pOut[4]  = r2_c1;
+      pOut[5]  = r2_c2;
+      pOut[6]  = r2_c3;
+      pOut[7]  = r2_c4;
 
-      returnVector[8]  = r3_c1;
-      returnVector[9]  = r3_c2;
-      returnVector[10] = r3_c3;
-      returnVector[11] = r3_c4;
+      pOut[8]  = r3_c1;
+      pOut[9]  = r3_c2;
+      pOut[10] = r3_c3;
+      pOut[11] = r3_c4;
+    }
+
+    std::vector<float> Transform::toVector() const
+    {
+      std::vector<float> returnVector(16);
+      writeTo(&returnVector[0]);
 
       returnVector[12] = 0.0f;
       returnVector[13] = 0.0f;
@@ -445,40 +327,11 @@ namespace AL {
     }
 
 
-    void transformInverse(
-      const Transform& pT,
-      Transform&       pTOut)
-    {
-      // rotation Ri = R'
-      pTOut.r1_c1 = pT.r1_c1;
-      pTOut.r1_c2 = pT.r2_c1;
-      pTOut.r1_c3 = pT.r3_c1;
-      pTOut.r2_c1 = pT.r1_c2;
-      pTOut.r2_c2 = pT.r2_c2;
-      pTOut.r2_c3 = pT.r3_c2;
-      pTOut.r3_c1 = pT.r1_c3;
-      pTOut.r3_c2 = pT.r2_c3;
-      pTOut.r3_c3 = pT.r3_c3;
-
-      // translation ri = -R'*r
-      pTOut.r1_c4 = -( pT.r1_c1*pT.r1_c4 + pT.r2_c1*pT.r2_c4 + pT.r3_c1*pT.r3_c4 );
-      pTOut.r2_c4 = -( pT.r1_c2*pT.r1_c4 + pT.r2_c2*pT.r2_c4 + pT.r3_c2*pT.r3_c4 );
-      pTOut.r3_c4 = -( pT.r1_c3*pT.r1_c4 + pT.r2_c3*pT.r2_c4 + pT.r3_c3*pT.r3_c4 );
-    }
-
-
-    Transform transformInverse(const Transform& pT)
-    {
-      Transform pTOut;
-      transformInverse(pT, pTOut);
-      return pTOut;
-    }
-
-
     Transform transformFromRotX(const float pRotX)
     {
-      float c = cosf(pRotX);
-      float s = sinf(pRotX);
+      float s = 0.0f;
+      float c = 0.0f;
+      Trig::sinCos(pRotX, s, c);
       Transform T = Transform();
       T.r2_c2 = c;
       T.r2_c3 = -s;
@@ -490,8 +343,9 @@ namespace AL {
 
     Transform transformFromRotY(const float pRotY)
     {
-      float c = cosf(pRotY);
-      float s = sinf(pRotY);
+      float s = 0.0f;
+      float c = 0.0f;
+      Trig::sinCos(pRotY, s, c);
       Transform T = Transform();
       T.r1_c1 = c;
       T.r1_c3 = s;
@@ -503,8 +357,9 @@ namespace AL {
 
     Transform transformFromRotZ(const float pRotZ)
     {
-      float c = cosf(pRotZ);
-      float s = sinf(pRotZ);
+      float s = 0.0f;
+      float c = 0.0f;
+      Trig::sinCos(pRotZ, s, c);
       Transform T = Transform();
       T.r1_c1 = c;
       T.r1_c2 = -s;
@@ -519,10 +374,27 @@ namespace AL {
       const float& pWY,
       const float& pWZ)
     {
+      float sx = 0.0f;
+      float cx = 0.0f;
+      float sy = 0.0f;
+      float cy = 0.0f;
+      float sz = 0.0f;
+      float cz = 0.0f;
+      Trig::sinCos(pWX, sx, cx);
+      Trig::sinCos(pWY, sy, cy);
+      Trig::sinCos(pWZ, sz, cz);
+
+      // rotZ(pWZ)*rotY(pWY)*rotX(pWX)
       Transform T = Transform();
-      T  = transformFromRotZ(pWZ);
-      T *= transformFromRotY(pWY);
-      T *= transformFromRotX(pWX);
+      T.r1_c1 = cz*cy;
+      T.r1_c2 = cz*sy*sx - sz*cx;
+      T.r1_c3 = cz*sy*cx + sz*sx;
+      T.r2_c1 = sz*cy;
+      T.r2_c2 = sz*sy*sx + cz*cx;
+      T.r2_c3 = sz*sy*cx - cz*sx;
+      T.r3_c1 = -sy;
+      T.r3_c2 = cy*sx;
+      T.r3_c3 = cy*cx;
       return T;
     }
 
@@ -556,27 +428,6 @@ namespace AL {
       return T;
     }
 
-    void transformInvertInPlace(Transform& pT)
-    {
-      float tmp0;
-      tmp0 = pT.r1_c2;
-      pT.r1_c2 = pT.r2_c1;
-      pT.r2_c1 = tmp0;
-
-      tmp0 = pT.r1_c3;
-      pT.r1_c3 = pT.r3_c1;
-      pT.r3_c1 = tmp0;
-
-      tmp0 = pT.r2_c3;
-      pT.r2_c3 = pT.r3_c2;
-      pT.r3_c2 = tmp0;
-
-      tmp0 =       -(pT.r1_c1 * pT.r1_c4 + pT.r1_c2 * pT.r2_c4 + pT.r1_c3 * pT.r3_c4);
-      float tmp1 = -(pT.r2_c1 * pT.r1_c4 + pT.r2_c2 * pT.r2_c4 + pT.r2_c3 * pT.r3_c4);
-      pT.r3_c4 =   -(pT.r3_c1 * pT.r1_c4 + pT.r3_c2 * pT.r2_c4 + pT.r3_c3 * pT.r3_c4);
-      pT.r2_c4 = tmp1;
-      pT.r1_c4 = tmp0;
-    }
 
     Transform pinv(const Transform& pT)
     {
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/types/altransformsoa.h>
+#include <stdexcept>
+
+#include "../tools/alsimd.h"
+
+namespace AL {
+  namespace Math {
+
+    TransformSoA::TransformSoA() {}
+
+    TransformSoA::TransformSoA(const unsigned int pSize)
+    {
+      resize(pSize);
+    }
+
+    unsigned int TransformSoA::size() const
+    {
+      return static_cast<unsigned int>(r1_c1.size());
+    }
+
+    void TransformSoA::resize(const unsigned int pSize)
+    {
+      r1_c1.resize(pSize, 1.0f);
+      r1_c2.resize(pSize, 0.0f);
+      r1_c3.resize(pSize, 0.0f);
+      r1_c4.resize(pSize, 0.0f);
+
+      r2_c1.resize(pSize, 0.0f);
+      r2_c2.resize(pSize, 1.0f);
+      r2_c3.resize(pSize, 0.0f);
+      r2_c4.resize(pSize, 0.0f);
+
+      r3_c1.resize(pSize, 0.0f);
+      r3_c2.resize(pSize, 0.0f);
+      r3_c3.resize(pSize, 1.0f);
+      r3_c4.resize(pSize, 0.0f);
+    }
+
+    void TransformSoA::set(
+      const unsigned int pIndex,
+      const Transform&   pT)
+    {
+      r1_c1[pIndex] = pT.r1_c1;
+      r1_c2[pIndex] = pT.r1_c2;
+      r1_c3[pIndex] = pT.r1_c3;
+      r1_c4[pIndex] = pT.r1_c4;
+
+      r2_c1[pIndex] = pT.r2_c1;
+      r2_c2[pIndex] = pT.r2_c2;
+      r2_c3[pIndex] = pT.r2_c3;
+      r2_c4[pIndex] = pT.r2_c4;
+
+      r3_c1[pIndex] = pT.r3_c1;
+      r3_c2[pIndex] = pT.r3_c2;
+      r3_c3[pIndex] = pT.r3_c3;
+      r3_c4[pIndex] = pT.r3_c4;
+    }
+
+    Transform TransformSoA::get(const unsigned int pIndex) const
+    {
+      Transform T;
+      T.r1_c1 = r1_c1[pIndex];
+      T.r1_c2 = r1_c2[pIndex];
+      T.r1_c3 = r1_c3[pIndex];
+      T.r1_c4 = r1_c4[pIndex];
+
+      T.r2_c1 = r2_c1[pIndex];
+      T.r2_c2 = r2_c2[pIndex];
+      T.r2_c3 = r2_c3[pIndex];
+      T.r2_c4 = r2_c4[pIndex];
+
+      T.r3_c1 = r3_c1[pIndex];
+      T.r3_c2 = r3_c2[pIndex];
+      T.r3_c3 = r3_c3[pIndex];
+      T.r3_c4 = r3_c4[pIndex];
+      return T;
+    }
+
+    /****************************
+    PRIVATE FUNCTION
+    ****************************/
+    // <summary> Multiply the Simd::Traits<T>::WIDTH Transform at pIndex. </summary>
+    // All the inputs are loaded before any store, so pOut may alias pA or pB.
+    template <typename T>
+    inline void xMultiply(
+      const TransformSoA& pA,
+      const TransformSoA& pB,
+      TransformSoA&       pOut,
+      const unsigned int  pIndex)
+    {
+      const T a11 = Simd::load<T>(&pA.r1_c1[pIndex]);
+      const T a12 = Simd::load<T>(&pA.r1_c2[pIndex]);
+      const T a13 = Simd::load<T>(&pA.r1_c3[pIndex]);
+      const T a14 = Simd::load<T>(&pA.r1_c4[pIndex]);
+      const T a21 = Simd::load<T>(&pA.r2_c1[pIndex]);
+      const T a22 = Simd::load<T>(&pA.r2_c2[pIndex]);
+      const T a23 = Simd::load<T>(&pA.r2_c3[pIndex]);
+      const T a24 = Simd::load<T>(&pA.r2_c4[pIndex]);
+      const T a31 = Simd::load<T>(&pA.r3_c1[pIndex]);
+      const T a32 = Simd::load<T>(&pA.r3_c2[pIndex]);
+      const T a33 = Simd::load<T>(&pA.r3_c3[pIndex]);
+      const T a34 = Simd::load<T>(&pA.r3_c4[pIndex]);
+
+      const T b11 = Simd::load<T>(&pB.r1_c1[pIndex]);
+      const T b12 = Simd::load<T>(&pB.r1_c2[pIndex]);
+      const T b13 = Simd::load<T>(&pB.r1_c3[pIndex]);
+      const T b14 = Simd::load<T>(&pB.r1_c4[pIndex]);
+      const T b21 = Simd::load<T>(&pB.r2_c1[pIndex]);
+      const T b22 = Simd::load<T>(&pB.r2_c2[pIndex]);
+      const T b23 = Simd::load<T>(&pB.r2_c3[pIndex]);
+      const T b24 = Simd::load<T>(&pB.r2_c4[pIndex]);
+      const T b31 = Simd::load<T>(&pB.r3_c1[pIndex]);
+      const T b32 = Simd::load<T>(&pB.r3_c2[pIndex]);
+      const T b33 = Simd::load<T>(&pB.r3_c3[pIndex]);
+      const T b34 = Simd::load<T>(&pB.r3_c4[pIndex]);
+
+      Simd::store(&pOut.r1_c1[pIndex], (a11 * b11) + (a12 * b21) + (a13 * b31));
+      Simd::store(&pOut.r1_c2[pIndex], (a11 * b12) + (a12 * b22) + (a13 * b32));
+      Simd::store(&pOut.r1_c3[pIndex], (a11 * b13) + (a12 * b23) + (a13 * b33));
+      Simd::store(&pOut.r1_c4[pIndex], (a11 * b14) + (a12 * b24) + (a13 * b34) + a14);
+
+      Simd::store(&pOut.r2_c1[pIndex], (a21 * b11) + (a22 * b21) + (a23 * b31));
+      Simd::store(&pOut.r2_c2[pIndex], (a21 * b12) + (a22 * b22) + (a23 * b32));
+      Simd::store(&pOut.r2_c3[pIndex], (a21 * b13) + (a22 * b23) + (a23 * b33));
+      Simd::store(&pOut.r2_c4[pIndex], (a21 * b14) + (a22 * b24) + (a23 * b34) + a24);
+
+      Simd::store(&pOut.r3_c1[pIndex], (a31 * b11) + (a32 * b21) + (a33 * b31));
+      Simd::store(&pOut.r3_c2[pIndex], (a31 * b12) + (a32 * b22) + (a33 * b32));
+      Simd::store(&pOut.r3_c3[pIndex], (a31 * b13) + (a32 * b23) + (a33 * b33));
+      Simd::store(&pOut.r3_c4[pIndex], (a31 * b14) + (a32 * b24) + (a33 * b34) + a34);
+    }
+
+    /****************************
+    PUBLIC FUNCTION
+    ****************************/
+    void transformMultiplyBatch(
+      const TransformSoA& pA,
+      const TransformSoA& pB,
+      TransformSoA&       pOut)
+    {
+      const unsigned int size = pA.size();
+      if (pB.size() != size)
+      {
+        throw std::invalid_argument(
+          "ALMath: transformMultiplyBatch Inputs must have the same size.");
+      }
+      pOut.resize(size);
+
+      unsigned int i = 0;
+      for (; i + Simd::WIDTH <= size; i += Simd::WIDTH)
+      {
+        xMultiply<Simd::Pack>(pA, pB, pOut, i);
+      }
+      for (; i < size; ++i)
+      {
+        xMultiply<float>(pA, pB, pOut, i);
+      }
+    }
+
+  } // end namespace Math
+} // end namespace AL
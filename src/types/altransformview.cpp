@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include <almath/types/altransformview.h>
+#include <almath/types/altransformview.hxx>
+#include <stdexcept>
+
+namespace AL {
+  namespace Math {
+
+    Position3DArrayView::Position3DArrayView(
+      float*             pData,
+      const unsigned int pSize,
+      const unsigned int pStride):
+      data(pData), size(pSize), stride(pStride)
+    {
+      if (pStride < Position3D::SIZE)
+      {
+        throw std::invalid_argument(
+          "ALMath: Position3DArrayView stride must be at least 3.");
+      }
+    }
+
+    TransformArrayView::TransformArrayView(
+      float*             pData,
+      const unsigned int pSize,
+      const unsigned int pStride):
+      data(pData), size(pSize), stride(pStride)
+    {
+      if (pStride < Transform::SIZE)
+      {
+        throw std::invalid_argument(
+          "ALMath: TransformArrayView stride must be at least 12.");
+      }
+    }
+
+  } // end namespace Math
+} // end namespace AL
@@ -11,6 +11,8 @@
 namespace AL {
   namespace Math {
 
+  const unsigned int Velocity3D::SIZE;
+
   Velocity3D::Velocity3D(): xd(0.0f),
     yd(0.0f),
     zd(0.0f) {}
@@ -27,9 +29,11 @@ namespace AL {
     yd(pYd),
     zd(pZd) {}
 
-  Velocity3D::Velocity3D(const std::vector<float>& pFloats)
+  Velocity3D::Velocity3D(
+    const float*       pFloats,
+    const unsigned int pSize)
   {
-    if (pFloats.size() == 3)
+    if (pSize == 3)
     {
       xd = pFloats[0];
       yd = pFloats[1];
@@ -43,6 +47,12 @@ namespace AL {
     }
   }
 
+  Velocity3D::Velocity3D(const std::vector<float>& pFloats)
+  {
+    *this = Velocity3D(pFloats.empty() ? 0 : &pFloats[0],
+                       static_cast<unsigned int>(pFloats.size()));
+  }
+
     Velocity3D Velocity3D::operator+ (const Velocity3D& pVel2) const
     {
       Velocity3D res;
@@ -196,15 +206,17 @@ namespace AL {
       return Math::normalize(*this);
     }
 
-    std::vector<float> Velocity3D::toVector() const
+    void Velocity3D::writeTo(float* pOut) const
     {
-      std::vector<float> returnVector;
-      returnVector.resize(3);
-
-      returnVector[0] = xd;
-      returnVector[1] = yd;
-      returnVector[2] = zd;
+      pOut[0] = xd;
+      pOut[1] = yd;
+      pOut[2] = zd;
+    }
 
+    std::vector<float> Velocity3D::toVector() const
+    {
+      std::vector<float> returnVector(SIZE);
+      writeTo(&returnVector[0]);
       return returnVector;
     }
 
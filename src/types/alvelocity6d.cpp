@@ -11,6 +11,8 @@
 namespace AL {
   namespace Math {
 
+  const unsigned int Velocity6D::SIZE;
+
   Velocity6D::Velocity6D():
     xd(0.0f),
     yd(0.0f),
@@ -41,9 +43,11 @@ namespace AL {
     wyd(pWyd),
     wzd(pWzd) {}
 
-  Velocity6D::Velocity6D(const std::vector<float>& pFloats)
+  Velocity6D::Velocity6D(
+    const float*       pFloats,
+    const unsigned int pSize)
   {
-    if (pFloats.size() == 6)
+    if (pSize == 6)
     {
       xd  = pFloats[0];
       yd  = pFloats[1];
@@ -63,6 +67,12 @@ namespace AL {
     }
   }
 
+  Velocity6D::Velocity6D(const std::vector<float>& pFloats)
+  {
+    *this = Velocity6D(pFloats.empty() ? 0 : &pFloats[0],
+                       static_cast<unsigned int>(pFloats.size()));
+  }
+
     Velocity6D Velocity6D::operator+ (const Velocity6D& pVel2) const
     {
       Velocity6D res;
@@ -216,19 +226,20 @@ namespace AL {
       return Math::normalize(*this);
     }
 
-    std::vector<float> Velocity6D::toVector() const
+    void Velocity6D::writeTo(float* pOut) const
     {
-      std::vector<float> returnVector;
-      returnVector.resize(6);
-
-      returnVector[0] = xd;
-      returnVector[1] = yd;
-      returnVector[2] = zd;
-
-      returnVector[3] = wxd;
-      returnVector[4] = wyd;
-      returnVector[5] = wzd;
+      pOut[0] = xd;
+      pOut[1] = yd;
+      pOut[2] = zd;
+      pOut[3] = wxd;
+      pOut[4] = wyd;
+      pOut[5] = wzd;
+    }
 
+    std::vector<float> Velocity6D::toVector() const
+    {
+      std::vector<float> returnVector(SIZE);
+      writeTo(&returnVector[0]);
       return returnVector;
     }
 
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+#include "albenchmark.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+#if defined(_WIN32)
+# include <windows.h>
+#else
+# include <time.h>
+#endif
+
+/****************************
+ALLOCATION COUNTER
+****************************/
+// The global operator new of the benchmark binary is replaced to count the
+// allocations done by the measured code.
+namespace {
+  unsigned long gAllocationCount = 0;
+
+  void* xAllocate(std::size_t pSize)
+  {
+    ++gAllocationCount;
+    void* p = std::malloc(pSize == 0 ? 1 : pSize);
+    if (p == 0)
+    {
+      throw std::bad_alloc();
+    }
+    return p;
+  }
+}
+
+#if __cplusplus >= 201103L
+# define ALMATH_BENCH_THROW_BAD_ALLOC
+# define ALMATH_BENCH_NO_THROW noexcept
+#else
+# define ALMATH_BENCH_THROW_BAD_ALLOC throw(std::bad_alloc)
+# define ALMATH_BENCH_NO_THROW throw()
+#endif
+
+void* operator new(std::size_t pSize) ALMATH_BENCH_THROW_BAD_ALLOC
+{
+  return xAllocate(pSize);
+}
+
+void* operator new[](std::size_t pSize) ALMATH_BENCH_THROW_BAD_ALLOC
+{
+  return xAllocate(pSize);
+}
+
+void operator delete(void* pPointer) ALMATH_BENCH_NO_THROW
+{
+  std::free(pPointer);
+}
+
+void operator delete[](void* pPointer) ALMATH_BENCH_NO_THROW
+{
+  std::free(pPointer);
+}
+
+#if defined(__cpp_sized_deallocation)
+void operator delete(void* pPointer, std::size_t) ALMATH_BENCH_NO_THROW
+{
+  std::free(pPointer);
+}
+
+void operator delete[](void* pPointer, std::size_t) ALMATH_BENCH_NO_THROW
+{
+  std::free(pPointer);
+}
+#endif
+
+namespace AL {
+  namespace Math {
+    namespace Bench {
+
+      /****************************
+      PRIVATE FUNCTION
+      ****************************/
+      // monotonic clock in nanoseconds
+      double xNow()
+      {
+#if defined(_WIN32)
+        LARGE_INTEGER counter, frequency;
+        QueryPerformanceCounter(&counter);
+        QueryPerformanceFrequency(&frequency);
+        return 1.0e9*static_cast<double>(counter.QuadPart)/
+            static_cast<double>(frequency.QuadPart);
+#else
+        struct timespec t;
+        clock_gettime(CLOCK_MONOTONIC, &t);
+        return 1.0e9*static_cast<double>(t.tv_sec) + static_cast<double>(t.tv_nsec);
+#endif
+      }
+
+#if !defined(__GNUC__)
+      void xEscape(const void* pPointer)
+      {
+        static const void* volatile sink = 0;
+        sink = pPointer;
+      }
+#endif
+
+      struct Benchmark
+      {
+        const char* name;
+        Function    function;
+      };
+
+      std::vector<Benchmark>& xRegistry()
+      {
+        static std::vector<Benchmark> registry;
+        return registry;
+      }
+
+      std::string xFormat(const char* pFormat, const double pValue)
+      {
+        char buffer[64];
+        std::sprintf(buffer, pFormat, pValue);
+        return buffer;
+      }
+
+      /****************************
+      STATE
+      ****************************/
+      State::State(const unsigned long pIterations):
+        fIterations(pIterations),
+        fCount(0),
+        fItems(1),
+        fStart(0.0),
+        fElapsedNs(0.0),
+        fAllocStart(0),
+        fAllocations(0) {}
+
+      bool State::keepRunning()
+      {
+        if (fCount == 0)
+        {
+          fAllocStart = gAllocationCount;
+          fStart = xNow();
+        }
+        if (fCount == fIterations)
+        {
+          fElapsedNs = xNow() - fStart;
+          fAllocations = gAllocationCount - fAllocStart;
+          return false;
+        }
+        ++fCount;
+        return true;
+      }
+
+      void State::setItemsPerIteration(const unsigned long pItems)
+      {
+        fItems = pItems;
+      }
+
+      unsigned long State::iterations() const
+      {
+        return fIterations;
+      }
+
+      unsigned long State::itemsPerIteration() const
+      {
+        return fItems;
+      }
+
+      double State::elapsedNs() const
+      {
+        return fElapsedNs;
+      }
+
+      unsigned long State::allocations() const
+      {
+        return fAllocations;
+      }
+
+      /****************************
+      PUBLIC FUNCTION
+      ****************************/
+      unsigned long allocationCount()
+      {
+        return gAllocationCount;
+      }
+
+      int registerBenchmark(
+        const char*    pName,
+        const Function pFunction)
+      {
+        Benchmark b;
+        b.name = pName;
+        b.function = pFunction;
+        xRegistry().push_back(b);
+        return static_cast<int>(xRegistry().size());
+      }
+
+      std::vector<Result> runBenchmarks(
+        const std::string& pFilter,
+        const double       pMinTime)
+      {
+        std::vector<Result> results;
+        const std::vector<Benchmark>& registry = xRegistry();
+        for (unsigned int i=0; i<registry.size(); i++)
+        {
+          const std::string name = registry[i].name;
+          if (name.find(pFilter) == std::string::npos)
+          {
+            continue;
+          }
+
+          // grow the number of iterations until the run lasts pMinTime
+          unsigned long iterations = 1;
+          State state(iterations);
+          while (true)
+          {
+            state = State(iterations);
+            registry[i].function(state);
+            const double elapsed = state.elapsedNs();
+            if ((elapsed >= 1.0e9*pMinTime) || (iterations >= 1000000000ul))
+            {
+              break;
+            }
+            double factor = (elapsed > 0.0) ? 1.4*1.0e9*pMinTime/elapsed : 100.0;
+            factor = (factor > 100.0) ? 100.0 : ((factor < 2.0) ? 2.0 : factor);
+            iterations = static_cast<unsigned long>(static_cast<double>(iterations)*factor);
+          }
+
+          const double count = static_cast<double>(state.iterations());
+          Result r;
+          r.name = name;
+          r.iterations = state.iterations();
+          r.nsPerOp = state.elapsedNs()/count;
+          r.itemsPerSecond = (state.elapsedNs() > 0.0) ?
+                1.0e9*count*static_cast<double>(state.itemsPerIteration())/
+                state.elapsedNs() : 0.0;
+          r.allocationsPerOp = static_cast<double>(state.allocations())/count;
+          results.push_back(r);
+        }
+        return results;
+      }
+
+      std::string toTable(const std::vector<Result>& pResults)
+      {
+        std::ostringstream out;
+        char line[256];
+        std::sprintf(line, "%-36s %14s %14s %14s %12s\n",
+                     "Benchmark", "Iterations", "ns/op", "items/s", "allocs/op");
+        out << line;
+        out << std::string(94, '-') << "\n";
+        for (unsigned int i=0; i<pResults.size(); i++)
+        {
+          const Result& r = pResults[i];
+          std::sprintf(line, "%-36s %14lu %14.2f %14.4g %12.2f\n",
+                       r.name.c_str(), r.iterations, r.nsPerOp,
+                       r.itemsPerSecond, r.allocationsPerOp);
+          out << line;
+        }
+        return out.str();
+      }
+
+      std::string toJson(const std::vector<Result>& pResults)
+      {
+        std::ostringstream out;
+        out << "{\n";
+        out << "  \"context\": {\n";
+        out << "    \"library\": \"almath\",\n";
+        out << "    \"float_size\": " << sizeof(float) << "\n";
+        out << "  },\n";
+        out << "  \"benchmarks\": [";
+        for (unsigned int i=0; i<pResults.size(); i++)
+        {
+          const Result& r = pResults[i];
+          out << ((i == 0) ? "\n" : ",\n");
+          out << "    {\n";
+          out << "      \"name\": \"" << r.name << "\",\n";
+          out << "      \"iterations\": " << r.iterations << ",\n";
+          out << "      \"ns_per_op\": " << xFormat("%.3f", r.nsPerOp) << ",\n";
+          out << "      \"items_per_second\": " << xFormat("%.6e", r.itemsPerSecond) << ",\n";
+          out << "      \"allocations_per_op\": " << xFormat("%.3f", r.allocationsPerOp) << "\n";
+          out << "    }";
+        }
+        out << "\n  ]\n}\n";
+        return out.str();
+      }
+
+    } // namespace Bench
+  } // namespace Math
+} // namespace AL
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+// Minimal benchmark harness for almath_bench, in the spirit of
+// Google Benchmark but without any dependency:
+//
+// ALMATH_BENCHMARK(TransformMultiply)
+// {
+//   AL::Math::Transform pT1, pT2;   // setup, not measured
+//   while (pState.keepRunning())
+//   {
+//     AL::Math::Bench::doNotOptimize(pT1*pT2);
+//   }
+// }
+//
+// Each benchmark reports ns/op, op/s (or items/s when the benchmark sets
+// the number of items processed per iteration) and heap allocations per op.
+
+#pragma once
+#ifndef _LIBALMATH_TEST_BENCH_ALBENCHMARK_H_
+#define _LIBALMATH_TEST_BENCH_ALBENCHMARK_H_
+
+#include <string>
+#include <vector>
+
+namespace AL {
+  namespace Math {
+    namespace Bench {
+
+      /// Number of heap allocations done since the start of the program.
+      unsigned long allocationCount();
+
+      class State
+      {
+      public:
+        explicit State(const unsigned long pIterations);
+
+        /// Return true while the measured loop must go on. The clock and the
+        /// allocation counter start at the first call and stop at the last.
+        bool keepRunning();
+
+        /// Number of items processed by one iteration (default 1).
+        void setItemsPerIteration(const unsigned long pItems);
+
+        unsigned long iterations() const;
+        unsigned long itemsPerIteration() const;
+        double elapsedNs() const;
+        unsigned long allocations() const;
+
+      private:
+        unsigned long fIterations;
+        unsigned long fCount;
+        unsigned long fItems;
+        double fStart;
+        double fElapsedNs;
+        unsigned long fAllocStart;
+        unsigned long fAllocations;
+      };
+
+      typedef void (*Function)(State& pState);
+
+      struct Result
+      {
+        std::string   name;
+        unsigned long iterations;
+        double        nsPerOp;
+        double        itemsPerSecond;
+        double        allocationsPerOp;
+      };
+
+      /// Register a benchmark, used by ALMATH_BENCHMARK.
+      int registerBenchmark(
+        const char*    pName,
+        const Function pFunction);
+
+      /// Run the registered benchmarks whose name contains pFilter, each
+      /// one during at least pMinTime seconds.
+      std::vector<Result> runBenchmarks(
+        const std::string& pFilter,
+        const double       pMinTime);
+
+      /// Write the results as a human readable table.
+      std::string toTable(const std::vector<Result>& pResults);
+
+      /// Write the results as JSON, stable format to diff between releases.
+      std::string toJson(const std::vector<Result>& pResults);
+
+#if defined(__GNUC__)
+      template <typename T>
+      inline void doNotOptimize(const T& pValue)
+      {
+        asm volatile("" : : "r"(&pValue) : "memory");
+      }
+#else
+      void xEscape(const void* pPointer);
+
+      template <typename T>
+      inline void doNotOptimize(const T& pValue)
+      {
+        xEscape(&pValue);
+      }
+#endif
+
+    } // namespace Bench
+  } // namespace Math
+} // namespace AL
+
+#define ALMATH_BENCHMARK(name)                                     \
+  static void almathBench##name(AL::Math::Bench::State& pState);   \
+  static const int almathBenchRegistered##name =                   \
+    AL::Math::Bench::registerBenchmark(#name, &almathBench##name); \
+  static void almathBench##name(AL::Math::Bench::State& pState)
+
+#endif  // _LIBALMATH_TEST_BENCH_ALBENCHMARK_H_
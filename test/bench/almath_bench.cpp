@@ -0,0 +1,1258 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+// almath_bench: microbenchmarks of the ALMath primitives.
+//
+// usage: almath_bench [--benchmark_filter=<substring>]
+//                     [--benchmark_min_time=<seconds>]
+//                     [--benchmark_out=<file.json>]
+
+#include "albenchmark.h"
+
+#include <almath/types/aladjoint.h>
+#include <almath/types/altransform.h>
+#include <almath/types/altransformsoa.h>
+#include <almath/types/alrotation.h>
+#include <almath/types/alrotation3d.h>
+#include <almath/types/alvelocity6d.h>
+#include <almath/types/alpose2d.h>
+#include <almath/types/alquaternion.h>
+#include <almath/types/alquattransform.h>
+#include <almath/types/albasictypes.h>
+#include <almath/tools/altransformhelpers.h>
+#include <almath/tools/alinterpolation.h>
+#include <almath/tools/alinversekinematics.h>
+#include <almath/tools/alkinematictree.h>
+#include <almath/tools/aldubinscurve.h>
+#include <almath/tools/avoidfootcollision.h>
+#include <almath/tools/almathio.h>
+#include <almath/tools/altrigonometry.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace {
+  const unsigned int BATCH_SIZE = 256;
+
+  AL::Math::Transform xTransform(const unsigned int pIndex)
+  {
+    const float k = 0.01f*static_cast<float>(pIndex % 100);
+    return AL::Math::Transform::fromPosition(
+          0.1f + k, -0.2f, 0.3f - k, 0.4f + k, -0.5f, 0.6f - k);
+  }
+
+  std::vector<AL::Math::Pose2D> xFootBoundingBox(const float pSide)
+  {
+    std::vector<AL::Math::Pose2D> box;
+    box.push_back(AL::Math::Pose2D( 0.080f,  0.044f + pSide*0.006f, 0.0f));
+    box.push_back(AL::Math::Pose2D( 0.080f, -0.044f + pSide*0.006f, 0.0f));
+    box.push_back(AL::Math::Pose2D(-0.047f, -0.044f + pSide*0.006f, 0.0f));
+    box.push_back(AL::Math::Pose2D(-0.047f,  0.044f + pSide*0.006f, 0.0f));
+    return box;
+  }
+}
+
+/****************************
+TRANSFORM
+****************************/
+ALMATH_BENCHMARK(TransformMultiply)
+{
+  const AL::Math::Transform pT1 = xTransform(1);
+  const AL::Math::Transform pT2 = xTransform(2);
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(pT1);
+    AL::Math::Bench::doNotOptimize(pT1*pT2);
+  }
+}
+
+ALMATH_BENCHMARK(TransformInverse)
+{
+  const AL::Math::Transform pT = xTransform(1);
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(pT);
+    AL::Math::Bench::doNotOptimize(AL::Math::transformInverse(pT));
+  }
+}
+
+ALMATH_BENCHMARK(TransformMultiplyBatch)
+{
+  AL::Math::TransformSoA pA(BATCH_SIZE);
+  AL::Math::TransformSoA pB(BATCH_SIZE);
+  AL::Math::TransformSoA pOut(BATCH_SIZE);
+  for (unsigned int i=0; i<BATCH_SIZE; i++)
+  {
+    pA.set(i, xTransform(i));
+    pB.set(i, xTransform(i + 7));
+  }
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::transformMultiplyBatch(pA, pB, pOut);
+    AL::Math::Bench::doNotOptimize(pOut);
+  }
+}
+
+namespace {
+  const unsigned int CLOUD_SIZE = 65536;
+
+  std::vector<float> xCloud()
+  {
+    std::vector<float> pXYZ(3*CLOUD_SIZE);
+    for (unsigned int i=0; i<3*CLOUD_SIZE; i++)
+    {
+      pXYZ[i] = 0.001f*static_cast<float>(i % 1000);
+    }
+    return pXYZ;
+  }
+}
+
+ALMATH_BENCHMARK(TransformPointsLoop)
+{
+  const AL::Math::Transform pT = xTransform(1);
+  const std::vector<float> pXYZ = xCloud();
+  std::vector<float> pOut(3*CLOUD_SIZE);
+  pState.setItemsPerIteration(CLOUD_SIZE);
+  while (pState.keepRunning())
+  {
+    for (unsigned int i=0; i<CLOUD_SIZE; i++)
+    {
+      const AL::Math::Position3D pPos = pT*AL::Math::Position3D(
+            pXYZ[3*i], pXYZ[3*i + 1], pXYZ[3*i + 2]);
+      pOut[3*i]     = pPos.x;
+      pOut[3*i + 1] = pPos.y;
+      pOut[3*i + 2] = pPos.z;
+    }
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(TransformPointsPacked)
+{
+  const AL::Math::Transform pT = xTransform(1);
+  const std::vector<float> pXYZ = xCloud();
+  std::vector<float> pOut(3*CLOUD_SIZE);
+  pState.setItemsPerIteration(CLOUD_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::transformPoints(pT, &pXYZ[0], CLOUD_SIZE, &pOut[0]);
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(TransformPointsSoA)
+{
+  const AL::Math::Transform pT = xTransform(1);
+  const std::vector<float> pXYZ = xCloud();
+  std::vector<float> pOut(3*CLOUD_SIZE);
+  pState.setItemsPerIteration(CLOUD_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::transformPoints(
+          pT, &pXYZ[0], &pXYZ[CLOUD_SIZE], &pXYZ[2*CLOUD_SIZE], CLOUD_SIZE,
+          &pOut[0], &pOut[CLOUD_SIZE], &pOut[2*CLOUD_SIZE]);
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(QuatTransformMultiply)
+{
+  const AL::Math::QuatTransform pQT1(xTransform(1));
+  const AL::Math::QuatTransform pQT2(xTransform(2));
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(pQT1);
+    AL::Math::Bench::doNotOptimize(pQT1*pQT2);
+  }
+}
+
+ALMATH_BENCHMARK(QuatTransformInverse)
+{
+  const AL::Math::QuatTransform pQT(xTransform(1));
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(pQT);
+    AL::Math::Bench::doNotOptimize(AL::Math::quatTransformInverse(pQT));
+  }
+}
+
+/****************************
+ADJOINT
+****************************/
+namespace {
+  std::vector<AL::Math::Velocity6D> xVelocities()
+  {
+    std::vector<AL::Math::Velocity6D> pV(BATCH_SIZE);
+    for (unsigned int i=0; i<BATCH_SIZE; i++)
+    {
+      const float k = 0.01f*static_cast<float>(i % 100);
+      pV[i] = AL::Math::Velocity6D(0.1f + k, -0.2f, 0.3f - k, 0.4f, -0.5f + k, 0.6f);
+    }
+    return pV;
+  }
+}
+
+ALMATH_BENCHMARK(AdjointMultiplyLoop)
+{
+  const AL::Math::Transform pT = xTransform(1);
+  const std::vector<AL::Math::Velocity6D> pV = xVelocities();
+  std::vector<AL::Math::Velocity6D> pOut(BATCH_SIZE);
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(pT);
+    for (unsigned int i=0; i<BATCH_SIZE; i++)
+    {
+      pOut[i] = AL::Math::Adjoint(pT)*pV[i];
+    }
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(AdjointMultiplyBatch)
+{
+  const AL::Math::Adjoint pAd(xTransform(1));
+  const std::vector<AL::Math::Velocity6D> pV = xVelocities();
+  std::vector<AL::Math::Velocity6D> pOut(BATCH_SIZE);
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::adjointMultiplyBatch(pAd, &pV[0], BATCH_SIZE, &pOut[0]);
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+namespace {
+  const unsigned int JACOBIAN_COLUMNS = 27;
+}
+
+ALMATH_BENCHMARK(ChangeReferenceJacobianLoop)
+{
+  const AL::Math::Transform pT = xTransform(1);
+  std::vector<AL::Math::Velocity6D> pJ = xVelocities();
+  pJ.resize(JACOBIAN_COLUMNS);
+  std::vector<AL::Math::Velocity6D> pOut(JACOBIAN_COLUMNS);
+  pState.setItemsPerIteration(JACOBIAN_COLUMNS);
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(pT);
+    for (unsigned int j=0; j<JACOBIAN_COLUMNS; j++)
+    {
+      AL::Math::changeReferenceVelocity6D(pT, pJ[j], pOut[j]);
+    }
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(ChangeReferenceJacobian)
+{
+  const AL::Math::Transform pT = xTransform(1);
+  std::vector<float> pJ(6*JACOBIAN_COLUMNS);
+  for (unsigned int i=0; i<pJ.size(); i++)
+  {
+    pJ[i] = 0.01f*static_cast<float>(i % 100);
+  }
+  std::vector<float> pOut(6*JACOBIAN_COLUMNS);
+  pState.setItemsPerIteration(JACOBIAN_COLUMNS);
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(pT);
+    AL::Math::changeReferenceJacobian(pT, &pJ[0], JACOBIAN_COLUMNS, &pOut[0]);
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+/****************************
+KINEMATICS
+****************************/
+namespace {
+  const unsigned int NB_JOINTS = 25;
+
+  // a chain of NB_JOINTS revolute joints, cycling through z, y and x
+  AL::Math::KinematicChain xChain()
+  {
+    AL::Math::KinematicChain chain;
+    for (unsigned int i=0; i<NB_JOINTS; i++)
+    {
+      chain.addLink(xTransform(i),
+                    static_cast<AL::Math::JointType>(
+                      AL::Math::JOINT_REVOLUTE_Z - i % 3));
+    }
+    return chain;
+  }
+
+  std::vector<float> xJointValues(const unsigned int pK)
+  {
+    std::vector<float> q(NB_JOINTS);
+    for (unsigned int i=0; i<NB_JOINTS; i++)
+    {
+      q[i] = 0.01f*static_cast<float>((i + pK) % 100);
+    }
+    return q;
+  }
+}
+
+ALMATH_BENCHMARK(ForwardKinematicsDense)
+{
+  std::vector<AL::Math::Transform> pOffsets(NB_JOINTS);
+  std::vector<AL::Math::Transform> pH(NB_JOINTS);
+  for (unsigned int i=0; i<NB_JOINTS; i++)
+  {
+    pOffsets[i] = xTransform(i);
+  }
+  const std::vector<float> q = xJointValues(0);
+  pState.setItemsPerIteration(NB_JOINTS);
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(q[0]);
+    AL::Math::Transform H;
+    for (unsigned int i=0; i<NB_JOINTS; i++)
+    {
+      const unsigned int axis = i % 3;
+      H = H*pOffsets[i]*(axis == 0 ? AL::Math::Transform::fromRotZ(q[i]) :
+                         axis == 1 ? AL::Math::Transform::fromRotY(q[i]) :
+                                     AL::Math::Transform::fromRotX(q[i]));
+      pH[i] = H;
+    }
+    AL::Math::Bench::doNotOptimize(pH[0]);
+  }
+}
+
+ALMATH_BENCHMARK(KinematicTreeUpdateAll)
+{
+  AL::Math::KinematicChain chain = xChain();
+  const std::vector<float> q0 = xJointValues(0);
+  const std::vector<float> q1 = xJointValues(1);
+  unsigned int k = 0;
+  pState.setItemsPerIteration(NB_JOINTS);
+  while (pState.keepRunning())
+  {
+    chain.setJointValues((++k % 2) ? &q0[0] : &q1[0]);
+    AL::Math::Bench::doNotOptimize(chain.getLinkTransforms()[0]);
+  }
+}
+
+ALMATH_BENCHMARK(KinematicTreeUpdateLast)
+{
+  AL::Math::KinematicChain chain = xChain();
+  chain.setJointValues(&xJointValues(0)[0]);
+  unsigned int k = 0;
+  pState.setItemsPerIteration(NB_JOINTS);
+  while (pState.keepRunning())
+  {
+    chain.setJointValue(NB_JOINTS - 1, (++k % 2) ? 0.1f : 0.2f);
+    AL::Math::Bench::doNotOptimize(chain.getLinkTransforms()[0]);
+  }
+}
+
+ALMATH_BENCHMARK(JacobianCrossProducts)
+{
+  AL::Math::KinematicChain chain = xChain();
+  chain.setJointValues(&xJointValues(0)[0]);
+  const std::vector<AL::Math::Transform>& H = chain.getLinkTransforms();
+  std::vector<float> J(6*NB_JOINTS);
+  pState.setItemsPerIteration(NB_JOINTS);
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(H[0]);
+    const AL::Math::Position3D p =
+        AL::Math::position3DFromTransform(H[NB_JOINTS - 1]);
+    for (unsigned int j=0; j<NB_JOINTS; j++)
+    {
+      const unsigned int axis = 2 - j % 3;
+      const AL::Math::Position3D a(
+            (&H[j].r1_c1)[axis], (&H[j].r2_c1)[axis], (&H[j].r3_c1)[axis]);
+      const AL::Math::Position3D v =
+          a.crossProduct(p - AL::Math::position3DFromTransform(H[j]));
+      J[j]                = v.x;
+      J[NB_JOINTS + j]    = v.y;
+      J[2*NB_JOINTS + j]  = v.z;
+      J[3*NB_JOINTS + j]  = a.x;
+      J[4*NB_JOINTS + j]  = a.y;
+      J[5*NB_JOINTS + j]  = a.z;
+    }
+    AL::Math::Bench::doNotOptimize(J[0]);
+  }
+}
+
+ALMATH_BENCHMARK(KinematicTreeJacobian)
+{
+  AL::Math::KinematicChain chain = xChain();
+  chain.setJointValues(&xJointValues(0)[0]);
+  std::vector<float> J(6*NB_JOINTS);
+  pState.setItemsPerIteration(NB_JOINTS);
+  while (pState.keepRunning())
+  {
+    chain.computeJacobian(NB_JOINTS - 1, AL::Math::Position3D(),
+                          AL::Math::AXIS_MASK_ALL, &J[0]);
+    AL::Math::Bench::doNotOptimize(J[0]);
+  }
+}
+
+ALMATH_BENCHMARK(InverseKinematicsTracking)
+{
+  // track two close targets in turn, warm started from the last solution
+  AL::Math::KinematicChain chain = xChain();
+  chain.setJointValues(&xJointValues(0)[0]);
+  const AL::Math::Transform pTarget0 = chain.getLinkTransform(NB_JOINTS - 1);
+  chain.setJointValues(&xJointValues(1)[0]);
+  const AL::Math::Transform pTarget1 = chain.getLinkTransform(NB_JOINTS - 1);
+
+  AL::Math::InverseKinematicsSolver solver(chain, NB_JOINTS - 1);
+  unsigned int k = 0;
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(
+          solver.solve((++k % 2) ? pTarget0 : pTarget1));
+  }
+}
+
+/****************************
+INTERPOLATION
+****************************/
+namespace {
+  const unsigned int NB_WAYPOINTS = 100;
+  const float WAYPOINT_PERIOD = 0.2f;
+  const float TICK_PERIOD = 0.01f;
+
+  AL::Math::JointTrajectory xTrajectory()
+  {
+    AL::Math::JointTrajectory trajectory(NB_JOINTS, AL::Math::INTERPOLATION_QUINTIC);
+    for (unsigned int k=0; k<NB_WAYPOINTS; k++)
+    {
+      trajectory.addWaypoint(WAYPOINT_PERIOD*static_cast<float>(k),
+                             &xJointValues(7*k)[0], &xJointValues(3*k)[0]);
+    }
+    return trajectory;
+  }
+}
+
+// the quintic computed from the waypoints at each tick, joint by joint
+ALMATH_BENCHMARK(QuinticFromWaypoints)
+{
+  std::vector<std::vector<float> > q(NB_WAYPOINTS);
+  std::vector<std::vector<float> > dq(NB_WAYPOINTS);
+  for (unsigned int k=0; k<NB_WAYPOINTS; k++)
+  {
+    q[k] = xJointValues(7*k);
+    dq[k] = xJointValues(3*k);
+  }
+  std::vector<AL::Math::PositionAndVelocity> pOut(NB_JOINTS);
+  const float finalTime = WAYPOINT_PERIOD*static_cast<float>(NB_WAYPOINTS - 1);
+  float time = 0.0f;
+  pState.setItemsPerIteration(NB_JOINTS);
+  while (pState.keepRunning())
+  {
+    time += TICK_PERIOD;
+    if (time >= finalTime)
+    {
+      time = 0.0f;
+    }
+    const unsigned int k = static_cast<unsigned int>(time/WAYPOINT_PERIOD);
+    const float s = time/WAYPOINT_PERIOD - static_cast<float>(k);
+    for (unsigned int j=0; j<NB_JOINTS; j++)
+    {
+      const float d  = q[k + 1][j] - q[k][j];
+      const float v0 = dq[k][j]*WAYPOINT_PERIOD;
+      const float v1 = dq[k + 1][j]*WAYPOINT_PERIOD;
+      const float c3 = 10.0f*d - 6.0f*v0 - 4.0f*v1;
+      const float c4 = -15.0f*d + 8.0f*v0 + 7.0f*v1;
+      const float c5 = 6.0f*d - 3.0f*v0 - 3.0f*v1;
+      pOut[j].q  = q[k][j] + s*(v0 + s*s*(c3 + s*(c4 + s*c5)));
+      pOut[j].dq = (v0 + s*s*(3.0f*c3 + s*(4.0f*c4 + s*5.0f*c5)))/WAYPOINT_PERIOD;
+    }
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(JointTrajectoryEvaluate)
+{
+  const AL::Math::JointTrajectory trajectory = xTrajectory();
+  std::vector<AL::Math::PositionAndVelocity> pOut(NB_JOINTS);
+  float time = 0.0f;
+  pState.setItemsPerIteration(NB_JOINTS);
+  while (pState.keepRunning())
+  {
+    time += TICK_PERIOD;
+    if (time >= trajectory.getFinalTime())
+    {
+      time = 0.0f;
+    }
+    trajectory.evaluate(time, &pOut[0]);
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(JointTrajectoryCursor)
+{
+  const AL::Math::JointTrajectory trajectory = xTrajectory();
+  AL::Math::JointTrajectoryCursor cursor(trajectory, TICK_PERIOD);
+  std::vector<AL::Math::PositionAndVelocity> pOut(NB_JOINTS);
+  pState.setItemsPerIteration(NB_JOINTS);
+  while (pState.keepRunning())
+  {
+    if (cursor.isFinished())
+    {
+      cursor.seek(trajectory.getStartTime());
+    }
+    cursor.next(&pOut[0]);
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+/****************************
+LOGARITHM / EXPONENTIAL
+****************************/
+ALMATH_BENCHMARK(TransformLogarithm)
+{
+  const AL::Math::Transform pT = xTransform(1);
+  AL::Math::Velocity6D pV;
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(pT);
+    AL::Math::transformLogarithmInPlace(pT, pV);
+    AL::Math::Bench::doNotOptimize(pV);
+  }
+}
+
+ALMATH_BENCHMARK(TransformLogarithmBatch)
+{
+  std::vector<AL::Math::Transform> pT(BATCH_SIZE);
+  std::vector<AL::Math::Velocity6D> pV(BATCH_SIZE);
+  for (unsigned int i=0; i<BATCH_SIZE; i++)
+  {
+    pT[i] = xTransform(i);
+  }
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::transformLogarithmBatch(&pT[0], BATCH_SIZE, &pV[0]);
+    AL::Math::Bench::doNotOptimize(pV[0]);
+  }
+}
+
+ALMATH_BENCHMARK(VelocityExponential)
+{
+  const AL::Math::Velocity6D pV(0.1f, -0.2f, 0.3f, 0.4f, -0.5f, 0.6f);
+  AL::Math::Transform pT;
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(pV);
+    AL::Math::velocityExponentialInPlace(pV, pT);
+    AL::Math::Bench::doNotOptimize(pT);
+  }
+}
+
+ALMATH_BENCHMARK(VelocityExponentialBatch)
+{
+  std::vector<AL::Math::Velocity6D> pV(BATCH_SIZE);
+  std::vector<AL::Math::Transform> pT(BATCH_SIZE);
+  for (unsigned int i=0; i<BATCH_SIZE; i++)
+  {
+    const float k = 0.01f*static_cast<float>(i % 100);
+    pV[i] = AL::Math::Velocity6D(0.1f, -0.2f, 0.3f, 0.4f + k, -0.5f, 0.6f - k);
+  }
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::velocityExponentialBatch(&pV[0], BATCH_SIZE, &pT[0]);
+    AL::Math::Bench::doNotOptimize(pT[0]);
+  }
+}
+
+namespace {
+  const unsigned int NB_SAMPLES = 200;
+}
+
+ALMATH_BENCHMARK(TransformMeanSamples)
+{
+  const AL::Math::Transform pHIn1 = xTransform(1);
+  const AL::Math::Transform pHIn2 = xTransform(70);
+  std::vector<AL::Math::Transform> pHOut(NB_SAMPLES);
+  pState.setItemsPerIteration(NB_SAMPLES);
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(pHIn1);
+    for (unsigned int i=0; i<NB_SAMPLES; i++)
+    {
+      AL::Math::transformMeanInPlace(
+            pHIn1, pHIn2,
+            static_cast<float>(i)/static_cast<float>(NB_SAMPLES - 1), pHOut[i]);
+    }
+    AL::Math::Bench::doNotOptimize(pHOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(TransformInterpolatorSamples)
+{
+  const AL::Math::Transform pHIn1 = xTransform(1);
+  const AL::Math::Transform pHIn2 = xTransform(70);
+  std::vector<AL::Math::Transform> pHOut(NB_SAMPLES);
+  pState.setItemsPerIteration(NB_SAMPLES);
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(pHIn1);
+    const AL::Math::TransformInterpolator interpolator(pHIn1, pHIn2);
+    for (unsigned int i=0; i<NB_SAMPLES; i++)
+    {
+      interpolator.interpolateInPlace(
+            static_cast<float>(i)/static_cast<float>(NB_SAMPLES - 1), pHOut[i]);
+    }
+    AL::Math::Bench::doNotOptimize(pHOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(TransformInterpolatorSampleBatch)
+{
+  const AL::Math::Transform pHIn1 = xTransform(1);
+  const AL::Math::Transform pHIn2 = xTransform(70);
+  std::vector<AL::Math::Transform> pHOut(NB_SAMPLES);
+  pState.setItemsPerIteration(NB_SAMPLES);
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(pHIn1);
+    const AL::Math::TransformInterpolator interpolator(pHIn1, pHIn2);
+    interpolator.sample(NB_SAMPLES, &pHOut[0]);
+    AL::Math::Bench::doNotOptimize(pHOut[0]);
+  }
+}
+
+/****************************
+ROTATION
+****************************/
+ALMATH_BENCHMARK(QuaternionFromTransform)
+{
+  const AL::Math::Transform pT = xTransform(1);
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(pT);
+    AL::Math::Bench::doNotOptimize(AL::Math::quaternionFromTransform(pT));
+  }
+}
+
+namespace {
+  void xQuaternions(
+    const unsigned int                 pK,
+    std::vector<AL::Math::Quaternion>& pQua)
+  {
+    pQua.resize(BATCH_SIZE);
+    for (unsigned int i=0; i<BATCH_SIZE; i++)
+    {
+      pQua[i] = AL::Math::quaternionFromTransform(
+            xTransform(pK + i));
+    }
+  }
+
+  // xTransform turned by pi around x, y or z, or not turned, in a
+  // pseudo random order: quaternionFromTransform takes each of its four
+  // branches without a pattern for the branch predictor.
+  AL::Math::Transform xSpreadTransform(const unsigned int pIndex)
+  {
+    const float pi = 3.14159265358979323846f;
+    switch (((pIndex*2654435761u) >> 16) % 4)
+    {
+    case 1:
+      return AL::Math::Transform::fromRotX(pi)*xTransform(pIndex);
+    case 2:
+      return AL::Math::Transform::fromRotY(pi)*xTransform(pIndex);
+    case 3:
+      return AL::Math::Transform::fromRotZ(pi)*xTransform(pIndex);
+    default:
+      return xTransform(pIndex);
+    }
+  }
+}
+
+ALMATH_BENCHMARK(QuaternionFromTransformLoop)
+{
+  std::vector<AL::Math::Transform> pT(BATCH_SIZE);
+  for (unsigned int i=0; i<BATCH_SIZE; i++)
+  {
+    pT[i] = xSpreadTransform(i);
+  }
+  std::vector<AL::Math::Quaternion> pOut(BATCH_SIZE);
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    for (unsigned int i=0; i<BATCH_SIZE; i++)
+    {
+      pOut[i] = AL::Math::quaternionFromTransform(pT[i]);
+    }
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(QuaternionFromTransformBatch)
+{
+  std::vector<AL::Math::Transform> pT(BATCH_SIZE);
+  for (unsigned int i=0; i<BATCH_SIZE; i++)
+  {
+    pT[i] = xSpreadTransform(i);
+  }
+  std::vector<AL::Math::Quaternion> pOut(BATCH_SIZE);
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::quaternionFromTransformBatch(&pT[0], BATCH_SIZE, &pOut[0]);
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(TransformFromQuaternionLoop)
+{
+  std::vector<AL::Math::Quaternion> pQua(BATCH_SIZE);
+  for (unsigned int i=0; i<BATCH_SIZE; i++)
+  {
+    pQua[i] = AL::Math::quaternionFromTransform(xSpreadTransform(i));
+  }
+  std::vector<AL::Math::Transform> pOut(BATCH_SIZE);
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    for (unsigned int i=0; i<BATCH_SIZE; i++)
+    {
+      pOut[i] = AL::Math::transformFromQuaternion(pQua[i]);
+    }
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(TransformFromQuaternionBatch)
+{
+  std::vector<AL::Math::Quaternion> pQua(BATCH_SIZE);
+  for (unsigned int i=0; i<BATCH_SIZE; i++)
+  {
+    pQua[i] = AL::Math::quaternionFromTransform(xSpreadTransform(i));
+  }
+  std::vector<AL::Math::Transform> pOut(BATCH_SIZE);
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::transformFromQuaternionBatch(&pQua[0], BATCH_SIZE, &pOut[0]);
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(QuaternionMultiply)
+{
+  std::vector<AL::Math::Quaternion> pQua1, pQua2;
+  xQuaternions(0, pQua1);
+  xQuaternions(37, pQua2);
+  std::vector<AL::Math::Quaternion> pOut(BATCH_SIZE);
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    for (unsigned int i=0; i<BATCH_SIZE; i++)
+    {
+      pOut[i] = pQua1[i]*pQua2[i];
+    }
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(QuaternionMultiplyBatch)
+{
+  std::vector<AL::Math::Quaternion> pQua1, pQua2;
+  xQuaternions(0, pQua1);
+  xQuaternions(37, pQua2);
+  std::vector<AL::Math::Quaternion> pOut(BATCH_SIZE);
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::quaternionMultiplyBatch(&pQua1[0], &pQua2[0], BATCH_SIZE, &pOut[0]);
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(QuaternionNormalize)
+{
+  std::vector<AL::Math::Quaternion> pQua;
+  xQuaternions(0, pQua);
+  std::vector<AL::Math::Quaternion> pOut(BATCH_SIZE);
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    for (unsigned int i=0; i<BATCH_SIZE; i++)
+    {
+      pOut[i] = pQua[i].normalize();
+    }
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(QuaternionNormalizeBatch)
+{
+  std::vector<AL::Math::Quaternion> pQua;
+  xQuaternions(0, pQua);
+  std::vector<AL::Math::Quaternion> pOut(BATCH_SIZE);
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::quaternionNormalizeBatch(&pQua[0], BATCH_SIZE, &pOut[0]);
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(QuaternionSlerp)
+{
+  std::vector<AL::Math::Quaternion> pQua1, pQua2;
+  xQuaternions(0, pQua1);
+  xQuaternions(37, pQua2);
+  std::vector<AL::Math::Quaternion> pOut(BATCH_SIZE);
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    for (unsigned int i=0; i<BATCH_SIZE; i++)
+    {
+      pOut[i] = AL::Math::quaternionSlerp(pQua1[i], pQua2[i], 0.3f);
+    }
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(QuaternionSlerpBatch)
+{
+  std::vector<AL::Math::Quaternion> pQua1, pQua2;
+  xQuaternions(0, pQua1);
+  xQuaternions(37, pQua2);
+  std::vector<AL::Math::Quaternion> pOut(BATCH_SIZE);
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::quaternionSlerpBatch(&pQua1[0], &pQua2[0], 0.3f, BATCH_SIZE, &pOut[0]);
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(QuaternionNlerpBatch)
+{
+  std::vector<AL::Math::Quaternion> pQua1, pQua2;
+  xQuaternions(0, pQua1);
+  xQuaternions(37, pQua2);
+  std::vector<AL::Math::Quaternion> pOut(BATCH_SIZE);
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::quaternionNlerpBatch(&pQua1[0], &pQua2[0], 0.3f, BATCH_SIZE, &pOut[0]);
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(Rotation3DFromRotation)
+{
+  const AL::Math::Rotation pR = AL::Math::rotationFromTransform(xTransform(1));
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(pR);
+    AL::Math::Bench::doNotOptimize(AL::Math::rotation3DFromRotation(pR));
+  }
+}
+
+ALMATH_BENCHMARK(Position6DFromTransformLoop)
+{
+  std::vector<AL::Math::Transform> pT(BATCH_SIZE);
+  for (unsigned int i=0; i<BATCH_SIZE; i++)
+  {
+    pT[i] = xTransform(i);
+  }
+  std::vector<AL::Math::Position6D> pOut(BATCH_SIZE);
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    for (unsigned int i=0; i<BATCH_SIZE; i++)
+    {
+      AL::Math::position6DFromTransformInPlace(pT[i], pOut[i]);
+    }
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(Position6DFromTransformBatch)
+{
+  std::vector<AL::Math::Transform> pT(BATCH_SIZE);
+  for (unsigned int i=0; i<BATCH_SIZE; i++)
+  {
+    pT[i] = xTransform(i);
+  }
+  std::vector<AL::Math::Position6D> pOut(BATCH_SIZE);
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::position6DFromTransformBatch(&pT[0], BATCH_SIZE, &pOut[0]);
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(TransformFrom3DRotation)
+{
+  const float pWX = 0.4f;
+  const float pWY = -0.5f;
+  const float pWZ = 0.6f;
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(pWX);
+    AL::Math::Bench::doNotOptimize(
+          AL::Math::transformFrom3DRotation(pWX, pWY, pWZ));
+  }
+}
+
+/****************************
+TRIGONOMETRY
+****************************/
+// the scalar benchmarks read their inputs from arrays, as the batch ones:
+// inputs known at compile time would let the compiler fold the libm calls
+namespace {
+  std::vector<float> xAngles()
+  {
+    std::vector<float> angles(BATCH_SIZE);
+    for (unsigned int i=0; i<BATCH_SIZE; i++)
+    {
+      angles[i] = -3.0f + 0.02f*static_cast<float>(i);
+    }
+    return angles;
+  }
+}
+
+ALMATH_BENCHMARK(LibmSinCos)
+{
+  const std::vector<float> pAngles = xAngles();
+  std::vector<float> pSin(BATCH_SIZE);
+  std::vector<float> pCos(BATCH_SIZE);
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    for (unsigned int i=0; i<BATCH_SIZE; i++)
+    {
+      pSin[i] = sinf(pAngles[i]);
+      pCos[i] = cosf(pAngles[i]);
+    }
+    AL::Math::Bench::doNotOptimize(pSin[0]);
+  }
+}
+
+ALMATH_BENCHMARK(FastSinCos)
+{
+  const std::vector<float> pAngles = xAngles();
+  std::vector<float> pSin(BATCH_SIZE);
+  std::vector<float> pCos(BATCH_SIZE);
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    for (unsigned int i=0; i<BATCH_SIZE; i++)
+    {
+      AL::Math::fastSinCos(pAngles[i], pSin[i], pCos[i]);
+    }
+    AL::Math::Bench::doNotOptimize(pSin[0]);
+  }
+}
+
+ALMATH_BENCHMARK(FastSinCosBatch)
+{
+  const std::vector<float> pAngles = xAngles();
+  std::vector<float> pSin(BATCH_SIZE);
+  std::vector<float> pCos(BATCH_SIZE);
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::fastSinCosBatch(&pAngles[0], BATCH_SIZE, &pSin[0], &pCos[0]);
+    AL::Math::Bench::doNotOptimize(pSin[0]);
+  }
+}
+
+ALMATH_BENCHMARK(LibmAtan2)
+{
+  const std::vector<float> pAngles = xAngles();
+  std::vector<float> pOut(BATCH_SIZE);
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    for (unsigned int i=0; i<BATCH_SIZE; i++)
+    {
+      pOut[i] = atan2f(pAngles[i], 0.7f - pAngles[BATCH_SIZE - 1 - i]);
+    }
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(FastAtan2)
+{
+  const std::vector<float> pAngles = xAngles();
+  std::vector<float> pOut(BATCH_SIZE);
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    for (unsigned int i=0; i<BATCH_SIZE; i++)
+    {
+      pOut[i] = AL::Math::fastAtan2(pAngles[i], 0.7f - pAngles[BATCH_SIZE - 1 - i]);
+    }
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+/****************************
+WALK
+****************************/
+ALMATH_BENCHMARK(GetDubinsSolutions)
+{
+  const AL::Math::Pose2D pTarget(0.5f, 0.5f, 0.0f);
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(pTarget);
+    AL::Math::Bench::doNotOptimize(AL::Math::getDubinsSolutions(pTarget, 0.1f));
+  }
+}
+
+ALMATH_BENCHMARK(GetDubinsSolutionsNoAlloc)
+{
+  const AL::Math::Pose2D pTarget(0.5f, 0.5f, 0.0f);
+  AL::Math::DubinsSolutions pSolutions;
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(pTarget);
+    AL::Math::Bench::doNotOptimize(
+          AL::Math::getDubinsSolutions(pTarget, 0.1f, pSolutions));
+    AL::Math::Bench::doNotOptimize(pSolutions);
+  }
+}
+
+ALMATH_BENCHMARK(GetDubinsSolutionsBatch)
+{
+  std::vector<AL::Math::Pose2D> pTargets(BATCH_SIZE);
+  for (unsigned int i=0; i<BATCH_SIZE; i++)
+  {
+    const float k = 0.01f*static_cast<float>(i % 100);
+    pTargets[i] = AL::Math::Pose2D(0.5f + k, 0.5f - k, 0.3f*k);
+  }
+  std::vector<AL::Math::DubinsStatus> pStatus(BATCH_SIZE);
+  AL::Math::DubinsSolutions pSolutions[BATCH_SIZE];
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(AL::Math::getDubinsSolutionsBatch(
+                                     &pTargets[0], BATCH_SIZE, 0.1f,
+                                     pSolutions, &pStatus[0]));
+  }
+}
+
+ALMATH_BENCHMARK(ComputeDubinsPath)
+{
+  const AL::Math::Pose2D pStart;
+  const AL::Math::Pose2D pTarget(0.5f, 0.5f, 0.0f);
+  AL::Math::DubinsPath pPath;
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(pTarget);
+    AL::Math::computeDubinsPath(pStart, pTarget, 0.1f, pPath);
+    AL::Math::Bench::doNotOptimize(pPath.length());
+  }
+}
+
+ALMATH_BENCHMARK(AvoidFootCollision)
+{
+  const std::vector<AL::Math::Pose2D> pLFoot = xFootBoundingBox(1.0f);
+  const std::vector<AL::Math::Pose2D> pRFoot = xFootBoundingBox(-1.0f);
+  const AL::Math::Pose2D pMoveInit(0.0f, 0.085f, 0.7f);
+  AL::Math::Pose2D pMove;
+  while (pState.keepRunning())
+  {
+    pMove = pMoveInit;
+    AL::Math::Bench::doNotOptimize(AL::Math::avoidFootCollision(
+                                     pLFoot, pRFoot, false, pMove));
+    AL::Math::Bench::doNotOptimize(pMove);
+  }
+}
+
+ALMATH_BENCHMARK(FootCollisionModel)
+{
+  const AL::Math::FootCollisionModel pModel(
+        xFootBoundingBox(1.0f), xFootBoundingBox(-1.0f));
+  const AL::Math::Pose2D pMoveInit(0.0f, 0.085f, 0.7f);
+  AL::Math::Pose2D pMove;
+  while (pState.keepRunning())
+  {
+    pMove = pMoveInit;
+    AL::Math::Bench::doNotOptimize(pModel.avoidCollision(false, pMove));
+    AL::Math::Bench::doNotOptimize(pMove);
+  }
+}
+
+ALMATH_BENCHMARK(EvaluateFootsteps)
+{
+  const AL::Math::FootCollisionModel pModel(
+        xFootBoundingBox(1.0f), xFootBoundingBox(-1.0f));
+  std::vector<float> pXInit(BATCH_SIZE), pYInit(BATCH_SIZE), pThetaInit(BATCH_SIZE);
+  for (unsigned int i=0; i<BATCH_SIZE; i++)
+  {
+    pXInit[i] = 0.01f*static_cast<float>(i % 16) - 0.08f;
+    pYInit[i] = 0.06f + 0.01f*static_cast<float>(i / 16);
+    pThetaInit[i] = 0.7f;
+  }
+  std::vector<float> pX, pY, pTheta;
+  bool pIsClipped[BATCH_SIZE];
+  bool pIsInCollision[BATCH_SIZE];
+  pState.setItemsPerIteration(BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    pX = pXInit;
+    pY = pYInit;
+    pTheta = pThetaInit;
+    pModel.evaluateFootsteps(false, 0.08f, 0.16f, BATCH_SIZE,
+                             &pX[0], &pY[0], &pTheta[0],
+                             pIsClipped, pIsInCollision);
+    AL::Math::Bench::doNotOptimize(pTheta[0]);
+  }
+}
+
+/****************************
+VALUE TYPES
+****************************/
+ALMATH_BENCHMARK(Pose2DdAccumulate)
+{
+  const AL::Math::Pose2D pStep(0.01f, 0.001f, 0.002f);
+  pState.setItemsPerIteration(100);
+  while (pState.keepRunning())
+  {
+    AL::Math::Pose2Dd pOdometry;
+    for (unsigned int i=0; i<100; i++)
+    {
+      pOdometry *= pStep;
+    }
+    AL::Math::Bench::doNotOptimize(pOdometry);
+  }
+}
+
+// see almath_bench_inline.cpp for the same loops with ALMATH_INLINE_TYPES
+#define ALMATH_TYPES_BENCHMARK(name) ALMATH_BENCHMARK(name)
+#include "almath_bench_types.h"
+
+/****************************
+IO
+****************************/
+ALMATH_BENCHMARK(TransformStream)
+{
+  const AL::Math::Transform pT = xTransform(1);
+  while (pState.keepRunning())
+  {
+    std::ostringstream out;
+    out << pT;
+    AL::Math::Bench::doNotOptimize(out);
+  }
+}
+
+ALMATH_BENCHMARK(TransformToSpaceSeparated)
+{
+  const AL::Math::Transform pT = xTransform(1);
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(AL::Math::toSpaceSeparated(pT));
+  }
+}
+
+ALMATH_BENCHMARK(Velocity6DToSpaceSeparated)
+{
+  const AL::Math::Velocity6D pV(0.1f, -0.2f, 0.3f, 0.4f, -0.5f, 0.6f);
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(AL::Math::toSpaceSeparated(pV));
+  }
+}
+
+ALMATH_BENCHMARK(TransformToVector)
+{
+  const AL::Math::Transform pT = xTransform(1);
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(pT.toVector());
+  }
+}
+
+ALMATH_BENCHMARK(TransformWriteTo)
+{
+  const AL::Math::Transform pT = xTransform(1);
+  float pOut[AL::Math::Transform::SIZE];
+  while (pState.keepRunning())
+  {
+    pT.writeTo(pOut);
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_BENCHMARK(TransformFromVector)
+{
+  const std::vector<float> pIn = xTransform(1).toVector();
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(AL::Math::Transform(pIn));
+  }
+}
+
+ALMATH_BENCHMARK(TransformFromFloatBuffer)
+{
+  float pIn[AL::Math::Transform::SIZE];
+  xTransform(1).writeTo(pIn);
+  while (pState.keepRunning())
+  {
+    AL::Math::Bench::doNotOptimize(
+          AL::Math::Transform(pIn, AL::Math::Transform::SIZE));
+  }
+}
+
+/****************************
+MAIN
+****************************/
+int main(int argc, char* argv[])
+{
+  std::string filter;
+  std::string outFile;
+  double minTime = 0.2;
+
+  for (int i=1; i<argc; i++)
+  {
+    const std::string arg = argv[i];
+    if (arg.find("--benchmark_filter=") == 0)
+    {
+      filter = arg.substr(std::strlen("--benchmark_filter="));
+    }
+    else if (arg.find("--benchmark_min_time=") == 0)
+    {
+      minTime = std::atof(arg.substr(std::strlen("--benchmark_min_time=")).c_str());
+    }
+    else if (arg.find("--benchmark_out=") == 0)
+    {
+      outFile = arg.substr(std::strlen("--benchmark_out="));
+    }
+    else
+    {
+      std::cerr << "usage: " << argv[0]
+                << " [--benchmark_filter=<substring>]"
+                << " [--benchmark_min_time=<seconds>]"
+                << " [--benchmark_out=<file.json>]" << std::endl;
+      return 1;
+    }
+  }
+
+  const std::vector<AL::Math::Bench::Result> results =
+      AL::Math::Bench::runBenchmarks(filter, minTime);
+  std::cout << AL::Math::Bench::toTable(results);
+
+  if (!outFile.empty())
+  {
+    std::ofstream out(outFile.c_str());
+    if (!out)
+    {
+      std::cerr << "almath_bench: cannot write " << outFile << std::endl;
+      return 1;
+    }
+    out << AL::Math::Bench::toJson(results);
+  }
+  return 0;
+}
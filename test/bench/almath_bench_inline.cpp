@@ -0,0 +1,14 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+// The benchmarks of almath_bench_types.h with the arithmetic of the core
+// value types inline, to compare with the out-of-line calls.
+#define ALMATH_INLINE_TYPES
+
+#include "albenchmark.h"
+
+#define ALMATH_TYPES_BENCHMARK(name) ALMATH_BENCHMARK(name##Inline)
+#include "almath_bench_types.h"
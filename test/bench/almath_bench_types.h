@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+
+// Tight loops over the core value types. This file is included twice:
+// by almath_bench.cpp, where the arithmetic is called in the library,
+// and by almath_bench_inline.cpp, where it is inline (ALMATH_INLINE_TYPES).
+// The includer defines ALMATH_TYPES_BENCHMARK(name) to name the benchmarks.
+
+#include <almath/types/alposition3d.h>
+#include <almath/types/alpose2d.h>
+#include <almath/types/alquaternion.h>
+#include <almath/types/altransform.h>
+#include <almath/types/altransformview.h>
+#include <almath/tools/altransformhelpers.h>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+  const unsigned int TYPES_BATCH_SIZE = 256;
+}
+
+ALMATH_TYPES_BENCHMARK(Position3DAccumulate)
+{
+  std::vector<AL::Math::Position3D> pPos(TYPES_BATCH_SIZE);
+  for (unsigned int i=0; i<TYPES_BATCH_SIZE; i++)
+  {
+    pPos[i] = AL::Math::Position3D(0.1f*static_cast<float>(i), 0.2f, -0.3f);
+  }
+  pState.setItemsPerIteration(TYPES_BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::Position3D pSum;
+    for (unsigned int i=0; i<TYPES_BATCH_SIZE; i++)
+    {
+      pSum += pPos[i]*0.5f - pPos[TYPES_BATCH_SIZE - 1 - i];
+    }
+    AL::Math::Bench::doNotOptimize(pSum);
+  }
+}
+
+ALMATH_TYPES_BENCHMARK(Pose2DChain)
+{
+  std::vector<AL::Math::Pose2D> pPoses(TYPES_BATCH_SIZE);
+  for (unsigned int i=0; i<TYPES_BATCH_SIZE; i++)
+  {
+    pPoses[i] = AL::Math::Pose2D(0.01f, 0.02f, 0.001f*static_cast<float>(i));
+  }
+  pState.setItemsPerIteration(TYPES_BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::Pose2D pChain;
+    for (unsigned int i=0; i<TYPES_BATCH_SIZE; i++)
+    {
+      pChain *= pPoses[i];
+    }
+    AL::Math::Bench::doNotOptimize(pChain);
+  }
+}
+
+ALMATH_TYPES_BENCHMARK(QuaternionChain)
+{
+  std::vector<AL::Math::Quaternion> pQuas(TYPES_BATCH_SIZE);
+  for (unsigned int i=0; i<TYPES_BATCH_SIZE; i++)
+  {
+    pQuas[i] = AL::Math::Quaternion(0.999f, 0.01f, -0.02f, 0.001f*static_cast<float>(i));
+  }
+  pState.setItemsPerIteration(TYPES_BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::Quaternion pChain;
+    for (unsigned int i=0; i<TYPES_BATCH_SIZE; i++)
+    {
+      pChain *= pQuas[i];
+    }
+    AL::Math::Bench::doNotOptimize(pChain);
+  }
+}
+
+ALMATH_TYPES_BENCHMARK(TransformMultiplyArray)
+{
+  std::vector<AL::Math::Transform> pA(TYPES_BATCH_SIZE);
+  std::vector<AL::Math::Transform> pOut(TYPES_BATCH_SIZE);
+  for (unsigned int i=0; i<TYPES_BATCH_SIZE; i++)
+  {
+    pA[i] = AL::Math::Transform(0.01f*static_cast<float>(i), 0.2f, 0.3f);
+  }
+  const AL::Math::Transform pB(0.1f, -0.2f, 0.3f);
+  pState.setItemsPerIteration(TYPES_BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    for (unsigned int i=0; i<TYPES_BATCH_SIZE; i++)
+    {
+      pOut[i] = pA[i]*pB;
+    }
+    AL::Math::Bench::doNotOptimize(pOut[0]);
+  }
+}
+
+ALMATH_TYPES_BENCHMARK(TransformPointsCopy)
+{
+  std::vector<float> pBuffer(TYPES_BATCH_SIZE*AL::Math::Position3D::SIZE, 0.1f);
+  std::vector<AL::Math::Position3D> pPos(TYPES_BATCH_SIZE);
+  const AL::Math::Transform pT(0.1f, -0.2f, 0.3f);
+  pState.setItemsPerIteration(TYPES_BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    // copy in, transform, copy out
+    for (unsigned int i=0; i<TYPES_BATCH_SIZE; i++)
+    {
+      pPos[i] = AL::Math::Position3D(
+            &pBuffer[i*AL::Math::Position3D::SIZE], AL::Math::Position3D::SIZE);
+    }
+    for (unsigned int i=0; i<TYPES_BATCH_SIZE; i++)
+    {
+      pPos[i] = pT*pPos[i];
+    }
+    for (unsigned int i=0; i<TYPES_BATCH_SIZE; i++)
+    {
+      pPos[i].writeTo(&pBuffer[i*AL::Math::Position3D::SIZE]);
+    }
+    AL::Math::Bench::doNotOptimize(pBuffer[0]);
+  }
+}
+
+ALMATH_TYPES_BENCHMARK(TransformPointsView)
+{
+  std::vector<float> pBuffer(TYPES_BATCH_SIZE*AL::Math::Position3D::SIZE, 0.1f);
+  const AL::Math::Position3DArrayView pPoints(&pBuffer[0], TYPES_BATCH_SIZE);
+  const AL::Math::Transform pTransform(0.1f, -0.2f, 0.3f);
+  std::vector<float> pTBuffer(AL::Math::Transform::SIZE);
+  pTransform.writeTo(&pTBuffer[0]);
+  const AL::Math::TransformView pT(&pTBuffer[0]);
+  pState.setItemsPerIteration(TYPES_BATCH_SIZE);
+  while (pState.keepRunning())
+  {
+    for (unsigned int i=0; i<TYPES_BATCH_SIZE; i++)
+    {
+      pPoints[i] = pT*pPoints[i];
+    }
+    AL::Math::Bench::doNotOptimize(pBuffer[0]);
+  }
+}
+
+namespace {
+  const unsigned int TYPES_CHAIN_SIZE = 32;
+}
+
+ALMATH_TYPES_BENCHMARK(RevoluteChainDense)
+{
+  std::vector<AL::Math::Transform> pJoints(TYPES_CHAIN_SIZE);
+  for (unsigned int i=0; i<TYPES_CHAIN_SIZE; i++)
+  {
+    pJoints[i] = AL::Math::Transform::fromRotZ(0.01f*static_cast<float>(i));
+  }
+  const AL::Math::Transform pOffset(0.1f, 0.0f, 0.05f);
+  pState.setItemsPerIteration(TYPES_CHAIN_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::Transform pT;
+    for (unsigned int i=0; i<TYPES_CHAIN_SIZE; i++)
+    {
+      pT *= pOffset;
+      pT *= pJoints[i];
+    }
+    AL::Math::Bench::doNotOptimize(pT);
+  }
+}
+
+ALMATH_TYPES_BENCHMARK(RevoluteChainStructured)
+{
+  std::vector<float> pCos(TYPES_CHAIN_SIZE);
+  std::vector<float> pSin(TYPES_CHAIN_SIZE);
+  for (unsigned int i=0; i<TYPES_CHAIN_SIZE; i++)
+  {
+    pCos[i] = std::cos(0.01f*static_cast<float>(i));
+    pSin[i] = std::sin(0.01f*static_cast<float>(i));
+  }
+  pState.setItemsPerIteration(TYPES_CHAIN_SIZE);
+  while (pState.keepRunning())
+  {
+    AL::Math::Transform pT;
+    for (unsigned int i=0; i<TYPES_CHAIN_SIZE; i++)
+    {
+      AL::Math::transformMultiplyByTranslation(pT, 0.1f, 0.0f, 0.05f);
+      AL::Math::transformMultiplyByRotZ(pT, pCos[i], pSin[i]);
+    }
+    AL::Math::Bench::doNotOptimize(pT);
+  }
+}
@@ -9,6 +9,8 @@
 #include <almath/tools/altrigonometry.h>
 
 #include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
 
 TEST(avoidFootCollisionTest, Log)
 {
@@ -128,3 +130,170 @@ TEST(clipFootWithEllipse, Log)
   EXPECT_FALSE(pResult);
 }
 
+
+
+namespace {
+  std::vector<AL::Math::Pose2D> xFootBoundingBox(const float pYMin, const float pYMax)
+  {
+    // clockwise
+    std::vector<AL::Math::Pose2D> pBox;
+    pBox.push_back(AL::Math::Pose2D( 0.080f, pYMax, 0.0f));
+    pBox.push_back(AL::Math::Pose2D( 0.080f, pYMin, 0.0f));
+    pBox.push_back(AL::Math::Pose2D(-0.047f, pYMin, 0.0f));
+    pBox.push_back(AL::Math::Pose2D(-0.047f, pYMax, 0.0f));
+    return pBox;
+  }
+}
+
+TEST(FootCollisionModelTest, sameAsAvoidFootCollision)
+{
+  const std::vector<AL::Math::Pose2D> pLFoot = xFootBoundingBox(-0.038f, 0.050f);
+  const std::vector<AL::Math::Pose2D> pRFoot = xFootBoundingBox(-0.050f, 0.038f);
+  const AL::Math::FootCollisionModel pModel(pLFoot, pRFoot);
+  EXPECT_EQ(5u, pModel.getNbIteration());
+
+  AL::Math::Pose2D pMove = AL::Math::Pose2D(0.0f, 0.1f, 0.0f);
+  EXPECT_FALSE(pModel.isInCollision(false, pMove));
+  EXPECT_FALSE(pModel.avoidCollision(false, pMove));
+  EXPECT_TRUE(pMove.isNear(AL::Math::Pose2D(0.0f, 0.1f, 0.0f), 0.0001f));
+
+  pMove = AL::Math::Pose2D(0.0f, 0.085f, 40.0f*AL::Math::TO_RAD);
+  EXPECT_TRUE(pModel.isInCollision(false, pMove));
+  EXPECT_TRUE(pModel.avoidCollision(false, pMove));
+  EXPECT_TRUE(pMove.isNear(AL::Math::Pose2D(0.0f, 0.085f, 0.207257f), 0.0001f));
+
+  // same result as avoidFootCollision on a grid of moves
+  for (unsigned int i=0; i<10; i++)
+  {
+    for (unsigned int j=0; j<10; j++)
+    {
+      for (unsigned int k=0; k<2; k++)
+      {
+        const bool isLeftSupport = (k == 0);
+        const float side = isLeftSupport ? -1.0f : 1.0f;
+        const AL::Math::Pose2D pMoveInit(
+              0.02f*static_cast<float>(i) - 0.1f,
+              side*(0.08f + 0.003f*static_cast<float>(j)),
+              side*0.1f*static_cast<float>(i+j));
+
+        AL::Math::Pose2D pExpected = pMoveInit;
+        const bool expected = AL::Math::avoidFootCollision(
+              pLFoot, pRFoot, isLeftSupport, pExpected);
+
+        pMove = pMoveInit;
+        EXPECT_EQ(expected, pModel.avoidCollision(isLeftSupport, pMove));
+        EXPECT_TRUE(pMove.isNear(pExpected, 0.0001f));
+      }
+    }
+  }
+}
+
+TEST(FootCollisionModelTest, separatingAxis)
+{
+  // two feet crossing each other without any vertex inside the other foot
+  std::vector<AL::Math::Pose2D> pLFoot;
+  pLFoot.push_back(AL::Math::Pose2D( 0.1f,  0.02f, 0.0f));
+  pLFoot.push_back(AL::Math::Pose2D( 0.1f, -0.02f, 0.0f));
+  pLFoot.push_back(AL::Math::Pose2D(-0.1f, -0.02f, 0.0f));
+  pLFoot.push_back(AL::Math::Pose2D(-0.1f,  0.02f, 0.0f));
+  const AL::Math::FootCollisionModel pModel(pLFoot, pLFoot);
+
+  EXPECT_TRUE(pModel.isInCollision(true, AL::Math::Pose2D(0.0f, 0.0f, AL::Math::PI_2)));
+  EXPECT_TRUE(pModel.isInCollision(true, AL::Math::Pose2D(0.0f, 0.039f, 0.0f)));
+  EXPECT_FALSE(pModel.isInCollision(true, AL::Math::Pose2D(0.0f, 0.041f, 0.0f)));
+  EXPECT_FALSE(pModel.isInCollision(true, AL::Math::Pose2D(0.201f, 0.0f, 0.0f)));
+}
+
+TEST(FootCollisionModelTest, precision)
+{
+  const std::vector<AL::Math::Pose2D> pLFoot = xFootBoundingBox(-0.038f, 0.050f);
+  const std::vector<AL::Math::Pose2D> pRFoot = xFootBoundingBox(-0.050f, 0.038f);
+  AL::Math::FootCollisionModel pModel(pLFoot, pRFoot, 20);
+
+  AL::Math::Pose2D pMove = AL::Math::Pose2D(0.0f, 0.085f, 40.0f*AL::Math::TO_RAD);
+  EXPECT_TRUE(pModel.avoidCollision(false, pMove));
+  EXPECT_NEAR(0.207257f, pMove.theta, 40.0f*AL::Math::TO_RAD/64.0f);
+
+  // the result is just at the limit of the collision
+  EXPECT_FALSE(pModel.isInCollision(false, AL::Math::Pose2D(0.0f, 0.085f, pMove.theta - 0.00001f)));
+  EXPECT_TRUE(pModel.isInCollision(false, AL::Math::Pose2D(0.0f, 0.085f, pMove.theta + 0.00001f)));
+
+  pModel.setNbIteration(0);
+  pMove = AL::Math::Pose2D(0.0f, 0.085f, 0.4f);
+  EXPECT_TRUE(pModel.avoidCollision(false, pMove));
+  EXPECT_NEAR(0.2f, pMove.theta, 0.00001f);
+
+  std::vector<AL::Math::Pose2D> pBadFoot(2);
+  EXPECT_THROW(AL::Math::FootCollisionModel(pBadFoot, pRFoot), std::invalid_argument);
+}
+
+TEST(FootCollisionModelTest, evaluateFootsteps)
+{
+  const std::vector<AL::Math::Pose2D> pLFoot = xFootBoundingBox(-0.038f, 0.050f);
+  const std::vector<AL::Math::Pose2D> pRFoot = xFootBoundingBox(-0.050f, 0.038f);
+  const AL::Math::FootCollisionModel pModel(pLFoot, pRFoot);
+  const float maxFootX = 0.08f;
+  const float maxFootY = 0.16f;
+
+  // odd size to cover both the SIMD part and the tail of the batch
+  std::vector<float> pX, pY, pTheta;
+  for (unsigned int i=0; i<17; i++)
+  {
+    for (unsigned int j=0; j<11; j++)
+    {
+      for (unsigned int k=0; k<3; k++)
+      {
+        pX.push_back(0.012f*static_cast<float>(i) - 0.1f);
+        pY.push_back(0.06f + 0.012f*static_cast<float>(j));
+        pTheta.push_back(0.4f*static_cast<float>(k) - 0.3f);
+      }
+    }
+  }
+  const unsigned int size = static_cast<unsigned int>(pX.size());
+
+  for (unsigned int s=0; s<2; s++)
+  {
+    const bool isLeftSupport = (s == 0);
+    std::vector<float> pXOut = pX;
+    std::vector<float> pYOut = pY;
+    std::vector<float> pThetaOut = pTheta;
+    if (isLeftSupport)
+    {
+      for (unsigned int i=0; i<size; i++)
+      {
+        pYOut[i] = -pYOut[i];
+        pThetaOut[i] = -pThetaOut[i];
+      }
+    }
+    const std::vector<float> pYIn = pYOut;
+    const std::vector<float> pThetaIn = pThetaOut;
+
+    bool* pIsClipped = new bool[size];
+    bool* pIsInCollision = new bool[size];
+    pModel.evaluateFootsteps(isLeftSupport, maxFootX, maxFootY, size,
+                             &pXOut[0], &pYOut[0], &pThetaOut[0],
+                             pIsClipped, pIsInCollision);
+
+    unsigned int nbClipped = 0;
+    unsigned int nbCollision = 0;
+    for (unsigned int i=0; i<size; i++)
+    {
+      AL::Math::Pose2D pMove(pX[i], pYIn[i], pThetaIn[i]);
+      const bool isClipped = AL::Math::clipFootWithEllipse(maxFootX, maxFootY, pMove);
+      const bool isInCollision = pModel.avoidCollision(isLeftSupport, pMove);
+
+      EXPECT_EQ(isClipped, pIsClipped[i]) << i;
+      EXPECT_EQ(isInCollision, pIsInCollision[i]) << i;
+      EXPECT_TRUE(pMove.isNear(AL::Math::Pose2D(pXOut[i], pYOut[i], pThetaOut[i]), 0.0001f)) << i;
+      nbClipped += isClipped ? 1 : 0;
+      nbCollision += isInCollision ? 1 : 0;
+    }
+    // the grid covers all the cases
+    EXPECT_LT(0u, nbClipped);
+    EXPECT_LT(0u, nbCollision);
+    EXPECT_LT(nbClipped + nbCollision, size);
+
+    delete[] pIsClipped;
+    delete[] pIsInCollision;
+  }
+}
@@ -5,8 +5,13 @@
  */
 #include <almath/types/alpose2d.h>
 #include <almath/tools/aldubinscurve.h>
+#include <almath/tools/altrigonometry.h>
 
 #include <gtest/gtest.h>
+#include <stdexcept>
+#include <cmath>
+#include <limits>
+#include <vector>
 //#include "../almathtestutils.h"
 
 float pCircleRadius = 0.0f;
@@ -65,3 +70,190 @@ TEST(ALDubinsCurveTest, test2)
   EXPECT_TRUE(solution.at(2).isNear(AL::Math::Pose2D(0.0f, -1.0f, +0.3f)));
 }
 
+
+
+TEST(ALDubinsCurveTest, arrayAndBatchMatchVector)
+{
+  const AL::Math::Pose2D pTargets[4] = {
+    AL::Math::Pose2D(0.5f, 0.5f, 0.0f),
+    AL::Math::Pose2D(-0.5f, 0.5f, 0.3f),
+    AL::Math::Pose2D(0.0f, -1.0f, 0.3f),
+    AL::Math::Pose2D(0.1f, 0.1f, 0.0f)}; // too close
+
+  AL::Math::DubinsSolutions pSolutions;
+  for (unsigned int i=0; i<3; i++)
+  {
+    EXPECT_EQ(AL::Math::DUBINS_SUCCESS,
+              AL::Math::getDubinsSolutions(pTargets[i], 0.1f, pSolutions));
+
+    std::vector<AL::Math::Pose2D> pExpected = AL::Math::getDubinsSolutions(pTargets[i], 0.1f);
+    for (unsigned int j=0; j<3; j++)
+    {
+      EXPECT_TRUE(pSolutions[j].isNear(pExpected.at(j), 0.00001f));
+    }
+  }
+
+  EXPECT_EQ(AL::Math::DUBINS_TARGET_TOO_CLOSE,
+            AL::Math::getDubinsSolutions(pTargets[3], 0.1f, pSolutions));
+  EXPECT_THROW(AL::Math::getDubinsSolutions(pTargets[3], 0.1f), std::invalid_argument);
+
+  // batch
+  AL::Math::DubinsSolutions pBatch[4];
+  AL::Math::DubinsStatus pStatus[4];
+  EXPECT_EQ(3u, AL::Math::getDubinsSolutionsBatch(pTargets, 4, 0.1f, pBatch, pStatus));
+  for (unsigned int i=0; i<3; i++)
+  {
+    EXPECT_EQ(AL::Math::DUBINS_SUCCESS, pStatus[i]);
+    std::vector<AL::Math::Pose2D> pExpected = AL::Math::getDubinsSolutions(pTargets[i], 0.1f);
+    for (unsigned int j=0; j<3; j++)
+    {
+      EXPECT_TRUE(pBatch[i][j].isNear(pExpected.at(j), 0.00001f));
+    }
+  }
+  EXPECT_EQ(AL::Math::DUBINS_TARGET_TOO_CLOSE, pStatus[3]);
+}
+
+
+TEST(ALDubinsCurveTest, invalidRadius)
+{
+  const AL::Math::Pose2D pTargets[2] = {
+    AL::Math::Pose2D(0.5f, 0.5f, 0.0f),
+    AL::Math::Pose2D(-0.5f, 0.5f, 0.3f)};
+  const float pRadius[3] = {0.0f, -0.1f, std::numeric_limits<float>::quiet_NaN()};
+
+  for (unsigned int i=0; i<3; i++)
+  {
+    AL::Math::DubinsSolutions pSolutions;
+    for (unsigned int j=0; j<3; j++)
+    {
+      pSolutions[j] = AL::Math::Pose2D(1.0f, 2.0f, 3.0f);
+    }
+    EXPECT_EQ(AL::Math::DUBINS_INVALID_RADIUS,
+              AL::Math::getDubinsSolutions(pTargets[0], pRadius[i], pSolutions));
+    for (unsigned int j=0; j<3; j++)
+    {
+      EXPECT_TRUE(pSolutions[j].isNear(AL::Math::Pose2D(1.0f, 2.0f, 3.0f), 0.0f));
+    }
+    EXPECT_THROW(AL::Math::getDubinsSolutions(pTargets[0], pRadius[i]),
+                 std::invalid_argument);
+
+    AL::Math::DubinsSolutions pBatch[2];
+    AL::Math::DubinsStatus pStatus[2];
+    EXPECT_EQ(0u, AL::Math::getDubinsSolutionsBatch(pTargets, 2, pRadius[i], pBatch, pStatus));
+    EXPECT_EQ(AL::Math::DUBINS_INVALID_RADIUS, pStatus[0]);
+    EXPECT_EQ(AL::Math::DUBINS_INVALID_RADIUS, pStatus[1]);
+  }
+}
+
+
+TEST(ALDubinsCurveTest, dubinsPath)
+{
+  const float radius = 0.1f;
+  AL::Math::DubinsPath pPath;
+
+  // straight line
+  ASSERT_EQ(AL::Math::DUBINS_SUCCESS, AL::Math::computeDubinsPath(
+              AL::Math::Pose2D(), AL::Math::Pose2D(1.0f, 0.0f, 0.0f), radius, pPath));
+  EXPECT_NEAR(1.0f, pPath.length(), 0.0001f);
+  EXPECT_NEAR(1.0f, pPath.lengths[1], 0.0001f);
+
+  // half turn on the left
+  ASSERT_EQ(AL::Math::DUBINS_SUCCESS, AL::Math::computeDubinsPath(
+              AL::Math::Pose2D(), AL::Math::Pose2D(0.0f, 2.0f*radius, AL::Math::PI),
+              radius, pPath));
+  EXPECT_NEAR(AL::Math::PI*radius, pPath.length(), 0.0001f);
+  EXPECT_TRUE(pPath.sample(0.5f*AL::Math::PI*radius).isNear(
+                AL::Math::Pose2D(radius, radius, AL::Math::PI_2), 0.0001f));
+
+  EXPECT_EQ(AL::Math::DUBINS_INVALID_RADIUS, AL::Math::computeDubinsPath(
+              AL::Math::Pose2D(), AL::Math::Pose2D(1.0f, 0.0f, 0.0f), 0.0f, pPath));
+
+  // target closer than 4 radius
+  const AL::Math::Pose2D pTarget(0.0f, 0.05f, 0.0f);
+  AL::Math::DubinsSolutions pSolutions;
+  EXPECT_EQ(AL::Math::DUBINS_TARGET_TOO_CLOSE,
+            AL::Math::getDubinsSolutions(pTarget, radius, pSolutions));
+  ASSERT_EQ(AL::Math::DUBINS_SUCCESS, AL::Math::computeDubinsPath(
+              AL::Math::Pose2D(), pTarget, radius, pPath));
+  EXPECT_TRUE(pPath.sample(pPath.length()).isNear(pTarget, 0.0001f));
+}
+
+
+TEST(ALDubinsCurveTest, dubinsPathShortest)
+{
+  const float radius = 0.2f;
+  const AL::Math::Pose2D pStart(0.3f, -0.1f, 0.5f);
+
+  for (unsigned int i=0; i<50; i++)
+  {
+    const float k = static_cast<float>(i);
+    const AL::Math::Pose2D pTarget(
+          0.8f*sinf(0.7f*k), 0.6f*cosf(1.3f*k) - 0.1f, 0.4f*k - 3.0f);
+
+    AL::Math::DubinsPath pPath;
+    ASSERT_EQ(AL::Math::DUBINS_SUCCESS,
+              AL::Math::computeDubinsPath(pStart, pTarget, radius, pPath));
+
+    // the end of the path is the target
+    EXPECT_TRUE(pPath.sample(0.0f).isNear(pStart, 0.0001f)) << i;
+    const AL::Math::Pose2D pEnd = pPath.sample(pPath.length());
+    EXPECT_NEAR(pTarget.x, pEnd.x, 0.001f) << i;
+    EXPECT_NEAR(pTarget.y, pEnd.y, 0.001f) << i;
+    EXPECT_NEAR(0.0f, sinf(0.5f*(pTarget.theta - pEnd.theta)), 0.001f) << i;
+
+    // it is the shortest of the six families
+    for (unsigned int j=0; j<6; j++)
+    {
+      AL::Math::DubinsPath pOther;
+      const AL::Math::DubinsStatus status = AL::Math::computeDubinsPath(
+            pStart, pTarget, radius, static_cast<AL::Math::DubinsPathType>(j), pOther);
+      if (status == AL::Math::DUBINS_SUCCESS)
+      {
+        EXPECT_LE(pPath.length(), pOther.length() + 0.00001f);
+        const AL::Math::Pose2D pOtherEnd = pOther.sample(pOther.length());
+        EXPECT_NEAR(pTarget.x, pOtherEnd.x, 0.001f) << i << " " << j;
+        EXPECT_NEAR(pTarget.y, pOtherEnd.y, 0.001f) << i << " " << j;
+      }
+      else
+      {
+        EXPECT_EQ(AL::Math::DUBINS_NO_PATH, status);
+      }
+    }
+  }
+}
+
+
+TEST(ALDubinsCurveTest, sampleDubinsPath)
+{
+  AL::Math::DubinsPath pPath;
+  ASSERT_EQ(AL::Math::DUBINS_SUCCESS, AL::Math::computeDubinsPath(
+              AL::Math::Pose2D(), AL::Math::Pose2D(-0.5f, 0.5f, 0.3f), 0.1f, pPath));
+
+  const float step = 0.01f;
+  const unsigned int expected =
+      static_cast<unsigned int>(pPath.length()/step) + 1;
+
+  // stream the path with a small buffer
+  AL::Math::Pose2D pBuffer[16];
+  std::vector<AL::Math::Pose2D> pPoses;
+  unsigned int nbPoses = 0;
+  do
+  {
+    nbPoses = AL::Math::sampleDubinsPath(
+          pPath, step, step*static_cast<float>(pPoses.size()), pBuffer, 16);
+    pPoses.insert(pPoses.end(), pBuffer, pBuffer + nbPoses);
+  } while (nbPoses == 16);
+
+  EXPECT_NEAR(static_cast<float>(expected), static_cast<float>(pPoses.size()), 1.0f);
+  EXPECT_TRUE(pPoses.front().isNear(AL::Math::Pose2D(), 0.0001f));
+  for (unsigned int i=1; i<pPoses.size(); i++)
+  {
+    const float dx = pPoses[i].x - pPoses[i-1].x;
+    const float dy = pPoses[i].y - pPoses[i-1].y;
+    EXPECT_LE(sqrtf(dx*dx + dy*dy), step + 0.0001f);
+    EXPECT_GT(sqrtf(dx*dx + dy*dy), 0.5f*step);
+  }
+
+  EXPECT_EQ(0u, AL::Math::sampleDubinsPath(pPath, 0.0f, 0.0f, pBuffer, 16));
+  EXPECT_EQ(0u, AL::Math::sampleDubinsPath(pPath, step, pPath.length() + step, pBuffer, 16));
+}
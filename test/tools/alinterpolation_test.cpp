@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+#include <almath/tools/alinterpolation.h>
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+  // enough joints to cover both the SIMD part and the tail
+  const unsigned int NB_JOINTS = 11;
+
+  std::vector<float> xValues(
+    const float pOffset,
+    const float pScale)
+  {
+    std::vector<float> values(NB_JOINTS);
+    for (unsigned int j=0; j<NB_JOINTS; j++)
+    {
+      values[j] = pOffset + pScale*static_cast<float>(j % 5) -
+          0.1f*static_cast<float>(j);
+    }
+    return values;
+  }
+
+  // three waypoints at 0.5, 1.5 and 2.0
+  AL::Math::JointTrajectory xTrajectory(
+    const AL::Math::InterpolationType pType)
+  {
+    AL::Math::JointTrajectory trajectory(NB_JOINTS, pType);
+    trajectory.addWaypoint(0.5f, &xValues(0.2f, 0.3f)[0]);
+    trajectory.addWaypoint(1.5f, &xValues(-0.4f, 0.5f)[0], &xValues(0.3f, -0.2f)[0]);
+    trajectory.addWaypoint(2.0f, &xValues(0.1f, -0.1f)[0]);
+    return trajectory;
+  }
+}
+
+TEST(ALInterpolationTest, waypoints)
+{
+  const AL::Math::InterpolationType types[3] = {
+    AL::Math::INTERPOLATION_CUBIC,
+    AL::Math::INTERPOLATION_QUINTIC,
+    AL::Math::INTERPOLATION_MINIMUM_JERK};
+
+  for (unsigned int t=0; t<3; t++)
+  {
+    const AL::Math::JointTrajectory trajectory = xTrajectory(types[t]);
+    EXPECT_EQ(3u, trajectory.getNbWaypoints());
+    EXPECT_EQ(0.5f, trajectory.getStartTime());
+    EXPECT_EQ(2.0f, trajectory.getFinalTime());
+
+    // the waypoints are reached with their velocity, zero for minimum jerk
+    const std::vector<float> q = xValues(-0.4f, 0.5f);
+    const std::vector<float> dq = (types[t] == AL::Math::INTERPOLATION_MINIMUM_JERK) ?
+          std::vector<float>(NB_JOINTS, 0.0f) : xValues(0.3f, -0.2f);
+    std::vector<AL::Math::PositionAndVelocity> before(NB_JOINTS);
+    std::vector<AL::Math::PositionAndVelocity> after(NB_JOINTS);
+    trajectory.evaluate(1.5f - 1.0e-4f, &before[0]);
+    trajectory.evaluate(1.5f, &after[0]);
+    for (unsigned int j=0; j<NB_JOINTS; j++)
+    {
+      EXPECT_TRUE(after[j].isNear(AL::Math::PositionAndVelocity(q[j], dq[j]), 1.0e-4f)) << t << " " << j;
+      EXPECT_TRUE(before[j].isNear(after[j], 1.0e-3f)) << t << " " << j;
+    }
+
+    // hold the first and the last waypoints
+    std::vector<AL::Math::PositionAndVelocity> out(NB_JOINTS);
+    trajectory.evaluate(0.0f, &out[0]);
+    const std::vector<float> first = xValues(0.2f, 0.3f);
+    for (unsigned int j=0; j<NB_JOINTS; j++)
+    {
+      EXPECT_TRUE(out[j].isNear(AL::Math::PositionAndVelocity(first[j], 0.0f), 1.0e-6f));
+    }
+    trajectory.evaluate(3.0f, &out[0]);
+    const std::vector<float> last = xValues(0.1f, -0.1f);
+    for (unsigned int j=0; j<NB_JOINTS; j++)
+    {
+      EXPECT_TRUE(out[j].isNear(AL::Math::PositionAndVelocity(last[j], 0.0f), 1.0e-5f));
+    }
+  }
+}
+
+TEST(ALInterpolationTest, velocity)
+{
+  const AL::Math::InterpolationType types[3] = {
+    AL::Math::INTERPOLATION_CUBIC,
+    AL::Math::INTERPOLATION_QUINTIC,
+    AL::Math::INTERPOLATION_MINIMUM_JERK};
+
+  // dq is the derivative of q, and for the quintic polynomials the
+  // acceleration is zero at the waypoints
+  const float eps = 1.0e-3f;
+  std::vector<AL::Math::PositionAndVelocity> out0(NB_JOINTS);
+  std::vector<AL::Math::PositionAndVelocity> out1(NB_JOINTS);
+  for (unsigned int t=0; t<3; t++)
+  {
+    const AL::Math::JointTrajectory trajectory = xTrajectory(types[t]);
+    for (unsigned int i=1; i<15; i++)
+    {
+      const float time = 0.5f + 0.1f*static_cast<float>(i);
+      trajectory.evaluate(time - eps, &out0[0]);
+      trajectory.evaluate(time + eps, &out1[0]);
+      for (unsigned int j=0; j<NB_JOINTS; j++)
+      {
+        EXPECT_NEAR((out1[j].q - out0[j].q)/(2.0f*eps),
+                    0.5f*(out0[j].dq + out1[j].dq), 2.0e-2f) << t << " " << time << " " << j;
+      }
+    }
+
+    if (types[t] != AL::Math::INTERPOLATION_CUBIC)
+    {
+      const float epsAcc = 1.0e-4f;
+      trajectory.evaluate(1.5f, &out0[0]);
+      trajectory.evaluate(1.5f + epsAcc, &out1[0]);
+      for (unsigned int j=0; j<NB_JOINTS; j++)
+      {
+        EXPECT_NEAR(0.0f, (out1[j].dq - out0[j].dq)/epsAcc, 5.0e-2f) << t << " " << j;
+      }
+    }
+  }
+
+  // the minimum jerk profile: half way at mid time, with a 15/8 peak
+  // velocity ratio
+  AL::Math::JointTrajectory trajectory(1, AL::Math::INTERPOLATION_MINIMUM_JERK);
+  const float q0 = 0.0f;
+  const float q1 = 2.0f;
+  trajectory.addWaypoint(0.0f, &q0);
+  trajectory.addWaypoint(4.0f, &q1);
+  AL::Math::PositionAndVelocity mid;
+  trajectory.evaluate(2.0f, &mid);
+  EXPECT_TRUE(mid.isNear(AL::Math::PositionAndVelocity(1.0f, 1.875f*2.0f/4.0f), 1.0e-5f));
+}
+
+TEST(ALInterpolationTest, cursor)
+{
+  AL::Math::JointTrajectory trajectory = xTrajectory(AL::Math::INTERPOLATION_QUINTIC);
+  AL::Math::JointTrajectoryCursor cursor(trajectory, 0.01f);
+  EXPECT_EQ(0.5f, cursor.getTime());
+
+  std::vector<AL::Math::PositionAndVelocity> out(NB_JOINTS);
+  std::vector<AL::Math::PositionAndVelocity> expected(NB_JOINTS);
+  unsigned int nbTicks = 0;
+  while (!cursor.isFinished())
+  {
+    const float time = cursor.getTime();
+    cursor.next(&out[0]);
+    trajectory.evaluate(time, &expected[0]);
+    for (unsigned int j=0; j<NB_JOINTS; j++)
+    {
+      EXPECT_EQ(expected[j].q, out[j].q) << time << " " << j;
+      EXPECT_EQ(expected[j].dq, out[j].dq) << time << " " << j;
+    }
+    ++nbTicks;
+  }
+  EXPECT_EQ(151u, nbTicks);
+
+  // backward
+  cursor.seek(0.7f);
+  EXPECT_EQ(0.7f, cursor.getTime());
+  cursor.next(&out[0]);
+  trajectory.evaluate(0.7f, &expected[0]);
+  EXPECT_TRUE(out[3].isNear(expected[3], 1.0e-6f));
+
+  // waypoints added while playing
+  cursor.seek(2.5f);
+  cursor.next(&out[0]);
+  EXPECT_TRUE(cursor.isFinished());
+  trajectory.addWaypoint(3.0f, &xValues(0.0f, 0.0f)[0]);
+  EXPECT_FALSE(cursor.isFinished());
+  const float time = cursor.getTime();
+  cursor.next(&out[0]);
+  trajectory.evaluate(time, &expected[0]);
+  EXPECT_TRUE(out[5].isNear(expected[5], 1.0e-6f));
+  EXPECT_NE(0.0f, out[5].dq);
+}
+
+TEST(ALInterpolationTest, errors)
+{
+  EXPECT_THROW(AL::Math::JointTrajectory(0), std::invalid_argument);
+
+  AL::Math::JointTrajectory trajectory(NB_JOINTS);
+  std::vector<AL::Math::PositionAndVelocity> out(NB_JOINTS);
+  EXPECT_THROW(trajectory.evaluate(0.0f, &out[0]), std::runtime_error);
+  EXPECT_THROW(AL::Math::JointTrajectoryCursor(trajectory, 0.0f), std::invalid_argument);
+
+  AL::Math::JointTrajectoryCursor cursor(trajectory, 0.01f);
+  EXPECT_TRUE(cursor.isFinished());
+  EXPECT_THROW(cursor.next(&out[0]), std::runtime_error);
+
+  // a single waypoint is held
+  const std::vector<float> q = xValues(0.3f, 0.1f);
+  trajectory.addWaypoint(1.0f, &q[0]);
+  trajectory.evaluate(2.0f, &out[0]);
+  EXPECT_TRUE(out[2].isNear(AL::Math::PositionAndVelocity(q[2], 0.0f)));
+
+  EXPECT_THROW(trajectory.addWaypoint(1.0f, &q[0]), std::invalid_argument);
+  EXPECT_THROW(trajectory.addWaypoint(0.5f, &q[0]), std::invalid_argument);
+
+  trajectory.clear();
+  EXPECT_EQ(0u, trajectory.getNbWaypoints());
+  trajectory.addWaypoint(0.5f, &q[0]);
+  EXPECT_EQ(1u, trajectory.getNbWaypoints());
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+#include <almath/tools/alinversekinematics.h>
+#include <almath/tools/altransformhelpers.h>
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+  // a 6 dof arm, with its effector 5cm after the last joint
+  AL::Math::KinematicChain xArm()
+  {
+    AL::Math::KinematicChain arm;
+    arm.addLink(AL::Math::Transform(0.0f, 0.1f, 0.1f), AL::Math::JOINT_REVOLUTE_Y);
+    arm.addLink(AL::Math::Transform(), AL::Math::JOINT_REVOLUTE_Z);
+    arm.addLink(AL::Math::Transform(0.1f, 0.015f, 0.0f), AL::Math::JOINT_REVOLUTE_X);
+    arm.addLink(AL::Math::Transform(), AL::Math::JOINT_REVOLUTE_Z);
+    arm.addLink(AL::Math::Transform(0.05f, 0.0f, 0.0f), AL::Math::JOINT_REVOLUTE_X);
+    arm.addLink(AL::Math::Transform(0.05f, 0.0f, 0.0f), AL::Math::JOINT_REVOLUTE_Y);
+    return arm;
+  }
+
+  const AL::Math::Transform TIP(0.05f, 0.0f, 0.0f);
+
+  AL::Math::Transform xEffector(
+    AL::Math::KinematicChain& pArm,
+    const float*              pValues)
+  {
+    pArm.setJointValues(pValues);
+    return pArm.getLinkTransform(5)*TIP;
+  }
+}
+
+TEST(ALInverseKinematicsSolverTest, solve)
+{
+  AL::Math::KinematicChain arm = xArm();
+  const float goal[6] = {0.3f, -0.5f, 0.2f, 0.8f, -0.4f, 0.6f};
+  const AL::Math::Transform target = xEffector(arm, goal);
+
+  const float start[6] = {0.0f, 0.0f, 0.0f, 0.2f, 0.0f, 0.0f};
+  arm.setJointValues(start);
+  AL::Math::InverseKinematicsSolver solver(arm, 5, TIP);
+  solver.setMaxIterations(100);
+  EXPECT_TRUE(solver.solve(target));
+  EXPECT_LT(solver.getError(), 0.0001f);
+  EXPECT_GT(solver.getNbIterations(), 0u);
+  EXPECT_TRUE((arm.getLinkTransform(5)*TIP).isNear(target, 0.001f));
+
+  // warm start from the previous solution
+  EXPECT_TRUE(solver.solve(target));
+  EXPECT_EQ(0u, solver.getNbIterations());
+
+  // a small move of the target converges quickly
+  const float goal2[6] = {0.32f, -0.5f, 0.21f, 0.8f, -0.41f, 0.6f};
+  const AL::Math::Transform target2 = xEffector(arm, goal2);
+  arm.setJointValues(goal);
+  EXPECT_TRUE(solver.solve(target2));
+  EXPECT_LE(solver.getNbIterations(), 4u);
+}
+
+TEST(ALInverseKinematicsSolverTest, budget)
+{
+  AL::Math::KinematicChain arm = xArm();
+  const float goal[6] = {0.3f, -0.5f, 0.2f, 0.8f, -0.4f, 0.6f};
+  const AL::Math::Transform target = xEffector(arm, goal);
+  const float start[6] = {0.0f, 0.0f, 0.0f, 0.2f, 0.0f, 0.0f};
+  arm.setJointValues(start);
+
+  AL::Math::InverseKinematicsSolver solver(arm, 5, TIP);
+  solver.setMaxIterations(1);
+  EXPECT_FALSE(solver.solve(target));
+  EXPECT_EQ(1u, solver.getNbIterations());
+  EXPECT_GT(solver.getError(), 0.0001f);
+
+  // an unreachable target: only the time budget stops the iterations
+  const unsigned int maxIterations = 100000000;
+  solver.setMaxIterations(maxIterations);
+  solver.setMaxTime(0.01f);
+  EXPECT_FALSE(solver.solve(AL::Math::Transform(10.0f, 0.0f, 0.0f)));
+  EXPECT_GT(solver.getNbIterations(), 1u);
+  EXPECT_LT(solver.getNbIterations(), maxIterations);
+}
+
+TEST(ALInverseKinematicsSolverTest, axisMaskAndLimits)
+{
+  AL::Math::KinematicChain arm = xArm();
+  const float goal[6] = {0.3f, -0.5f, 0.2f, 0.8f, -0.4f, 0.6f};
+  const AL::Math::Transform target = xEffector(arm, goal);
+  const float start[6] = {0.0f, 0.0f, 0.0f, 0.2f, 0.0f, 0.0f};
+
+  // position only, with the second joint limited
+  arm.setJointValues(start);
+  AL::Math::InverseKinematicsSolver solver(arm, 5, TIP);
+  solver.setMaxIterations(100);
+  solver.setAxisMask(AL::Math::AXIS_MASK_VEL);
+  solver.setJointLimits(1, -0.3f, 0.3f);
+  EXPECT_TRUE(solver.solve(target));
+  EXPECT_GE(arm.getJointValue(1), -0.3f);
+  EXPECT_LE(arm.getJointValue(1), 0.3f);
+  EXPECT_TRUE(AL::Math::position3DFromTransform(arm.getLinkTransform(5)*TIP).isNear(
+                AL::Math::position3DFromTransform(target), 0.001f));
+
+  // zero weights remove the orientation, as AXIS_MASK_VEL
+  std::vector<float> weights(6, 1.0f);
+  weights[3] = weights[4] = weights[5] = 0.0f;
+  solver.setAxisMask(AL::Math::AXIS_MASK_ALL);
+  solver.setAxisWeights(weights);
+  const float start2[6] = {0.1f, 0.1f, 0.1f, 0.3f, 0.1f, 0.1f};
+  arm.setJointValues(start2);
+  EXPECT_TRUE(solver.solve(target));
+  EXPECT_TRUE(AL::Math::position3DFromTransform(arm.getLinkTransform(5)*TIP).isNear(
+                AL::Math::position3DFromTransform(target), 0.001f));
+
+  EXPECT_THROW(solver.setAxisWeights(std::vector<float>(5, 1.0f)), std::invalid_argument);
+  EXPECT_THROW(solver.setJointLimits(6, 0.0f, 1.0f), std::invalid_argument);
+  EXPECT_THROW(solver.setJointLimits(0, 1.0f, 0.0f), std::invalid_argument);
+  EXPECT_THROW(solver.setDamping(-1.0f), std::invalid_argument);
+  EXPECT_THROW(AL::Math::InverseKinematicsSolver(arm, 6), std::invalid_argument);
+}
+
+TEST(ALInverseKinematicsSolverTest, treeChanged)
+{
+  AL::Math::KinematicChain arm;
+  arm.addLink(AL::Math::Transform(0.0f, 0.0f, 0.1f), AL::Math::JOINT_REVOLUTE_Z);
+  arm.addLink(AL::Math::Transform(0.1f, 0.0f, 0.0f), AL::Math::JOINT_REVOLUTE_Y);
+  AL::Math::InverseKinematicsSolver solver(arm, 1, TIP);
+  const AL::Math::Transform target = arm.getLinkTransform(1)*TIP;
+  EXPECT_TRUE(solver.solve(target));
+
+  // links added after the construction of the solver
+  for (unsigned int i=0; i<8; i++)
+  {
+    arm.addLink(AL::Math::Transform(0.05f, 0.0f, 0.0f), AL::Math::JOINT_REVOLUTE_X);
+  }
+  EXPECT_THROW(solver.solve(target), std::invalid_argument);
+}
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+#include <almath/tools/alkinematictree.h>
+#include <almath/tools/altransformhelpers.h>
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+  // the joint Transform computed with dense products
+  AL::Math::Transform xJoint(
+    const AL::Math::JointType pType,
+    const float               pValue)
+  {
+    switch (pType)
+    {
+    case AL::Math::JOINT_REVOLUTE_X:
+      return AL::Math::Transform::fromRotX(pValue);
+    case AL::Math::JOINT_REVOLUTE_Y:
+      return AL::Math::Transform::fromRotY(pValue);
+    case AL::Math::JOINT_REVOLUTE_Z:
+      return AL::Math::Transform::fromRotZ(pValue);
+    case AL::Math::JOINT_PRISMATIC_X:
+      return AL::Math::Transform(pValue, 0.0f, 0.0f);
+    case AL::Math::JOINT_PRISMATIC_Y:
+      return AL::Math::Transform(0.0f, pValue, 0.0f);
+    case AL::Math::JOINT_PRISMATIC_Z:
+      return AL::Math::Transform(0.0f, 0.0f, pValue);
+    default:
+      return AL::Math::Transform();
+    }
+  }
+
+  // a torso (0) with two arms: 1 -> 2 -> 3 and 4 -> 5 -> 6
+  const unsigned int NB_LINKS = 7;
+  const int PARENTS[NB_LINKS] = {-1, 0, 1, 2, 0, 4, 5};
+  const AL::Math::JointType TYPES[NB_LINKS] = {
+    AL::Math::JOINT_REVOLUTE_Z,
+    AL::Math::JOINT_REVOLUTE_Y, AL::Math::JOINT_PRISMATIC_X, AL::Math::JOINT_FIXED,
+    AL::Math::JOINT_REVOLUTE_Y, AL::Math::JOINT_PRISMATIC_X, AL::Math::JOINT_FIXED};
+
+  AL::Math::Transform xOffset(const unsigned int pLink)
+  {
+    const float side = (pLink < 4) ? 1.0f : -1.0f;
+    switch (pLink)
+    {
+    case 0:
+      return AL::Math::Transform(0.0f, 0.0f, 0.3f);
+    case 1:
+    case 4:
+      return AL::Math::Transform(0.0f, side*0.1f, 0.1f);
+    case 2:
+    case 5:
+      return AL::Math::Transform::fromPosition(
+            0.1f, 0.0f, 0.0f, side*0.1f, 0.0f, 0.2f);
+    default:
+      return AL::Math::Transform(0.05f, 0.0f, 0.0f);
+    }
+  }
+
+  AL::Math::KinematicTree xTwoArms()
+  {
+    AL::Math::KinematicTree tree;
+    for (unsigned int i=0; i<NB_LINKS; i++)
+    {
+      if (PARENTS[i] == static_cast<int>(i) - 1)
+      {
+        tree.addLink(xOffset(i), TYPES[i]);
+      }
+      else
+      {
+        tree.addLink(PARENTS[i], xOffset(i), TYPES[i]);
+      }
+    }
+    return tree;
+  }
+}
+
+TEST(ALKinematicTreeTest, creation)
+{
+  AL::Math::KinematicTree tree = xTwoArms();
+  EXPECT_EQ(7u, tree.getNbLinks());
+  EXPECT_EQ(5u, tree.getNbJoints());
+  EXPECT_EQ(-1, tree.getParent(0));
+  EXPECT_EQ(0, tree.getParent(4));
+  EXPECT_EQ(5, tree.getParent(6));
+  EXPECT_EQ(AL::Math::JOINT_FIXED, tree.getJointType(3));
+  EXPECT_EQ(-1, tree.getJointIndex(3));
+  EXPECT_EQ(3, tree.getJointIndex(4));
+  EXPECT_EQ(5u, tree.getJointLink(4));
+  EXPECT_EQ(0.0f, tree.getJointValue(2));
+
+  EXPECT_THROW(tree.addLink(7, AL::Math::Transform()), std::invalid_argument);
+  EXPECT_THROW(tree.addLink(-2, AL::Math::Transform()), std::invalid_argument);
+  EXPECT_THROW(tree.getParent(7), std::invalid_argument);
+  EXPECT_THROW(tree.setJointValue(5, 0.1f), std::invalid_argument);
+
+  // a chain built with the parent free addLink
+  AL::Math::KinematicChain chain;
+  EXPECT_EQ(0u, chain.addLink(AL::Math::Transform(), AL::Math::JOINT_REVOLUTE_Z));
+  EXPECT_EQ(1u, chain.addLink(AL::Math::Transform(0.1f, 0.0f, 0.0f)));
+  EXPECT_EQ(-1, chain.getParent(0));
+  EXPECT_EQ(0, chain.getParent(1));
+}
+
+TEST(ALKinematicTreeTest, forwardKinematics)
+{
+  AL::Math::KinematicTree tree = xTwoArms();
+  const float values[5] = {0.3f, -0.7f, 0.05f, 1.2f, -0.02f};
+  tree.setJointValues(values);
+
+  std::vector<AL::Math::Transform> expected(NB_LINKS);
+  for (unsigned int i=0; i<NB_LINKS; i++)
+  {
+    const int joint = tree.getJointIndex(i);
+    const float value = (joint < 0) ? 0.0f : values[joint];
+    expected[i] = xOffset(i)*xJoint(TYPES[i], value);
+    if (PARENTS[i] >= 0)
+    {
+      expected[i] = expected[PARENTS[i]]*expected[i];
+    }
+  }
+
+  const std::vector<AL::Math::Transform>& H = tree.getLinkTransforms();
+  ASSERT_EQ(expected.size(), H.size());
+  for (unsigned int i=0; i<H.size(); i++)
+  {
+    EXPECT_TRUE(H[i].isNear(expected[i], 1.0e-5f)) << i;
+  }
+}
+
+TEST(ALKinematicTreeTest, dirtyUpdate)
+{
+  AL::Math::KinematicTree tree = xTwoArms();
+  EXPECT_EQ(7u, tree.update());
+  EXPECT_EQ(0u, tree.update());
+
+  // setting the same value does not dirty the link
+  tree.setJointValue(1, 0.0f);
+  EXPECT_EQ(0u, tree.update());
+
+  // the second joint of the first arm: links 2 and 3
+  tree.setJointValue(2, 0.1f);
+  EXPECT_EQ(2u, tree.update());
+
+  // the first joint of the second arm: links 4, 5 and 6
+  tree.setJointValue(3, 0.4f);
+  EXPECT_EQ(3u, tree.update());
+
+  // the root: every link
+  tree.setJointValue(0, -0.2f);
+  tree.setJointValue(4, 0.01f);
+  EXPECT_EQ(7u, tree.update());
+
+  // the incremental result is the one of a full update
+  AL::Math::KinematicTree full = xTwoArms();
+  full.setJointValues(&tree.getJointValues()[0]);
+  for (unsigned int i=0; i<tree.getNbLinks(); i++)
+  {
+    EXPECT_TRUE(tree.getLinkTransform(i).isNear(full.getLinkTransform(i), 1.0e-6f)) << i;
+  }
+}
+
+TEST(ALKinematicTreeTest, computeJacobian)
+{
+  AL::Math::KinematicTree tree = xTwoArms();
+  const float values[5] = {0.3f, -0.7f, 0.05f, 1.2f, -0.02f};
+  tree.setJointValues(values);
+
+  // the tip of the first arm
+  const unsigned int link = 3;
+  const AL::Math::Position3D point(0.02f, -0.01f, 0.03f);
+  const unsigned int nbJoints = tree.getNbJoints();
+  std::vector<float> J(6*nbJoints);
+  tree.computeJacobian(link, point, AL::Math::AXIS_MASK_ALL, &J[0]);
+
+  // finite differences
+  const AL::Math::Transform H = tree.getLinkTransform(link);
+  const AL::Math::Position3D p = H*point;
+  const float eps = 1.0e-3f;
+  for (unsigned int j=0; j<nbJoints; j++)
+  {
+    AL::Math::KinematicTree moved = xTwoArms();
+    moved.setJointValues(values);
+    moved.setJointValue(j, values[j] + eps);
+    const AL::Math::Transform& Hj = moved.getLinkTransform(link);
+    const AL::Math::Position3D v = (Hj*point - p)/eps;
+    // R(q + eps)*R(q)^t = I + eps*[w]x
+    const AL::Math::Transform dR = Hj*AL::Math::transformInverse(H);
+    const AL::Math::Position3D w(dR.r3_c2/eps, dR.r1_c3/eps, dR.r2_c1/eps);
+
+    EXPECT_NEAR(v.x, J[j], 5.0e-3f) << j;
+    EXPECT_NEAR(v.y, J[nbJoints + j], 5.0e-3f) << j;
+    EXPECT_NEAR(v.z, J[2*nbJoints + j], 5.0e-3f) << j;
+    EXPECT_NEAR(w.x, J[3*nbJoints + j], 5.0e-3f) << j;
+    EXPECT_NEAR(w.y, J[4*nbJoints + j], 5.0e-3f) << j;
+    EXPECT_NEAR(w.z, J[5*nbJoints + j], 5.0e-3f) << j;
+  }
+
+  // the joints of the second arm do not move the first one
+  for (unsigned int row=0; row<6; row++)
+  {
+    EXPECT_EQ(0.0f, J[row*nbJoints + 3]);
+    EXPECT_EQ(0.0f, J[row*nbJoints + 4]);
+  }
+
+  // selected rows
+  std::vector<float> JMasked(3*nbJoints);
+  tree.computeJacobian(link, point,
+                       AL::Math::AXIS_MASK_Y | AL::Math::AXIS_MASK_WX |
+                       AL::Math::AXIS_MASK_WZ, &JMasked[0]);
+  for (unsigned int j=0; j<nbJoints; j++)
+  {
+    EXPECT_EQ(J[nbJoints + j], JMasked[j]);
+    EXPECT_EQ(J[3*nbJoints + j], JMasked[nbJoints + j]);
+    EXPECT_EQ(J[5*nbJoints + j], JMasked[2*nbJoints + j]);
+  }
+}
+
+TEST(ALKinematicTreeTest, computeJacobianLongChain)
+{
+  // enough joints to cover both the SIMD part and the tail
+  AL::Math::KinematicChain chain;
+  const unsigned int nbJoints = 27;
+  for (unsigned int i=0; i<nbJoints; i++)
+  {
+    chain.addLink(AL::Math::Transform(0.01f*static_cast<float>(i), 0.02f, 0.05f),
+                  static_cast<AL::Math::JointType>(AL::Math::JOINT_REVOLUTE_X + i % 6));
+    chain.setJointValue(i, 0.1f*static_cast<float>(i % 7));
+  }
+
+  std::vector<float> J(6*nbJoints);
+  const unsigned int tip = chain.getNbLinks() - 1;
+  chain.computeJacobian(tip, AL::Math::Position3D(), AL::Math::AXIS_MASK_ALL, &J[0]);
+
+  const AL::Math::Position3D p =
+      AL::Math::position3DFromTransform(chain.getLinkTransform(tip));
+  for (unsigned int j=0; j<nbJoints; j++)
+  {
+    const AL::Math::Transform& H = chain.getLinkTransform(j);
+    const unsigned int axis = j % 3;
+    const AL::Math::Position3D a(
+          (&H.r1_c1)[axis], (&H.r2_c1)[axis], (&H.r3_c1)[axis]);
+    const AL::Math::Position3D v = (j % 6 < 3) ?
+          a.crossProduct(p - AL::Math::position3DFromTransform(H)) : a;
+    const AL::Math::Position3D w = (j % 6 < 3) ? a : AL::Math::Position3D();
+    EXPECT_TRUE(AL::Math::Position3D(J[j], J[nbJoints + j], J[2*nbJoints + j]).isNear(
+                  v, 1.0e-5f)) << j;
+    EXPECT_TRUE(AL::Math::Position3D(J[3*nbJoints + j], J[4*nbJoints + j],
+                J[5*nbJoints + j]).isNear(w, 1.0e-6f)) << j;
+  }
+}
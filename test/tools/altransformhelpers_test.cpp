@@ -12,6 +12,7 @@
 #include <gtest/gtest.h>
 #include <stdexcept>
 #include <cmath>
+#include <vector>
 
 TEST(ALTransformHelpersTest, transformFromRotationPosition3D)
 {
@@ -662,6 +663,73 @@ TEST(ALTransformHelpersTest, velocityExponentialInPlace)
 
 } // end VelocityExponentialInPlace
 
+TEST(ALTransformHelpersTest, transformLogarithmBatch)
+{
+  std::vector<AL::Math::Transform> pHList;
+  pHList.push_back(AL::Math::Transform());
+  pHList.push_back(AL::Math::Transform::fromPosition(0.1f, 0.2f, 0.3f, 0.00001f, 0.0f, 0.0f));
+  pHList.push_back(AL::Math::Transform::fromPosition(0.1f, 0.2f, 0.3f, 0.0f, 0.0005f, 0.0f));
+  pHList.push_back(AL::Math::Transform::fromPosition(-0.1f, 0.2f, 0.3f, AL::Math::PI, 0.0f, 0.0f));
+  pHList.push_back(AL::Math::Transform::fromPosition(0.1f, -0.2f, 0.3f, 0.0f, AL::Math::PI, 0.0f));
+  pHList.push_back(AL::Math::Transform::fromPosition(0.1f, 0.2f, -0.3f, 0.0f, 0.0f, AL::Math::PI));
+  pHList.push_back(AL::Math::transformFromRotX(179.0f*AL::Math::TO_RAD));
+  pHList.push_back(AL::Math::transformFromRotY(-179.0f*AL::Math::TO_RAD));
+  pHList.push_back(AL::Math::transformFromRotZ(90.0f*AL::Math::TO_RAD));
+
+  // odd size to cover both the SIMD part and the tail of the batch
+  for (unsigned int i=0; i<18; i++)
+  {
+    const float k = static_cast<float>(i);
+    pHList.push_back(AL::Math::Transform::fromPosition(
+                       0.1f*k, -0.2f, 0.3f - 0.05f*k,
+                       0.17f*k - 1.5f, 0.5f - 0.06f*k, 0.1f*k));
+  }
+
+  const unsigned int size = static_cast<unsigned int>(pHList.size());
+  std::vector<AL::Math::Velocity6D> pVList(size);
+  AL::Math::transformLogarithmBatch(&pHList[0], size, &pVList[0]);
+
+  for (unsigned int i=0; i<size; i++)
+  {
+    AL::Math::Velocity6D pVExpected;
+    AL::Math::transformLogarithmInPlace(pHList[i], pVExpected);
+    EXPECT_TRUE(pVList[i].isNear(pVExpected, 1.0e-4f)) << i;
+  }
+
+  // empty batch
+  AL::Math::transformLogarithmBatch(&pHList[0], 0, &pVList[0]);
+}
+
+TEST(ALTransformHelpersTest, velocityExponentialBatch)
+{
+  std::vector<AL::Math::Velocity6D> pVList;
+  pVList.push_back(AL::Math::Velocity6D());
+  pVList.push_back(AL::Math::Velocity6D(0.1f, 0.2f, 0.3f, 0.0001f, 0.0f, 0.0f));
+  pVList.push_back(AL::Math::Velocity6D(0.1f, 0.2f, 0.3f, 0.0f, 0.0009f, 0.0f));
+  pVList.push_back(AL::Math::Velocity6D(0.1f, 0.2f, 0.3f, 0.0f, 0.0f, 0.0011f));
+  pVList.push_back(AL::Math::Velocity6D(-0.5f, 0.2f, 0.3f, 3.0f, 0.0f, 0.0f));
+
+  // odd size to cover both the SIMD part and the tail of the batch
+  for (unsigned int i=0; i<18; i++)
+  {
+    const float k = static_cast<float>(i);
+    pVList.push_back(AL::Math::Velocity6D(
+                       0.1f*k, -0.2f, 0.3f - 0.05f*k,
+                       0.17f*k - 1.5f, 0.5f - 0.06f*k, 0.1f*k));
+  }
+
+  const unsigned int size = static_cast<unsigned int>(pVList.size());
+  std::vector<AL::Math::Transform> pHList(size);
+  AL::Math::velocityExponentialBatch(&pVList[0], size, &pHList[0]);
+
+  for (unsigned int i=0; i<size; i++)
+  {
+    AL::Math::Transform pHExpected;
+    AL::Math::velocityExponentialInPlace(pVList[i], pHExpected);
+    EXPECT_TRUE(pHList[i].isNear(pHExpected, 1.0e-4f)) << i;
+  }
+}
+
 TEST(ALTransformHelpersTest, changeRepereVelocity6D)
 {
 
@@ -702,6 +770,52 @@ TEST(ALTransformHelpersTest, changeRepereTransposePosition6D)
 {
 }
 
+TEST(ALTransformHelpersTest, changeReferenceJacobian)
+{
+  const AL::Math::Transform pT = AL::Math::Transform::fromPosition(
+        0.1f, -0.2f, 0.3f, 0.4f, -0.5f, 0.6f);
+
+  // odd number of columns to cover both the SIMD part and the tail
+  const unsigned int nbColumns = 27;
+  std::vector<AL::Math::Velocity6D> pColumns(nbColumns);
+  std::vector<float> pJ(6*nbColumns);
+  for (unsigned int j=0; j<nbColumns; j++)
+  {
+    const float k = static_cast<float>(j);
+    pColumns[j] = AL::Math::Velocity6D(0.1f*k, 1.0f - 0.2f*k, 0.05f*k - 0.5f,
+                                       0.3f - 0.1f*k, 0.02f*k, -0.7f);
+    const std::vector<float> v = pColumns[j].toVector();
+    for (unsigned int row=0; row<6; row++)
+    {
+      pJ[row*nbColumns + j] = v[row];
+    }
+  }
+
+  std::vector<float> pJOut(6*nbColumns);
+  std::vector<float> pJTOut(6*nbColumns);
+  AL::Math::changeReferenceJacobian(pT, &pJ[0], nbColumns, &pJOut[0]);
+  AL::Math::changeReferenceTransposeJacobian(pT, &pJ[0], nbColumns, &pJTOut[0]);
+  for (unsigned int j=0; j<nbColumns; j++)
+  {
+    AL::Math::Velocity6D pExpected;
+    AL::Math::changeReferenceVelocity6D(pT, pColumns[j], pExpected);
+    EXPECT_TRUE(AL::Math::Velocity6D(
+                  pJOut[j], pJOut[nbColumns + j], pJOut[2*nbColumns + j],
+                  pJOut[3*nbColumns + j], pJOut[4*nbColumns + j],
+                  pJOut[5*nbColumns + j]).isNear(pExpected, 1.0e-6f)) << j;
+
+    AL::Math::changeReferenceTransposeVelocity6D(pT, pColumns[j], pExpected);
+    EXPECT_TRUE(AL::Math::Velocity6D(
+                  pJTOut[j], pJTOut[nbColumns + j], pJTOut[2*nbColumns + j],
+                  pJTOut[3*nbColumns + j], pJTOut[4*nbColumns + j],
+                  pJTOut[5*nbColumns + j]).isNear(pExpected, 1.0e-6f)) << j;
+  }
+
+  // in place
+  AL::Math::changeReferenceJacobian(pT, &pJ[0], nbColumns, &pJ[0]);
+  EXPECT_EQ(pJOut, pJ);
+}
+
 TEST(ALTransformHelpersTest, transformMeanInPlace)
 {
   // ************ TransformMeanInPlace ************
@@ -746,6 +860,54 @@ TEST(ALTransformHelpersTest, transformMeanInPlace)
                std::runtime_error);
 } // end transformMean
 
+TEST(ALTransformHelpersTest, TransformInterpolator)
+{
+  const AL::Math::Transform pHIn1 = AL::Math::Transform::fromPosition(
+        0.1f, -0.2f, 0.3f, 0.4f, -0.5f, 0.6f);
+  const AL::Math::Transform pHIn2 = AL::Math::Transform::fromPosition(
+        -0.3f, 0.1f, 0.5f, -0.2f, 0.7f, 1.1f);
+  const AL::Math::TransformInterpolator interpolator(pHIn1, pHIn2);
+
+  EXPECT_TRUE(interpolator.interpolate(0.0f).isNear(pHIn1, 1.0e-5f));
+  EXPECT_TRUE(interpolator.interpolate(1.0f).isNear(pHIn2, 1.0e-4f));
+  for (unsigned int i=0; i<=10; i++)
+  {
+    const float val = 0.1f*static_cast<float>(i);
+    EXPECT_TRUE(interpolator.interpolate(val).isNear(
+                  AL::Math::transformMean(pHIn1, pHIn2, val), 1.0e-6f)) << i;
+  }
+
+  // no exception out of [0, 1]
+  EXPECT_NO_THROW(interpolator.interpolate(1.1f));
+  EXPECT_NO_THROW(interpolator.interpolate(-0.1f));
+
+  // odd size to cover both the SIMD part and the tail of the batch
+  const unsigned int size = 37;
+  std::vector<float> pVal(size);
+  for (unsigned int i=0; i<size; i++)
+  {
+    pVal[i] = 1.2f*static_cast<float>(i)/static_cast<float>(size) - 0.1f;
+  }
+  std::vector<AL::Math::Transform> pHOut(size);
+  interpolator.interpolateBatch(&pVal[0], size, &pHOut[0]);
+  for (unsigned int i=0; i<size; i++)
+  {
+    EXPECT_TRUE(pHOut[i].isNear(interpolator.interpolate(pVal[i]), 1.0e-4f)) << i;
+  }
+
+  interpolator.sample(size, &pHOut[0]);
+  EXPECT_TRUE(pHOut[0].isNear(pHIn1, 1.0e-5f));
+  EXPECT_TRUE(pHOut[size - 1].isNear(pHIn2, 1.0e-4f));
+  for (unsigned int i=0; i<size; i++)
+  {
+    const float val = static_cast<float>(i)/static_cast<float>(size - 1);
+    EXPECT_TRUE(pHOut[i].isNear(interpolator.interpolate(val), 1.0e-4f)) << i;
+  }
+
+  AL::Math::TransformInterpolator identity;
+  EXPECT_TRUE(identity.interpolate(0.5f).isNear(AL::Math::Transform()));
+}
+
 TEST(ALTransformHelpersTest, transformFromPosition3DInPlace)
 {
 }
@@ -1419,3 +1581,262 @@ TEST(ALTransformHelpersTest, quaternionVsTransform)
 //  std::cout << "Result  : " << pQua << std::endl;
 //  std::cout << "Expected: " << AL::Math::Quaternion() << std::endl;
 }
+
+TEST(ALTransformHelpersTest, quaternionFromTransformBatch)
+{
+  std::vector<AL::Math::Transform> pTList;
+  pTList.push_back(AL::Math::Transform());
+  pTList.push_back(AL::Math::Transform::fromRotX(AL::Math::PI));
+  pTList.push_back(AL::Math::Transform::fromRotY(AL::Math::PI));
+  pTList.push_back(AL::Math::Transform::fromRotZ(AL::Math::PI));
+  pTList.push_back(AL::Math::Transform::fromRotX(-179.0f*AL::Math::TO_RAD));
+  pTList.push_back(AL::Math::Transform::fromRotY(179.0f*AL::Math::TO_RAD));
+
+  // odd size to cover both the SIMD part and the tail of the batch
+  for (unsigned int i=0; i<18; i++)
+  {
+    const float k = static_cast<float>(i);
+    pTList.push_back(AL::Math::Transform::fromPosition(
+                       0.1f*k, -0.2f, 0.3f - 0.05f*k,
+                       0.37f*k - 3.0f, 1.5f - 0.16f*k, 0.35f*k));
+  }
+
+  const unsigned int size = static_cast<unsigned int>(pTList.size());
+  std::vector<AL::Math::Rotation> pRotList(size);
+  for (unsigned int i=0; i<size; i++)
+  {
+    pRotList[i] = AL::Math::rotationFromTransform(pTList[i]);
+  }
+
+  std::vector<AL::Math::Quaternion> pQuaList(size);
+  std::vector<AL::Math::Quaternion> pQuaRotList(size);
+  AL::Math::quaternionFromTransformBatch(&pTList[0], size, &pQuaList[0]);
+  AL::Math::quaternionFromRotationBatch(&pRotList[0], size, &pQuaRotList[0]);
+
+  std::vector<AL::Math::Transform> pTOutList(size);
+  std::vector<AL::Math::Rotation> pRotOutList(size);
+  AL::Math::transformFromQuaternionBatch(&pQuaList[0], size, &pTOutList[0]);
+  AL::Math::rotationFromQuaternionBatch(&pQuaList[0], size, &pRotOutList[0]);
+
+  for (unsigned int i=0; i<size; i++)
+  {
+    const AL::Math::Quaternion pQuaExpected =
+        AL::Math::quaternionFromTransform(pTList[i]);
+    EXPECT_TRUE(pQuaList[i].isNear(pQuaExpected, 1.0e-5f)) << i;
+    EXPECT_TRUE(pQuaRotList[i].isNear(pQuaExpected, 1.0e-5f)) << i;
+    EXPECT_GE(pQuaList[i].w, 0.0f) << i;
+    EXPECT_NEAR(1.0f, pQuaList[i].norm(), 1.0e-5f) << i;
+
+    AL::Math::Transform pTExpected = pTList[i];
+    pTExpected.r1_c4 = 0.0f;
+    pTExpected.r2_c4 = 0.0f;
+    pTExpected.r3_c4 = 0.0f;
+    EXPECT_TRUE(pTOutList[i].isNear(pTExpected, 1.0e-5f)) << i;
+    EXPECT_TRUE(pRotOutList[i].isNear(pRotList[i], 1.0e-5f)) << i;
+  }
+
+  // empty batch
+  AL::Math::quaternionFromTransformBatch(&pTList[0], 0, &pQuaList[0]);
+}
+
+TEST(ALTransformHelpersTest, quaternionFromTransformNotOrthonormal)
+{
+  // drifted rotation parts, as after a long accumulation of products
+  std::vector<AL::Math::Transform> pTList;
+  AL::Math::Transform pT;
+  pT.r1_c1 = 1.01f;
+  pT.r2_c2 = 1.01f;
+  pT.r3_c3 = 1.01f;
+  pTList.push_back(pT);
+
+  pT = AL::Math::Transform::fromRotZ(0.7f)*AL::Math::Transform::fromRotX(-2.3f);
+  pT.r1_c1 *= 1.003f;
+  pT.r2_c1 += 0.002f;
+  pT.r3_c2 -= 0.004f;
+  pTList.push_back(pT);
+
+  pT = AL::Math::Transform::fromRotY(3.0f);
+  pT.r1_c3 *= 0.98f;
+  pT.r3_c3 *= 0.99f;
+  pTList.push_back(pT);
+
+  // zero rotation part
+  pT = AL::Math::Transform();
+  pT.r1_c1 = 0.0f;
+  pT.r2_c2 = 0.0f;
+  pT.r3_c3 = 0.0f;
+  pTList.push_back(pT);
+
+  for (unsigned int i=0; i<pTList.size(); i++)
+  {
+    const AL::Math::Quaternion pQua =
+        AL::Math::quaternionFromTransform(pTList[i]);
+    EXPECT_NEAR(1.0f, pQua.norm(), 1.0e-6f) << i;
+    EXPECT_GE(pQua.w, 0.0f) << i;
+  }
+  EXPECT_TRUE(AL::Math::quaternionFromTransform(pTList[0]).isNear(
+                AL::Math::Quaternion(), 1.0e-6f));
+  EXPECT_TRUE(AL::Math::quaternionFromTransform(pTList[3]).isNear(
+                AL::Math::Quaternion(), 1.0e-6f));
+
+  const unsigned int size = static_cast<unsigned int>(pTList.size());
+  std::vector<AL::Math::Quaternion> pQuaList(size);
+  AL::Math::quaternionFromTransformBatch(&pTList[0], size, &pQuaList[0]);
+  for (unsigned int i=0; i<size; i++)
+  {
+    EXPECT_NEAR(1.0f, pQuaList[i].norm(), 1.0e-5f) << i;
+    EXPECT_TRUE(pQuaList[i].isNear(
+                  AL::Math::quaternionFromTransform(pTList[i]), 1.0e-5f)) << i;
+  }
+}
+
+TEST(ALTransformHelpersTest, position6DFromTransformBatch)
+{
+  std::vector<AL::Math::Transform> pTList;
+  pTList.push_back(AL::Math::Transform());
+  pTList.push_back(AL::Math::Transform::fromRotY(AL::Math::PI_2));
+  pTList.push_back(AL::Math::Transform::fromRotY(-AL::Math::PI_2));
+  pTList.push_back(AL::Math::Transform::fromRotX(AL::Math::PI));
+
+  // odd size to cover both the SIMD part and the tail of the batch
+  for (unsigned int i=0; i<18; i++)
+  {
+    const float k = static_cast<float>(i);
+    pTList.push_back(AL::Math::Transform::fromPosition(
+                       0.1f*k, -0.2f, 0.3f - 0.05f*k,
+                       0.37f*k - 3.0f, 1.5f - 0.17f*k, 0.35f*k - 3.1f));
+  }
+
+  const unsigned int size = static_cast<unsigned int>(pTList.size());
+  std::vector<AL::Math::Rotation> pRotList(size);
+  for (unsigned int i=0; i<size; i++)
+  {
+    pRotList[i] = AL::Math::rotationFromTransform(pTList[i]);
+  }
+
+  std::vector<AL::Math::Position6D> pPosList(size);
+  std::vector<AL::Math::Rotation3D> pRot3DList(size);
+  std::vector<AL::Math::Rotation3D> pRot3DRotList(size);
+  AL::Math::position6DFromTransformBatch(&pTList[0], size, &pPosList[0]);
+  AL::Math::rotation3DFromTransformBatch(&pTList[0], size, &pRot3DList[0]);
+  AL::Math::rotation3DFromRotationBatch(&pRotList[0], size, &pRot3DRotList[0]);
+
+  for (unsigned int i=0; i<size; i++)
+  {
+    EXPECT_TRUE(pPosList[i].isNear(
+                  AL::Math::position6DFromTransform(pTList[i]), 1.0e-5f)) << i;
+    EXPECT_TRUE(pRot3DList[i].isNear(
+                  AL::Math::rotation3DFromTransform(pTList[i]), 1.0e-5f)) << i;
+    EXPECT_TRUE(pRot3DRotList[i].isNear(
+                  AL::Math::rotation3DFromRotation(pRotList[i]), 1.0e-5f)) << i;
+  }
+
+  // empty batch
+  AL::Math::position6DFromTransformBatch(&pTList[0], 0, &pPosList[0]);
+}
+
+TEST(ALTransformHelpersTest, rotation3DFromTransformBatchConventions)
+{
+  const AL::Math::EulerConvention conventions[6] = {
+    AL::Math::EULER_ZYX, AL::Math::EULER_XYZ, AL::Math::EULER_XZY,
+    AL::Math::EULER_YXZ, AL::Math::EULER_YZX, AL::Math::EULER_ZXY};
+  // axes of the product, from left to right
+  const char orders[6][4] = {"zyx", "xyz", "xzy", "yxz", "yzx", "zxy"};
+
+  for (unsigned int c=0; c<6; c++)
+  {
+    std::vector<AL::Math::Rotation3D> pExpected;
+    std::vector<AL::Math::Transform> pTList;
+    for (unsigned int i=0; i<13; i++)
+    {
+      const float k = static_cast<float>(i);
+      AL::Math::Rotation3D pAngles(0.45f*k - 2.9f, 0.0f, 3.0f - 0.47f*k);
+      float* angles[3] = {&pAngles.wx, &pAngles.wy, &pAngles.wz};
+      // the middle angle is in [-pi/2, pi/2]
+      *angles[orders[c][1] - 'x'] = 0.23f*k - 1.4f;
+
+      AL::Math::Transform pT;
+      for (unsigned int j=0; j<3; j++)
+      {
+        const float angle = *angles[orders[c][j] - 'x'];
+        switch (orders[c][j])
+        {
+        case 'x': pT *= AL::Math::Transform::fromRotX(angle); break;
+        case 'y': pT *= AL::Math::Transform::fromRotY(angle); break;
+        default:  pT *= AL::Math::Transform::fromRotZ(angle); break;
+        }
+      }
+      pExpected.push_back(pAngles);
+      pTList.push_back(pT);
+    }
+
+    const unsigned int size = static_cast<unsigned int>(pTList.size());
+    std::vector<AL::Math::Rotation3D> pRot3DList(size);
+    AL::Math::rotation3DFromTransformBatch(
+          &pTList[0], size, &pRot3DList[0], conventions[c]);
+    for (unsigned int i=0; i<size; i++)
+    {
+      EXPECT_TRUE(pRot3DList[i].isNear(pExpected[i], 1.0e-4f))
+          << orders[c] << " " << i;
+    }
+  }
+
+  AL::Math::Rotation3D pRot3D;
+  const AL::Math::Transform pT;
+  EXPECT_THROW(AL::Math::rotation3DFromTransformBatch(
+                 &pT, 1, &pRot3D, static_cast<AL::Math::EulerConvention>(6)),
+               std::invalid_argument);
+}
+
+TEST(ALTransformHelpersTest, transformPoints)
+{
+  const AL::Math::Transform pT = AL::Math::Transform::fromPosition(
+        0.1f, -0.2f, 0.3f, 0.4f, -0.5f, 0.6f);
+
+  // odd size to cover both the SIMD part and the tail of the batch
+  const unsigned int size = 37;
+  std::vector<AL::Math::Position3D> pPoints(size);
+  std::vector<float> pXYZ(3*size);
+  std::vector<float> pX(size), pY(size), pZ(size);
+  for (unsigned int i=0; i<size; i++)
+  {
+    const float k = static_cast<float>(i);
+    pPoints[i] = AL::Math::Position3D(0.1f*k, 1.0f - 0.2f*k, 0.05f*k - 0.5f);
+    pX[i] = pXYZ[3*i]     = pPoints[i].x;
+    pY[i] = pXYZ[3*i + 1] = pPoints[i].y;
+    pZ[i] = pXYZ[3*i + 2] = pPoints[i].z;
+  }
+
+  // packed
+  std::vector<float> pOut(3*size);
+  AL::Math::transformPoints(pT, &pXYZ[0], size, &pOut[0]);
+  for (unsigned int i=0; i<size; i++)
+  {
+    EXPECT_TRUE(AL::Math::Position3D(pOut[3*i], pOut[3*i + 1], pOut[3*i + 2]).isNear(
+                  pT*pPoints[i], 1.0e-6f)) << i;
+  }
+
+  // packed in place
+  AL::Math::transformPoints(pT, &pXYZ[0], size, &pXYZ[0]);
+  EXPECT_EQ(pOut, pXYZ);
+
+  // structure of arrays
+  std::vector<float> pOutX(size), pOutY(size), pOutZ(size);
+  AL::Math::transformPoints(pT, &pX[0], &pY[0], &pZ[0], size,
+                            &pOutX[0], &pOutY[0], &pOutZ[0]);
+  for (unsigned int i=0; i<size; i++)
+  {
+    EXPECT_TRUE(AL::Math::Position3D(pOutX[i], pOutY[i], pOutZ[i]).isNear(
+                  pT*pPoints[i], 1.0e-6f)) << i;
+  }
+
+  // structure of arrays in place
+  AL::Math::transformPoints(pT, &pX[0], &pY[0], &pZ[0], size,
+                            &pX[0], &pY[0], &pZ[0]);
+  EXPECT_EQ(pOutX, pX);
+  EXPECT_EQ(pOutY, pY);
+  EXPECT_EQ(pOutZ, pZ);
+
+  // empty batch
+  AL::Math::transformPoints(pT, &pXYZ[0], 0, &pOut[0]);
+}
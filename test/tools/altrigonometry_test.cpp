@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+#include <almath/tools/altrigonometry.h>
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(ALTrigonometryTest, fastSinCos)
+{
+  // accuracy against libm (double precision)
+  double maxError = 0.0;
+  for (int i=-200000; i<=200000; ++i)
+  {
+    const float angle = 0.0005f*static_cast<float>(i);
+    float s = 0.0f;
+    float c = 0.0f;
+    AL::Math::fastSinCos(angle, s, c);
+    maxError = std::max(maxError, std::fabs(s - std::sin(static_cast<double>(angle))));
+    maxError = std::max(maxError, std::fabs(c - std::cos(static_cast<double>(angle))));
+  }
+  EXPECT_LT(maxError, 2.0e-7);
+
+  float s = 1.0f;
+  float c = 0.0f;
+  AL::Math::fastSinCos(0.0f, s, c);
+  EXPECT_EQ(0.0f, s);
+  EXPECT_EQ(1.0f, c);
+}
+
+TEST(ALTrigonometryTest, fastAtan2)
+{
+  // accuracy against libm (double precision)
+  double maxError = 0.0;
+  for (int i=0; i<100000; ++i)
+  {
+    const double angle = -AL::Math::PI + 2.0*AL::Math::PI*i/100000.0;
+    const float radius = 0.001f + 0.1f*static_cast<float>(i % 37);
+    const float y = radius*static_cast<float>(std::sin(angle));
+    const float x = radius*static_cast<float>(std::cos(angle));
+    maxError = std::max(maxError, std::fabs(
+                          AL::Math::fastAtan2(y, x) -
+                          std::atan2(static_cast<double>(y), static_cast<double>(x))));
+  }
+  EXPECT_LT(maxError, 4.0e-7);
+
+  EXPECT_EQ(0.0f, AL::Math::fastAtan2(0.0f, 0.0f));
+  EXPECT_EQ(0.0f, AL::Math::fastAtan2(0.0f, 1.0f));
+  EXPECT_NEAR(AL::Math::PI_2, AL::Math::fastAtan2(1.0f, 0.0f), 4.0e-7f);
+  EXPECT_NEAR(-AL::Math::PI_2, AL::Math::fastAtan2(-1.0f, 0.0f), 4.0e-7f);
+  EXPECT_NEAR(AL::Math::PI, AL::Math::fastAtan2(0.0f, -1.0f), 4.0e-7f);
+}
+
+TEST(ALTrigonometryTest, fastBatch)
+{
+  // an odd size to test the tail of the SIMD loops
+  const unsigned int size = 103;
+  std::vector<float> angles(size);
+  std::vector<float> y(size);
+  std::vector<float> x(size);
+  for (unsigned int i=0; i<size; ++i)
+  {
+    angles[i] = -4.0f + 0.08f*static_cast<float>(i);
+    y[i] = std::sin(angles[i]);
+    x[i] = 2.0f*std::cos(angles[i]);
+  }
+
+  std::vector<float> sinOut(size);
+  std::vector<float> cosOut(size);
+  std::vector<float> atanOut(size);
+  AL::Math::fastSinCosBatch(&angles[0], size, &sinOut[0], &cosOut[0]);
+  AL::Math::fastAtan2Batch(&y[0], &x[0], size, &atanOut[0]);
+
+  for (unsigned int i=0; i<size; ++i)
+  {
+    float s = 0.0f;
+    float c = 0.0f;
+    AL::Math::fastSinCos(angles[i], s, c);
+    // not bit exact: the compiler may contract the polynomials of the
+    // scalar and of the SIMD code into different fused multiply-adds
+    EXPECT_NEAR(s, sinOut[i], 2.0e-7f);
+    EXPECT_NEAR(c, cosOut[i], 2.0e-7f);
+    EXPECT_NEAR(AL::Math::fastAtan2(y[i], x[i]), atanOut[i], 1.0e-7f);
+  }
+}
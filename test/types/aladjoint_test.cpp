@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+#include <almath/types/aladjoint.h>
+#include <almath/tools/altransformhelpers.h>
+#include <almath/tools/almathio.h>
+
+#include <gtest/gtest.h>
+#include <vector>
+
+
+namespace {
+  AL::Math::Transform xTransform(const float pK)
+  {
+    return AL::Math::Transform::fromPosition(
+          0.1f + pK, -0.2f, 0.3f - pK, 0.4f + pK, -0.5f, 0.6f - pK);
+  }
+
+  float xDot(
+    const AL::Math::Velocity6D& pV1,
+    const AL::Math::Velocity6D& pV2)
+  {
+    return pV1.xd*pV2.xd + pV1.yd*pV2.yd + pV1.zd*pV2.zd +
+        pV1.wxd*pV2.wxd + pV1.wyd*pV2.wyd + pV1.wzd*pV2.wzd;
+  }
+}
+
+TEST(ALAdjointTest, creation)
+{
+  const AL::Math::Adjoint pAd;
+  EXPECT_TRUE(pAd.isNear(AL::Math::Adjoint(AL::Math::Transform())));
+
+  const AL::Math::Velocity6D pV(0.1f, -0.2f, 0.3f, 0.4f, -0.5f, 0.6f);
+  EXPECT_TRUE((pAd*pV).isNear(pV));
+
+  // a pure rotation is changeReferenceVelocity6D
+  AL::Math::Transform pRot = xTransform(0.2f);
+  pRot.r1_c4 = 0.0f;
+  pRot.r2_c4 = 0.0f;
+  pRot.r3_c4 = 0.0f;
+  AL::Math::Velocity6D pVRot;
+  AL::Math::changeReferenceVelocity6D(pRot, pV, pVRot);
+  EXPECT_TRUE((AL::Math::Adjoint(pRot)*pV).isNear(pVRot));
+  AL::Math::changeReferenceTransposeVelocity6D(pRot, pV, pVRot);
+  EXPECT_TRUE(AL::Math::Adjoint(pRot).transposeMultiply(pV).isNear(pVRot));
+}
+
+TEST(ALAdjointTest, multiply)
+{
+  const AL::Math::Transform pT = xTransform(0.1f);
+  const AL::Math::Adjoint pAd(pT);
+  const AL::Math::Velocity6D pV(0.1f, -0.2f, 0.3f, 0.4f, -0.5f, 0.6f);
+
+  // w' = R w and v' = R v + p x (R w)
+  AL::Math::Position3D pW;
+  AL::Math::Position3D pLin;
+  AL::Math::changeReferencePosition3D(
+        pT, AL::Math::Position3D(pV.wxd, pV.wyd, pV.wzd), pW);
+  AL::Math::changeReferencePosition3D(
+        pT, AL::Math::Position3D(pV.xd, pV.yd, pV.zd), pLin);
+  pLin += AL::Math::position3DFromTransform(pT).crossProduct(pW);
+  EXPECT_TRUE((pAd*pV).isNear(AL::Math::Velocity6D(
+                                pLin.x, pLin.y, pLin.z, pW.x, pW.y, pW.z)));
+
+  // the 6x6 matrix
+  float pMatrix[AL::Math::Adjoint::SIZE];
+  pAd.writeTo(pMatrix);
+  const float pIn[6] = {pV.xd, pV.yd, pV.zd, pV.wxd, pV.wyd, pV.wzd};
+  float pOut[6];
+  float pOutT[6];
+  for (unsigned int i=0; i<6; i++)
+  {
+    pOut[i] = 0.0f;
+    pOutT[i] = 0.0f;
+    for (unsigned int j=0; j<6; j++)
+    {
+      pOut[i] += pMatrix[6*i + j]*pIn[j];
+      pOutT[i] += pMatrix[6*j + i]*pIn[j];
+    }
+  }
+  EXPECT_TRUE((pAd*pV).isNear(AL::Math::Velocity6D(
+                                pOut[0], pOut[1], pOut[2],
+                                pOut[3], pOut[4], pOut[5])));
+  EXPECT_TRUE(pAd.transposeMultiply(pV).isNear(AL::Math::Velocity6D(
+                                pOutT[0], pOutT[1], pOutT[2],
+                                pOutT[3], pOutT[4], pOutT[5])));
+}
+
+TEST(ALAdjointTest, composition)
+{
+  const AL::Math::Transform pT1 = xTransform(0.1f);
+  const AL::Math::Transform pT2 = xTransform(-0.4f);
+  const AL::Math::Adjoint pAd1(pT1);
+
+  EXPECT_TRUE((pAd1*AL::Math::Adjoint(pT2)).isNear(
+                AL::Math::Adjoint(pT1*pT2)));
+  EXPECT_TRUE(pAd1.inverse().isNear(AL::Math::Adjoint(pT1.inverse())));
+  EXPECT_TRUE((pAd1*pAd1.inverse()).isNear(AL::Math::Adjoint()));
+}
+
+TEST(ALAdjointTest, wrench)
+{
+  const AL::Math::Adjoint pAd(xTransform(0.3f));
+  const AL::Math::Velocity6D pV(0.1f, -0.2f, 0.3f, 0.4f, -0.5f, 0.6f);
+  const AL::Math::Velocity6D pF(-1.0f, 2.0f, 0.5f, 0.2f, 0.1f, -0.3f);
+
+  // the power does not depend on the reference frame
+  EXPECT_NEAR(xDot(pF, pV), xDot(pAd.transformWrench(pF), pAd*pV), 1.0e-5f);
+
+  // the co-adjoint brings the wrench back
+  EXPECT_TRUE(pAd.transposeMultiply(pAd.transformWrench(pF)).isNear(pF));
+
+  // a pure force at the origin of B gives a torque p x f in A
+  const AL::Math::Transform pTrans(1.0f, 0.0f, 0.0f);
+  const AL::Math::Velocity6D pFy(0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+  EXPECT_TRUE(AL::Math::Adjoint(pTrans).transformWrench(pFy).isNear(
+                AL::Math::Velocity6D(0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f)));
+}
+
+TEST(ALAdjointTest, batch)
+{
+  const AL::Math::Adjoint pAd(xTransform(0.2f));
+
+  // odd size to cover both the SIMD part and the tail of the batch
+  const unsigned int size = 19;
+  std::vector<AL::Math::Velocity6D> pV(size);
+  for (unsigned int i=0; i<size; i++)
+  {
+    const float k = static_cast<float>(i);
+    pV[i] = AL::Math::Velocity6D(0.1f*k, -0.2f, 0.3f - 0.05f*k,
+                                 0.17f*k - 1.5f, 0.5f - 0.06f*k, 0.1f*k);
+  }
+
+  std::vector<AL::Math::Velocity6D> pOut(size);
+  std::vector<AL::Math::Velocity6D> pOutT(size);
+  std::vector<AL::Math::Velocity6D> pOutW(size);
+  AL::Math::adjointMultiplyBatch(pAd, &pV[0], size, &pOut[0]);
+  AL::Math::adjointTransposeMultiplyBatch(pAd, &pV[0], size, &pOutT[0]);
+  AL::Math::adjointTransformWrenchBatch(pAd, &pV[0], size, &pOutW[0]);
+  for (unsigned int i=0; i<size; i++)
+  {
+    EXPECT_TRUE(pOut[i].isNear(pAd*pV[i], 1.0e-5f)) << i;
+    EXPECT_TRUE(pOutT[i].isNear(pAd.transposeMultiply(pV[i]), 1.0e-5f)) << i;
+    EXPECT_TRUE(pOutW[i].isNear(pAd.transformWrench(pV[i]), 1.0e-5f)) << i;
+  }
+
+  // in place
+  AL::Math::adjointMultiplyBatch(pAd, &pV[0], size, &pV[0]);
+  for (unsigned int i=0; i<size; i++)
+  {
+    EXPECT_TRUE(pV[i].isNear(pOut[i], 1.0e-6f)) << i;
+  }
+}
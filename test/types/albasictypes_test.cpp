@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+#include <almath/types/albasictypes.h>
+#include <almath/tools/altransformhelpers.h>
+#include <almath/tools/almathio.h>
+
+#include <gtest/gtest.h>
+
+
+TEST(ALBasicTypesTest, position3D)
+{
+  const AL::Math::Position3D pPos1(0.1f, -0.2f, 0.3f);
+  const AL::Math::Position3D pPos2(1.0f, 2.0f, -3.0f);
+
+  const AL::Math::Position3Dd pPosd1 = pPos1;
+  EXPECT_TRUE(pPosd1.toPosition3D().isNear(pPos1));
+  EXPECT_TRUE((pPosd1 + pPos2).toPosition3D().isNear(pPos1 + pPos2));
+  EXPECT_TRUE((pPosd1 - pPos2).toPosition3D().isNear(pPos1 - pPos2));
+  EXPECT_TRUE((pPosd1*2.0).toPosition3D().isNear(pPos1*2.0f));
+  EXPECT_NEAR(pPos1.dotProduct(pPos2), pPosd1.dotProduct(pPos2), 1e-6);
+  EXPECT_NEAR(pPos1.norm(), pPosd1.norm(), 1e-6);
+}
+
+TEST(ALBasicTypesTest, pose2D)
+{
+  const AL::Math::Pose2D pPose1(0.1f, -0.2f, 0.3f);
+  const AL::Math::Pose2D pPose2(1.0f, 2.0f, -0.5f);
+
+  const AL::Math::Pose2Dd pPosed1 = pPose1;
+  EXPECT_TRUE(pPosed1.toPose2D().isNear(pPose1));
+  EXPECT_TRUE((pPosed1*pPose2).toPose2D().isNear(pPose1*pPose2));
+  EXPECT_TRUE(pPosed1.inverse().toPose2D().isNear(pPose1.inverse()));
+  EXPECT_TRUE((pPosed1*pPosed1.inverse()).isNear(AL::Math::Pose2Dd(), 1e-12));
+}
+
+TEST(ALBasicTypesTest, transform)
+{
+  const AL::Math::Transform pT1 = AL::Math::Transform::fromPosition(
+        0.1f, -0.2f, 0.3f, 0.4f, -0.5f, 0.6f);
+  const AL::Math::Transform pT2 = AL::Math::Transform::fromPosition(
+        -1.0f, 2.0f, 0.5f, -0.3f, 0.2f, 0.1f);
+  const AL::Math::Position3D pPos(0.5f, -0.6f, 0.7f);
+
+  const AL::Math::Transformd pTd1 = pT1;
+  EXPECT_TRUE(pTd1.toTransform().isNear(pT1));
+  EXPECT_TRUE((pTd1*pT2).toTransform().isNear(pT1*pT2));
+  EXPECT_TRUE((pTd1*pPos).toPosition3D().isNear(pT1*pPos));
+  EXPECT_TRUE(pTd1.inverse().toTransform().isNear(pT1.inverse()));
+
+  AL::Math::Transformd pTd2 = pTd1;
+  pTd2 *= pTd1.inverse();
+  EXPECT_TRUE(pTd2.isNear(AL::Math::Transformd(), 1e-6));
+}
+
+TEST(ALBasicTypesTest, accumulation)
+{
+  // a float odometry increment accumulated in double does not drift
+  const AL::Math::Pose2D pStep(0.001f, 0.0f, 0.0f);
+  const unsigned int nb = 1000000;
+
+  AL::Math::Pose2Dd pOdometry;
+  AL::Math::Pose2D pOdometryFloat;
+  for (unsigned int i = 0; i < nb; ++i)
+  {
+    pOdometry *= pStep;
+    pOdometryFloat *= pStep;
+  }
+  const double expected = static_cast<double>(pStep.x)*nb;
+  EXPECT_NEAR(expected, pOdometry.x, 1e-6);
+  EXPECT_GT(std::fabs(expected - pOdometryFloat.x), 1e-3);
+}
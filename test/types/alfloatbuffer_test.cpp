@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+#include <almath/types/alfloatbuffer.h>
+#include <almath/types/alpose2d.h>
+#include <almath/types/alposition2d.h>
+#include <almath/types/alposition3d.h>
+#include <almath/types/alposition6d.h>
+#include <almath/types/alquaternion.h>
+#include <almath/types/alquattransform.h>
+#include <almath/types/alrotation.h>
+#include <almath/types/alrotation3d.h>
+#include <almath/types/altransform.h>
+#include <almath/types/alvelocity3d.h>
+#include <almath/types/alvelocity6d.h>
+#include <almath/tools/almathio.h>
+
+#include <gtest/gtest.h>
+
+
+namespace {
+  // writeTo must write the first SIZE float of toVector, and the pointer
+  // constructor must read them back.
+  template <typename T>
+  void xCheckRoundTrip(const T& pIn)
+  {
+    const std::vector<float> vec = pIn.toVector();
+    ASSERT_GE(vec.size(), T::SIZE);
+
+    float buffer[T::SIZE + 1];
+    buffer[T::SIZE] = 42.0f;
+    pIn.writeTo(buffer);
+    EXPECT_EQ(42.0f, buffer[T::SIZE]);
+    for (unsigned int i = 0; i < T::SIZE; ++i)
+    {
+      EXPECT_EQ(vec[i], buffer[i]);
+    }
+
+    const T out(buffer, T::SIZE);
+    EXPECT_TRUE(out.isNear(pIn));
+  }
+
+  // as the std::vector constructor, a wrong size gives pExpected
+  template <typename T>
+  void xCheckWrongSize(
+    const T& pIn,
+    const T& pExpected)
+  {
+    float buffer[T::SIZE];
+    pIn.writeTo(buffer);
+    EXPECT_TRUE(T(buffer, T::SIZE - 1).isNear(pExpected));
+    EXPECT_TRUE(T(buffer, 0).isNear(pExpected));
+    EXPECT_TRUE(T(std::vector<float>(T::SIZE - 1, 1.0f)).isNear(pExpected));
+  }
+}
+
+TEST(ALFloatBufferTest, roundTrip)
+{
+  xCheckRoundTrip(AL::Math::Pose2D(0.1f, -0.2f, 0.3f));
+  xCheckRoundTrip(AL::Math::Position2D(0.1f, -0.2f));
+  xCheckRoundTrip(AL::Math::Position3D(0.1f, -0.2f, 0.3f));
+  xCheckRoundTrip(AL::Math::Position6D(0.1f, -0.2f, 0.3f, -0.4f, 0.5f, -0.6f));
+  xCheckRoundTrip(AL::Math::Quaternion(0.5f, 0.5f, -0.5f, 0.5f));
+  xCheckRoundTrip(AL::Math::Rotation::fromRotX(0.3f));
+  xCheckRoundTrip(AL::Math::Rotation3D(0.1f, -0.2f, 0.3f));
+  xCheckRoundTrip(AL::Math::Velocity3D(0.1f, -0.2f, 0.3f));
+  xCheckRoundTrip(AL::Math::Velocity6D(0.1f, -0.2f, 0.3f, -0.4f, 0.5f, -0.6f));
+  xCheckRoundTrip(AL::Math::Transform::fromPosition(
+                    0.1f, -0.2f, 0.3f, -0.4f, 0.5f, -0.6f));
+
+  const AL::Math::QuatTransform pQT(
+        AL::Math::Quaternion(0.5f, 0.5f, -0.5f, 0.5f),
+        AL::Math::Position3D(0.1f, -0.2f, 0.3f));
+  float buffer[AL::Math::QuatTransform::SIZE];
+  pQT.writeTo(buffer);
+  EXPECT_EQ(0.5f, buffer[0]);
+  EXPECT_EQ(-0.5f, buffer[2]);
+  EXPECT_EQ(0.3f, buffer[6]);
+  EXPECT_TRUE(AL::Math::QuatTransform(
+                buffer, AL::Math::QuatTransform::SIZE).isNear(pQT));
+  EXPECT_TRUE(AL::Math::QuatTransform(buffer, 3).isNear(
+                AL::Math::QuatTransform()));
+}
+
+TEST(ALFloatBufferTest, wrongSize)
+{
+  xCheckWrongSize(AL::Math::Pose2D(0.1f, -0.2f, 0.3f),
+                  AL::Math::Pose2D());
+  xCheckWrongSize(AL::Math::Position3D(0.1f, -0.2f, 0.3f),
+                  AL::Math::Position3D());
+  xCheckWrongSize(AL::Math::Quaternion(0.5f, 0.5f, -0.5f, 0.5f),
+                  AL::Math::Quaternion(0.0f, 0.0f, 0.0f, 0.0f));
+  xCheckWrongSize(AL::Math::Transform::fromPosition(
+                    0.1f, -0.2f, 0.3f, -0.4f, 0.5f, -0.6f),
+                  AL::Math::Transform());
+}
+
+TEST(ALFloatBufferTest, bulk)
+{
+  const unsigned int nb = 5;
+  AL::Math::Transform tIn[nb];
+  for (unsigned int i = 0; i < nb; ++i)
+  {
+    tIn[i] = AL::Math::Transform::fromPosition(
+          0.1f*i, -0.2f, 0.3f, -0.4f*i, 0.5f, -0.6f);
+  }
+
+  float buffer[nb*AL::Math::Transform::SIZE];
+  AL::Math::toFloatBuffer(tIn, nb, buffer);
+
+  AL::Math::Transform tOut[nb];
+  AL::Math::fromFloatBuffer(buffer, nb, tOut);
+  for (unsigned int i = 0; i < nb; ++i)
+  {
+    EXPECT_TRUE(tOut[i].isNear(tIn[i]));
+    EXPECT_EQ(tIn[i].r2_c4,
+              buffer[i*AL::Math::Transform::SIZE + 7]);
+  }
+
+  // empty buffers are allowed
+  AL::Math::fromFloatBuffer(buffer, 0, tOut);
+  AL::Math::toFloatBuffer(tIn, 0, buffer);
+}
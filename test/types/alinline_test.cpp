@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+// The arithmetic of the core value types is used inline in this file,
+// the other tests use the out-of-line definitions of the library.
+#define ALMATH_INLINE_TYPES
+
+#include <almath/types/alposition3d.h>
+#include <almath/types/alpose2d.h>
+#include <almath/types/alquaternion.h>
+#include <almath/types/altransform.h>
+#include <almath/types/altransformview.h>
+#include <almath/tools/altrigonometry.h>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+TEST(ALInlineTest, position3D)
+{
+  const AL::Math::Position3D pPos1(1.0f, 2.0f, 3.0f);
+  const AL::Math::Position3D pPos2(-0.5f, 0.5f, 2.0f);
+
+  EXPECT_TRUE((pPos1 + pPos2).isNear(AL::Math::Position3D(0.5f, 2.5f, 5.0f)));
+  EXPECT_TRUE((pPos1 - pPos2).isNear(AL::Math::Position3D(1.5f, 1.5f, 1.0f)));
+  EXPECT_TRUE((2.0f*pPos1).isNear(AL::Math::Position3D(2.0f, 4.0f, 6.0f)));
+  EXPECT_NEAR(6.5f, pPos1.dotProduct(pPos2), 0.0001f);
+  EXPECT_TRUE(pPos1.crossProduct(pPos2).isNear(
+                AL::Math::Position3D(2.5f, -3.5f, 1.5f)));
+  EXPECT_THROW(pPos1/0.0f, std::runtime_error);
+}
+
+TEST(ALInlineTest, pose2D)
+{
+  const AL::Math::Pose2D pPose1(0.1f, 0.2f, AL::Math::PI_2);
+  const AL::Math::Pose2D pPose2(1.0f, 0.0f, 0.3f);
+
+  EXPECT_TRUE((pPose1*pPose2).isNear(AL::Math::Pose2D(0.1f, 1.2f, AL::Math::PI_2 + 0.3f)));
+  EXPECT_TRUE((pPose1*pPose1.inverse()).isNear(AL::Math::Pose2D()));
+}
+
+TEST(ALInlineTest, quaternion)
+{
+  const AL::Math::Quaternion pQua1(0.5f, 0.5f, 0.5f, 0.5f);
+  EXPECT_TRUE((pQua1*pQua1.inverse()).isNear(AL::Math::Quaternion()));
+  EXPECT_NEAR(1.0f, pQua1.norm(), 0.0001f);
+}
+
+TEST(ALInlineTest, transform)
+{
+  AL::Math::Transform pT1(0.1f, 0.2f, 0.3f);
+  pT1.r1_c1 = 0.0f;
+  pT1.r1_c2 = -1.0f;
+  pT1.r2_c1 = 1.0f;
+  pT1.r2_c2 = 0.0f;
+  const AL::Math::Transform pT2(1.0f, 0.0f, 0.0f);
+
+  const AL::Math::Transform pTOut = pT1*pT2;
+  EXPECT_NEAR(0.1f, pTOut.r1_c4, 0.0001f);
+  EXPECT_NEAR(1.2f, pTOut.r2_c4, 0.0001f);
+  EXPECT_NEAR(0.3f, pTOut.r3_c4, 0.0001f);
+  EXPECT_TRUE((pT1*pT1.inverse()).isNear(AL::Math::Transform()));
+}
+
+TEST(ALInlineTest, transformView)
+{
+  const AL::Math::Transform pT(0.1f, 0.2f, 0.3f);
+  float buffer[AL::Math::Transform::SIZE + AL::Math::Position3D::SIZE];
+  AL::Math::TransformView pTView(buffer);
+  AL::Math::Position3DView pPosView(buffer + AL::Math::Transform::SIZE);
+
+  pTView = pT;
+  pPosView = AL::Math::Position3D(1.0f, 2.0f, 3.0f);
+  pPosView = pTView*pPosView;
+  EXPECT_NEAR(1.1f, buffer[12], 0.0001f);
+  EXPECT_NEAR(2.2f, buffer[13], 0.0001f);
+  EXPECT_NEAR(3.3f, buffer[14], 0.0001f);
+
+  pTView *= pT;
+  EXPECT_NEAR(0.2f, buffer[3], 0.0001f);
+  EXPECT_TRUE((pTView*pTView.inverse()).isNear(AL::Math::Transform()));
+}
@@ -338,3 +338,129 @@ TEST(ALQuaternionTest, creation)
   }
 
 }
+
+TEST(ALQuaternionTest, quaternionSlerp)
+{
+  const AL::Math::Quaternion pQua1 =
+      AL::Math::quaternionFromAngleAndAxisRotation(0.2f, 0.0f, 0.0f, 1.0f);
+  const AL::Math::Quaternion pQua2 =
+      AL::Math::quaternionFromAngleAndAxisRotation(1.4f, 0.0f, 0.0f, 1.0f);
+
+  EXPECT_TRUE(AL::Math::quaternionSlerp(pQua1, pQua2, 0.0f).isNear(pQua1));
+  EXPECT_TRUE(AL::Math::quaternionSlerp(pQua1, pQua2, 1.0f).isNear(pQua2));
+  EXPECT_TRUE(AL::Math::quaternionSlerp(pQua1, pQua2, 0.25f).isNear(
+                AL::Math::quaternionFromAngleAndAxisRotation(
+                  0.5f, 0.0f, 0.0f, 1.0f)));
+
+  // -pQua2 is the same rotation: the shortest path is taken
+  AL::Math::Quaternion pQua3 = pQua2;
+  pQua3 *= -1.0f;
+  EXPECT_TRUE(AL::Math::quaternionSlerp(pQua1, pQua3, 0.25f).isNear(
+                AL::Math::quaternionFromAngleAndAxisRotation(
+                  0.5f, 0.0f, 0.0f, 1.0f)));
+
+  // close quaternions
+  const AL::Math::Quaternion pQua4 =
+      AL::Math::quaternionFromAngleAndAxisRotation(0.2001f, 0.0f, 0.0f, 1.0f);
+  const AL::Math::Quaternion pQuaOut =
+      AL::Math::quaternionSlerp(pQua1, pQua4, 0.5f);
+  EXPECT_NEAR(1.0f, pQuaOut.norm(), 0.0001f);
+  EXPECT_TRUE(pQuaOut.isNear(pQua1));
+}
+
+TEST(ALQuaternionTest, quaternionNlerp)
+{
+  const AL::Math::Quaternion pQua1 =
+      AL::Math::quaternionFromAngleAndAxisRotation(0.2f, 0.0f, 0.0f, 1.0f);
+  const AL::Math::Quaternion pQua2 =
+      AL::Math::quaternionFromAngleAndAxisRotation(0.4f, 0.0f, 0.0f, 1.0f);
+
+  EXPECT_TRUE(AL::Math::quaternionNlerp(pQua1, pQua2, 0.0f).isNear(pQua1));
+  EXPECT_TRUE(AL::Math::quaternionNlerp(pQua1, pQua2, 1.0f).isNear(pQua2));
+  // same as slerp at the middle
+  EXPECT_TRUE(AL::Math::quaternionNlerp(pQua1, pQua2, 0.5f).isNear(
+                AL::Math::quaternionSlerp(pQua1, pQua2, 0.5f)));
+
+  AL::Math::Quaternion pQua3 = pQua2;
+  pQua3 *= -1.0f;
+  const AL::Math::Quaternion pQuaOut =
+      AL::Math::quaternionNlerp(pQua1, pQua3, 0.3f);
+  EXPECT_NEAR(1.0f, pQuaOut.norm(), 0.0001f);
+  EXPECT_TRUE(pQuaOut.isNear(AL::Math::quaternionNlerp(pQua1, pQua2, 0.3f)));
+}
+
+TEST(ALQuaternionTest, batch)
+{
+  // 19 quaternions: full SIMD packs and a scalar tail
+  const unsigned int nb = 19;
+  std::vector<AL::Math::Quaternion> pQua1(nb);
+  std::vector<AL::Math::Quaternion> pQua2(nb);
+  for (unsigned int i = 0; i < nb; ++i)
+  {
+    const float k = static_cast<float>(i);
+    pQua1[i] = AL::Math::quaternionFromAngleAndAxisRotation(
+          0.3f*k - 2.0f, 0.2f, -0.5f + 0.1f*k, 0.8f).normalize();
+    pQua2[i] = AL::Math::quaternionFromAngleAndAxisRotation(
+          1.0f - 0.2f*k, -0.4f*k, 0.3f, 1.0f).normalize();
+  }
+  // close and opposite quaternions
+  pQua2[3] = pQua1[3];
+  pQua2[4] = pQua1[4];
+  pQua2[4] *= -1.0f;
+
+  std::vector<AL::Math::Quaternion> pOut(nb);
+  AL::Math::quaternionMultiplyBatch(&pQua1[0], &pQua2[0], nb, &pOut[0]);
+  for (unsigned int i = 0; i < nb; ++i)
+  {
+    EXPECT_TRUE(pOut[i].isNear(pQua1[i]*pQua2[i]));
+  }
+
+  AL::Math::quaternionInverseBatch(&pQua1[0], nb, &pOut[0]);
+  for (unsigned int i = 0; i < nb; ++i)
+  {
+    EXPECT_TRUE(pOut[i].isNear(pQua1[i].inverse()));
+  }
+
+  for (unsigned int i = 0; i < nb; ++i)
+  {
+    pOut[i] = pQua1[i];
+    pOut[i] *= 0.5f + 0.1f*static_cast<float>(i);
+  }
+  AL::Math::quaternionNormalizeBatch(&pOut[0], nb, &pOut[0]);
+  for (unsigned int i = 0; i < nb; ++i)
+  {
+    EXPECT_TRUE(pOut[i].isNear(pQua1[i], 1e-6f));
+  }
+
+  const float alphas[] = {0.0f, 0.3f, 1.0f};
+  for (unsigned int j = 0; j < 3; ++j)
+  {
+    AL::Math::quaternionSlerpBatch(&pQua1[0], &pQua2[0], alphas[j], nb, &pOut[0]);
+    for (unsigned int i = 0; i < nb; ++i)
+    {
+      EXPECT_TRUE(pOut[i].isNear(
+                    AL::Math::quaternionSlerp(pQua1[i], pQua2[i], alphas[j])))
+          << i << " " << alphas[j];
+    }
+
+    AL::Math::quaternionNlerpBatch(&pQua1[0], &pQua2[0], alphas[j], nb, &pOut[0]);
+    for (unsigned int i = 0; i < nb; ++i)
+    {
+      EXPECT_TRUE(pOut[i].isNear(
+                    AL::Math::quaternionNlerp(pQua1[i], pQua2[i], alphas[j])));
+    }
+  }
+
+  // in place
+  pOut = pQua1;
+  AL::Math::quaternionMultiplyBatch(&pOut[0], &pQua2[0], nb, &pOut[0]);
+  EXPECT_TRUE(pOut[nb - 1].isNear(pQua1[nb - 1]*pQua2[nb - 1]));
+
+  pOut[nb - 1] = AL::Math::Quaternion(0.0f, 0.0f, 0.0f, 0.0f);
+  EXPECT_THROW(AL::Math::quaternionNormalizeBatch(&pOut[0], nb, &pOut[0]),
+               std::runtime_error);
+  pOut[nb - 1] = pQua1[nb - 1];
+  pOut[0] = AL::Math::Quaternion(0.0f, 0.0f, 0.0f, 0.0f);
+  EXPECT_THROW(AL::Math::quaternionNormalizeBatch(&pOut[0], nb, &pOut[0]),
+               std::runtime_error);
+}
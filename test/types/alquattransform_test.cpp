@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+#include <almath/types/alquattransform.h>
+#include <almath/tools/altransformhelpers.h>
+#include <almath/tools/almathio.h>
+
+#include <gtest/gtest.h>
+
+
+namespace {
+  AL::Math::Transform xTransform(const float pK)
+  {
+    return AL::Math::Transform::fromPosition(
+          0.1f + pK, -0.2f, 0.3f - pK, 0.4f + pK, -0.5f, 0.6f - pK);
+  }
+}
+
+TEST(ALQuatTransformTest, creation)
+{
+  const AL::Math::QuatTransform pQT1;
+  EXPECT_TRUE(pQT1.q.isNear(AL::Math::Quaternion()));
+  EXPECT_TRUE(pQT1.p.isNear(AL::Math::Position3D()));
+  EXPECT_TRUE(pQT1.toTransform().isNear(AL::Math::Transform()));
+
+  // Transform -> QuatTransform -> Transform
+  const AL::Math::Transform pT = xTransform(0.1f);
+  const AL::Math::QuatTransform pQT2(pT);
+  EXPECT_TRUE(pQT2.toTransform().isNear(pT));
+  EXPECT_TRUE(AL::Math::transformFromQuatTransform(
+                AL::Math::quatTransformFromTransform(pT)).isNear(pT));
+  EXPECT_TRUE(pQT2.q.isNear(AL::Math::quaternionFromTransform(pT)));
+  EXPECT_TRUE(pQT2.p.isNear(AL::Math::Position3D(0.2f, -0.2f, 0.2f)));
+}
+
+TEST(ALQuatTransformTest, multiply)
+{
+  const AL::Math::Transform pT1 = xTransform(0.1f);
+  const AL::Math::Transform pT2 = xTransform(-0.3f);
+  const AL::Math::Transform pT3 = xTransform(0.5f);
+
+  const AL::Math::QuatTransform pQT1(pT1);
+  const AL::Math::QuatTransform pQT2(pT2);
+  const AL::Math::QuatTransform pQT3(pT3);
+
+  EXPECT_TRUE((pQT1*pQT2).toTransform().isNear(pT1*pT2));
+  EXPECT_TRUE((pQT1*pQT2*pQT3).toTransform().isNear(pT1*pT2*pT3));
+
+  AL::Math::QuatTransform pQTOut = pQT1;
+  pQTOut *= pQT2;
+  EXPECT_TRUE(pQTOut.isNear(pQT1*pQT2));
+
+  // point transform
+  const AL::Math::Position3D pPos(0.3f, -0.7f, 1.1f);
+  EXPECT_TRUE((pQT1*pPos).isNear(pT1*pPos));
+}
+
+TEST(ALQuatTransformTest, inverse)
+{
+  const AL::Math::Transform pT = xTransform(0.2f);
+  const AL::Math::QuatTransform pQT(pT);
+
+  EXPECT_TRUE(pQT.inverse().toTransform().isNear(
+                AL::Math::transformInverse(pT)));
+  EXPECT_TRUE((pQT*AL::Math::quatTransformInverse(pQT)).isNear(
+                AL::Math::QuatTransform()));
+}
+
+TEST(ALQuatTransformTest, isNear)
+{
+  const AL::Math::QuatTransform pQT(xTransform(0.2f));
+
+  // q and -q are the same rotation
+  AL::Math::QuatTransform pQTOpposite = pQT;
+  pQTOpposite.q *= -1.0f;
+  EXPECT_TRUE(pQT.isNear(pQTOpposite));
+
+  AL::Math::QuatTransform pQTOut = pQT;
+  pQTOut.p.y += 0.2f;
+  EXPECT_FALSE(pQT.isNear(pQTOut));
+}
+
+TEST(ALQuatTransformTest, normalize)
+{
+  AL::Math::QuatTransform pQT(xTransform(0.2f));
+  pQT.q *= 1.1f;
+  EXPECT_NEAR(1.0f, pQT.normalize().q.norm(), 0.0001f);
+  EXPECT_TRUE(pQT.normalize().p.isNear(pQT.p));
+}
+
+TEST(ALQuatTransformTest, interpolation)
+{
+  const AL::Math::QuatTransform pQT1(
+        AL::Math::quaternionFromAngleAndAxisRotation(0.2f, 0.0f, 1.0f, 0.0f),
+        AL::Math::Position3D(0.0f, 1.0f, 2.0f));
+  const AL::Math::QuatTransform pQT2(
+        AL::Math::quaternionFromAngleAndAxisRotation(1.0f, 0.0f, 1.0f, 0.0f),
+        AL::Math::Position3D(1.0f, 1.0f, 0.0f));
+
+  EXPECT_TRUE(AL::Math::quatTransformInterpolation(
+                pQT1, pQT2, 0.0f).isNear(pQT1));
+  EXPECT_TRUE(AL::Math::quatTransformInterpolation(
+                pQT1, pQT2, 1.0f).isNear(pQT2));
+
+  const AL::Math::QuatTransform pQTExpected(
+        AL::Math::quaternionFromAngleAndAxisRotation(0.6f, 0.0f, 1.0f, 0.0f),
+        AL::Math::Position3D(0.5f, 1.0f, 1.0f));
+  EXPECT_TRUE(AL::Math::quatTransformInterpolation(
+                pQT1, pQT2, 0.5f).isNear(pQTExpected));
+}
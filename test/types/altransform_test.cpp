@@ -574,3 +574,41 @@ TEST(TransformTest, inverse0)
   EXPECT_TRUE(pHIn.inverse().isNear(pHOut, 0.0001f));
 }
 
+
+TEST(TransformTest, multiplyByElementary)
+{
+  const AL::Math::Transform pT = AL::Math::Transform::fromPosition(
+        0.1f, -0.2f, 0.3f, 0.4f, -0.5f, 0.6f);
+  const float pAngle = 0.7f;
+  const float c = std::cos(pAngle);
+  const float s = std::sin(pAngle);
+
+  AL::Math::Transform pTOut = pT;
+  AL::Math::transformMultiplyByRotX(pTOut, c, s);
+  EXPECT_TRUE(pTOut.isNear(pT*AL::Math::Transform::fromRotX(pAngle)));
+
+  pTOut = pT;
+  AL::Math::transformMultiplyByRotY(pTOut, c, s);
+  EXPECT_TRUE(pTOut.isNear(pT*AL::Math::Transform::fromRotY(pAngle)));
+
+  pTOut = pT;
+  AL::Math::transformMultiplyByRotZ(pTOut, c, s);
+  EXPECT_TRUE(pTOut.isNear(pT*AL::Math::Transform::fromRotZ(pAngle)));
+
+  pTOut = pT;
+  AL::Math::transformMultiplyByTranslation(pTOut, 0.5f, -1.0f, 2.0f);
+  EXPECT_TRUE(pTOut.isNear(pT*AL::Math::Transform(0.5f, -1.0f, 2.0f)));
+
+  // the translation of the operand is ignored
+  AL::Math::Transform pRot = AL::Math::Transform::from3DRotation(0.2f, -0.3f, 0.4f);
+  pTOut = pT;
+  AL::Math::transformMultiplyByRotation(pTOut, pRot);
+  EXPECT_TRUE(pTOut.isNear(pT*pRot));
+  pRot.r1_c4 = 1.0f;
+  pRot.r3_c4 = -2.0f;
+  pTOut = pT;
+  AL::Math::transformMultiplyByRotation(pTOut, pRot);
+  pRot.r1_c4 = 0.0f;
+  pRot.r3_c4 = 0.0f;
+  EXPECT_TRUE(pTOut.isNear(pT*pRot));
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+#include <almath/types/altransformsoa.h>
+#include <almath/types/altransform.h>
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+TEST(TransformSoATest, constructor)
+{
+  AL::Math::TransformSoA pTs;
+  EXPECT_EQ(0u, pTs.size());
+
+  pTs = AL::Math::TransformSoA(5);
+  EXPECT_EQ(5u, pTs.size());
+  for (unsigned int i=0; i<pTs.size(); i++)
+  {
+    EXPECT_TRUE(pTs.get(i).isNear(AL::Math::Transform()));
+  }
+
+  AL::Math::Transform pT = AL::Math::Transform::fromPosition(
+        0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f);
+  pTs.set(3, pT);
+  EXPECT_TRUE(pTs.get(3) == pT);
+
+  pTs.resize(7);
+  EXPECT_EQ(7u, pTs.size());
+  EXPECT_TRUE(pTs.get(3) == pT);
+  EXPECT_TRUE(pTs.get(6).isNear(AL::Math::Transform()));
+}
+
+TEST(TransformSoATest, transformMultiplyBatch)
+{
+  // odd size to cover both the SIMD part and the tail of the batch
+  const unsigned int size = 23;
+  AL::Math::TransformSoA pA(size);
+  AL::Math::TransformSoA pB(size);
+  AL::Math::TransformSoA pOut;
+
+  for (unsigned int i=0; i<size; i++)
+  {
+    const float k = static_cast<float>(i);
+    pA.set(i, AL::Math::Transform::fromPosition(
+             0.1f*k, -0.2f, 0.3f+0.01f*k, 0.1f*k, -0.05f*k, 0.2f));
+    pB.set(i, AL::Math::Transform::fromPosition(
+             -0.3f, 0.02f*k, 0.1f, 0.3f, 0.07f*k, -0.1f*k));
+  }
+
+  AL::Math::transformMultiplyBatch(pA, pB, pOut);
+  ASSERT_EQ(size, pOut.size());
+  for (unsigned int i=0; i<size; i++)
+  {
+    EXPECT_TRUE(pOut.get(i).isNear(pA.get(i)*pB.get(i), 0.00001f));
+  }
+
+  // in place
+  AL::Math::TransformSoA pC = pA;
+  AL::Math::transformMultiplyBatch(pC, pB, pC);
+  for (unsigned int i=0; i<size; i++)
+  {
+    EXPECT_TRUE(pC.get(i).isNear(pA.get(i)*pB.get(i), 0.00001f));
+  }
+
+  pC = pB;
+  AL::Math::transformMultiplyBatch(pA, pC, pC);
+  for (unsigned int i=0; i<size; i++)
+  {
+    EXPECT_TRUE(pC.get(i).isNear(pA.get(i)*pB.get(i), 0.00001f));
+  }
+
+  AL::Math::TransformSoA pEmpty;
+  AL::Math::transformMultiplyBatch(pEmpty, pEmpty, pOut);
+  EXPECT_EQ(0u, pOut.size());
+
+  EXPECT_THROW(AL::Math::transformMultiplyBatch(pA, pEmpty, pOut),
+               std::invalid_argument);
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2012 Aldebaran Robotics. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the COPYING file.
+ */
+#include <almath/types/altransformview.h>
+#include <almath/tools/altransformhelpers.h>
+#include <almath/tools/almathio.h>
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+
+namespace {
+  AL::Math::Transform xTransform(const float pK)
+  {
+    return AL::Math::Transform::fromPosition(
+          0.1f + pK, -0.2f, 0.3f - pK, 0.4f + pK, -0.5f, 0.6f - pK);
+  }
+}
+
+TEST(ALTransformViewTest, position3DView)
+{
+  float buffer[4] = {1.0f, 2.0f, 3.0f, 42.0f};
+  AL::Math::Position3DView pView(buffer);
+
+  const AL::Math::Position3D pPos = pView;
+  EXPECT_TRUE(pPos.isNear(AL::Math::Position3D(1.0f, 2.0f, 3.0f)));
+
+  pView += AL::Math::Position3D(1.0f, 1.0f, 1.0f);
+  pView *= 2.0f;
+  pView -= AL::Math::Position3D(0.0f, 1.0f, 2.0f);
+  EXPECT_EQ(4.0f, buffer[0]);
+  EXPECT_EQ(5.0f, buffer[1]);
+  EXPECT_EQ(6.0f, buffer[2]);
+  EXPECT_EQ(42.0f, buffer[3]);
+
+  // a copy of the view aliases the same buffer
+  AL::Math::Position3DView pCopy(pView);
+  pCopy = AL::Math::Position3D(-1.0f, -2.0f, -3.0f);
+  EXPECT_EQ(-2.0f, buffer[1]);
+
+  // assignment between views copies the values
+  float buffer2[3] = {7.0f, 8.0f, 9.0f};
+  AL::Math::Position3DView pView2(buffer2);
+  pView = pView2;
+  EXPECT_EQ(buffer2, pView2.data);
+  EXPECT_EQ(buffer, pView.data);
+  EXPECT_EQ(8.0f, buffer[1]);
+}
+
+TEST(ALTransformViewTest, transformView)
+{
+  const AL::Math::Transform pT1 = xTransform(0.1f);
+  const AL::Math::Transform pT2 = xTransform(-0.3f);
+
+  float buffer[AL::Math::Transform::SIZE];
+  pT1.writeTo(buffer);
+  AL::Math::TransformView pView(buffer);
+
+  EXPECT_TRUE(static_cast<AL::Math::Transform>(pView).isNear(pT1));
+  EXPECT_TRUE((pView*pT2).isNear(pT1*pT2));
+  EXPECT_TRUE((pT2*pView).isNear(pT2*pT1));
+  EXPECT_TRUE((pView*pView).isNear(pT1*pT1));
+  EXPECT_TRUE(pView.inverse().isNear(pT1.inverse()));
+
+  const AL::Math::Position3D pPos(0.5f, -0.6f, 0.7f);
+  EXPECT_TRUE((pView*pPos).isNear(pT1*pPos));
+
+  // in place multiply
+  pView *= pT2;
+  EXPECT_TRUE(AL::Math::Transform(buffer, AL::Math::Transform::SIZE).isNear(
+                pT1*pT2));
+
+  // in place inverse
+  pView = pT1;
+  pView = pView.inverse();
+  EXPECT_TRUE(static_cast<AL::Math::Transform>(pView).isNear(pT1.inverse()));
+
+  // transform a point stored in a buffer
+  float pointBuffer[3];
+  pPos.writeTo(pointBuffer);
+  AL::Math::Position3DView pPosView(pointBuffer);
+  pView = pT1;
+  pPosView = pView*pPosView;
+  EXPECT_TRUE(static_cast<AL::Math::Position3D>(pPosView).isNear(pT1*pPos));
+  pPosView = pT1.inverse()*pPosView;
+  EXPECT_TRUE(static_cast<AL::Math::Position3D>(pPosView).isNear(pPos));
+
+  // a copy of the view aliases the same buffer
+  AL::Math::TransformView pCopy(pView);
+  EXPECT_EQ(buffer, pCopy.data);
+  pCopy = pT2;
+  EXPECT_TRUE(AL::Math::Transform(buffer, AL::Math::Transform::SIZE).isNear(pT2));
+}
+
+TEST(ALTransformViewTest, arrayView)
+{
+  // points interleaved with a fourth float
+  const unsigned int nb = 5;
+  const unsigned int stride = 4;
+  float buffer[nb*stride];
+  for (unsigned int i = 0; i < nb; ++i)
+  {
+    AL::Math::Position3D(0.1f*i, -0.2f*i, 0.3f).writeTo(buffer + i*stride);
+    buffer[i*stride + 3] = 42.0f;
+  }
+
+  const AL::Math::Transform pT = xTransform(0.2f);
+  const AL::Math::Position3DArrayView pPoints(buffer, nb, stride);
+  EXPECT_EQ(nb, pPoints.size);
+  for (unsigned int i = 0; i < pPoints.size; ++i)
+  {
+    pPoints[i] = pT*pPoints[i];
+  }
+  for (unsigned int i = 0; i < nb; ++i)
+  {
+    EXPECT_TRUE(static_cast<AL::Math::Position3D>(pPoints[i]).isNear(
+                  pT*AL::Math::Position3D(0.1f*i, -0.2f*i, 0.3f)));
+    EXPECT_EQ(42.0f, buffer[i*stride + 3]);
+  }
+
+  // packed transforms
+  float tBuffer[nb*AL::Math::Transform::SIZE];
+  const AL::Math::TransformArrayView pTs(tBuffer, nb);
+  for (unsigned int i = 0; i < nb; ++i)
+  {
+    pTs[i] = xTransform(0.1f*i);
+  }
+  for (unsigned int i = 0; i < nb; ++i)
+  {
+    pTs[i] *= pT;
+    EXPECT_TRUE(static_cast<AL::Math::Transform>(pTs[i]).isNear(
+                  xTransform(0.1f*i)*pT));
+    EXPECT_EQ(tBuffer + i*AL::Math::Transform::SIZE, pTs[i].data);
+  }
+
+  EXPECT_THROW(AL::Math::Position3DArrayView(buffer, nb, 2),
+               std::invalid_argument);
+  EXPECT_THROW(AL::Math::TransformArrayView(tBuffer, nb, 11),
+               std::invalid_argument);
+}